@@ -116,6 +116,12 @@ typedef struct ucc_base_context_iface {
     void         (*destroy)(ucc_base_context_t *ctx);
     ucc_status_t (*get_attr)(const ucc_base_context_t *context,
                              ucc_base_ctx_attr_t      *attr);
+    /* Optional blocking progress support, NULL if not provided by the
+       component. event_fd becomes readable on communication events once the
+       context is armed, arm returns UCC_INPROGRESS if events are pending and
+       the context has to be progressed before it can be armed */
+    ucc_status_t (*get_event_fd)(ucc_base_context_t *context, int *fd);
+    ucc_status_t (*arm)(ucc_base_context_t *context);
 } ucc_base_context_iface_t;
 
 
@@ -153,6 +159,11 @@ typedef struct ucc_base_team_iface {
     ucc_status_t (*create_test)(ucc_base_team_t *team);
     ucc_status_t (*destroy)(ucc_base_team_t *team);
     ucc_get_coll_scores_fn_t get_scores;
+    /* Optional symmetric heap, NULL if not provided by the component.
+       mem_free returns UCC_ERR_NOT_FOUND for buffers it does not own */
+    ucc_status_t (*mem_alloc)(ucc_base_team_t *team, size_t size,
+                              void **buffer);
+    ucc_status_t (*mem_free)(ucc_base_team_t *team, void *buffer);
 } ucc_base_team_iface_t;
 
 enum {
@@ -52,4 +52,16 @@ ucc_status_t ucc_cl_basic_coll_init(ucc_base_coll_args_t *coll_args,
 
 ucc_status_t ucc_cl_basic_team_get_scores(ucc_base_team_t   *cl_team,
                                           ucc_coll_score_t **score);
+
+ucc_status_t ucc_cl_basic_team_mem_alloc(ucc_base_team_t *cl_team, size_t size,
+                                         void **buffer);
+
+ucc_status_t ucc_cl_basic_team_mem_free(ucc_base_team_t *cl_team, void *buffer);
+
 UCC_CL_IFACE_DECLARE(basic, BASIC);
+
+__attribute__((constructor)) static void cl_basic_iface_init(void)
+{
+    ucc_cl_basic.super.team.mem_alloc = ucc_cl_basic_team_mem_alloc;
+    ucc_cl_basic.super.team.mem_free  = ucc_cl_basic_team_mem_free;
+}
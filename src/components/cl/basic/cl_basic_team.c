@@ -204,3 +204,44 @@ err:
     *score = NULL;
     return status;
 }
+
+ucc_status_t ucc_cl_basic_team_mem_alloc(ucc_base_team_t *cl_team, size_t size,
+                                         void **buffer)
+{
+    ucc_cl_basic_team_t   *team = ucc_derived_of(cl_team, ucc_cl_basic_team_t);
+    ucc_base_team_iface_t *iface;
+    ucc_status_t           status;
+    int                    i;
+
+    for (i = 0; i < team->n_tl_teams; i++) {
+        iface = &UCC_TL_TEAM_IFACE(team->tl_teams[i])->team;
+        if (!iface->mem_alloc) {
+            continue;
+        }
+        status = iface->mem_alloc(&team->tl_teams[i]->super, size, buffer);
+        if (UCC_ERR_NOT_SUPPORTED != status) {
+            return status;
+        }
+    }
+    return UCC_ERR_NOT_SUPPORTED;
+}
+
+ucc_status_t ucc_cl_basic_team_mem_free(ucc_base_team_t *cl_team, void *buffer)
+{
+    ucc_cl_basic_team_t   *team = ucc_derived_of(cl_team, ucc_cl_basic_team_t);
+    ucc_base_team_iface_t *iface;
+    ucc_status_t           status;
+    int                    i;
+
+    for (i = 0; i < team->n_tl_teams; i++) {
+        iface = &UCC_TL_TEAM_IFACE(team->tl_teams[i])->team;
+        if (!iface->mem_free) {
+            continue;
+        }
+        status = iface->mem_free(&team->tl_teams[i]->super, buffer);
+        if (UCC_ERR_NOT_FOUND != status) {
+            return status;
+        }
+    }
+    return UCC_ERR_NOT_FOUND;
+}
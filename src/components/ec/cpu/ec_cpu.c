@@ -7,24 +7,63 @@
 #include "ec_cpu.h"
 #include "utils/arch/cpu.h"
 #include "components/mc/ucc_mc.h"
+#include "core/ucc_dt.h"
 #include <limits.h>
+#include <sched.h>
 
 static ucc_config_field_t ucc_ec_cpu_config_table[] = {
     {"", "", NULL, ucc_offsetof(ucc_ec_cpu_config_t, super),
      UCC_CONFIG_TYPE_TABLE(ucc_ec_config_table)},
 
+    {"EXEC_NUM_THREADS", "0",
+     "Number of worker threads executing reductions and copies of the cpu "
+     "executor asynchronously. 0 - tasks are executed synchronously by the "
+     "posting thread",
+     ucc_offsetof(ucc_ec_cpu_config_t, exec_num_threads),
+     UCC_CONFIG_TYPE_ULUNITS},
+
+    {"EXEC_MT_THRESH", "1M",
+     "Tasks smaller than the threshold are executed synchronously by the "
+     "posting thread even if worker threads are enabled",
+     ucc_offsetof(ucc_ec_cpu_config_t, exec_mt_thresh),
+     UCC_CONFIG_TYPE_MEMUNITS},
+
+    {"EXEC_PIN_THREADS", "y",
+     "Pin worker threads to the cpus the process is bound to",
+     ucc_offsetof(ucc_ec_cpu_config_t, exec_pin_threads),
+     UCC_CONFIG_TYPE_BOOL},
+
+    {"REDUCE_SIMD", "auto",
+     "Vector instruction set used by host reductions of float32, float64, "
+     "int32 and int64 data.\n"
+     "auto   - the widest one supported by the cpu\n"
+     "none   - scalar code\n"
+     "avx2, avx512, neon, sve - the given instruction set",
+     ucc_offsetof(ucc_ec_cpu_config_t, reduce_simd),
+     UCC_CONFIG_TYPE_ENUM(ucc_ec_cpu_reduce_simd_names)},
+
     {NULL}
 
 };
 
 static ucc_status_t ucc_ec_cpu_init(const ucc_ec_params_t *ec_params)
 {
-    ucc_status_t status;
+    ucc_mc_attr_t mc_attr;
+    ucc_status_t  status;
 
     ucc_strncpy_safe(ucc_ec_cpu.super.config->log_component.name,
                      ucc_ec_cpu.super.super.name,
                      sizeof(ucc_ec_cpu.super.config->log_component.name));
     ucc_ec_cpu.thread_mode = ec_params->thread_mode;
+    ucc_spinlock_init(&ucc_ec_cpu.init_spinlock, 0);
+    ucc_ec_cpu.pool.initialized = 0;
+    ucc_ec_cpu_reduce_simd_init(EC_CPU_CONFIG->reduce_simd);
+    mc_attr.field_mask = UCC_MC_ATTR_FIELD_MEMCPY_NT_THRESH;
+    if (UCC_OK == ucc_mc_get_attr(&mc_attr, UCC_MEMORY_TYPE_HOST)) {
+        ucc_ec_cpu.memcpy_nt_thresh = mc_attr.memcpy_nt_thresh;
+    } else {
+        ucc_ec_cpu.memcpy_nt_thresh = SIZE_MAX;
+    }
 
     status = ucc_mpool_init(&ucc_ec_cpu.executors, 0, sizeof(ucc_ee_executor_t),
                             0, UCC_CACHE_LINE_SIZE, 16, UINT_MAX, NULL,
@@ -35,7 +74,7 @@ static ucc_status_t ucc_ec_cpu_init(const ucc_ec_params_t *ec_params)
     }
 
     status = ucc_mpool_init(&ucc_ec_cpu.executor_tasks, 0,
-                            sizeof(ucc_ee_executor_task_t),
+                            sizeof(ucc_ec_cpu_executor_task_t),
                             0, UCC_CACHE_LINE_SIZE, 16, UINT_MAX, NULL,
                             ec_params->thread_mode, "ec cpu executor tasks");
     if (status != UCC_OK) {
@@ -59,6 +98,8 @@ static ucc_status_t ucc_ec_cpu_get_attr(ucc_ec_attr_t *ec_attr)
 
 static ucc_status_t ucc_ec_cpu_finalize()
 {
+    ucc_ec_cpu_pool_finalize(&ucc_ec_cpu.pool);
+    ucc_spinlock_destroy(&ucc_ec_cpu.init_spinlock);
     ucc_mpool_cleanup(&ucc_ec_cpu.executors, 1);
     ucc_mpool_cleanup(&ucc_ec_cpu.executor_tasks, 1);
 
@@ -98,74 +139,173 @@ ucc_status_t ucc_cpu_executor_stop(ucc_ee_executor_t *executor) //NOLINT
     return UCC_OK;
 }
 
+static ucc_status_t
+ucc_ec_cpu_reduce_strided(const ucc_eee_task_reduce_strided_t *trs,
+                          uint16_t flags, size_t offset, size_t count)
+{
+    size_t                n_srcs = trs->n_src2 + 1;
+    size_t                off    = offset * ucc_dt_size(trs->dt);
+    void **               srcs;
+    ucc_eee_task_reduce_t tr;
+    int                   i;
+
+    if (n_srcs <= UCC_EE_EXECUTOR_NUM_BUFS) {
+        srcs = &tr.srcs[0];
+    } else {
+        srcs = alloca(n_srcs * sizeof(void *));
+        flags |= UCC_EEE_TASK_FLAG_REDUCE_SRCS_EXT;
+        tr.srcs_ext = srcs;
+    }
+    srcs[0] = PTR_OFFSET(trs->src1, off);
+    for (i = 0; i < n_srcs - 1; i++) {
+        srcs[i + 1] = PTR_OFFSET(trs->src2, trs->stride * i + off);
+    }
+    tr.count  = count;
+    tr.dt     = trs->dt;
+    tr.op     = trs->op;
+    tr.n_srcs = n_srcs;
+    tr.dst    = PTR_OFFSET(trs->dst, off);
+    tr.alpha  = trs->alpha;
+
+    return ucc_ec_cpu_reduce(&tr, tr.dst, srcs, flags);
+}
+
+ucc_status_t ucc_ec_cpu_task_run(const ucc_ee_executor_task_args_t *args,
+                                 size_t offset, size_t count)
+{
+    ucc_eee_task_reduce_t *tr;
+    ucc_eee_task_reduce_t  chunk;
+    size_t                 off;
+    int                    i;
+
+    switch (args->task_type) {
+    case UCC_EE_EXECUTOR_TASK_REDUCE:
+        tr = (ucc_eee_task_reduce_t *)&args->reduce;
+        if (offset == 0 && count == tr->count) {
+            return ucc_ec_cpu_reduce(tr, tr->dst,
+                                     (args->flags &
+                                      UCC_EEE_TASK_FLAG_REDUCE_SRCS_EXT) ?
+                                         tr->srcs_ext : tr->srcs,
+                                     args->flags);
+        }
+        /* chunks are executed only for tasks with inline srcs */
+        ucc_assert(!(args->flags & UCC_EEE_TASK_FLAG_REDUCE_SRCS_EXT));
+        off   = offset * ucc_dt_size(tr->dt);
+        chunk = *tr;
+        for (i = 0; i < tr->n_srcs; i++) {
+            chunk.srcs[i] = PTR_OFFSET(tr->srcs[i], off);
+        }
+        chunk.dst   = PTR_OFFSET(tr->dst, off);
+        chunk.count = count;
+        return ucc_ec_cpu_reduce(&chunk, chunk.dst, chunk.srcs, args->flags);
+    case UCC_EE_EXECUTOR_TASK_REDUCE_STRIDED:
+        return ucc_ec_cpu_reduce_strided(&args->reduce_strided, args->flags,
+                                         offset, count);
+    case UCC_EE_EXECUTOR_TASK_COPY:
+        /* same store type for all chunks of a copy: the threshold of mc cpu
+           is applied to the whole copy */
+        if (args->copy.len >= ucc_ec_cpu.memcpy_nt_thresh) {
+            ucc_arch_memcpy_nt(PTR_OFFSET(args->copy.dst, offset),
+                               PTR_OFFSET(args->copy.src, offset), count);
+        } else {
+            memcpy(PTR_OFFSET(args->copy.dst, offset),
+                   PTR_OFFSET(args->copy.src, offset), count);
+        }
+        return UCC_OK;
+    default:
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+}
+
+/* number of elements (bytes for copies) and size in bytes of the task if
+   it can be split into chunks, 0 otherwise */
+static size_t ucc_ec_cpu_task_size(const ucc_ee_executor_task_args_t *args,
+                                   size_t                            *total)
+{
+    switch (args->task_type) {
+    case UCC_EE_EXECUTOR_TASK_REDUCE:
+        if (args->flags & UCC_EEE_TASK_FLAG_REDUCE_SRCS_EXT) {
+            /* external srcs array is owned by the caller */
+            return 0;
+        }
+        *total = args->reduce.count;
+        return args->reduce.count * ucc_dt_size(args->reduce.dt) *
+               args->reduce.n_srcs;
+    case UCC_EE_EXECUTOR_TASK_REDUCE_STRIDED:
+        *total = args->reduce_strided.count;
+        return args->reduce_strided.count *
+               ucc_dt_size(args->reduce_strided.dt) *
+               (args->reduce_strided.n_src2 + 1);
+    case UCC_EE_EXECUTOR_TASK_COPY:
+        *total = args->copy.len;
+        return args->copy.len;
+    default:
+        return 0;
+    }
+}
+
 ucc_status_t ucc_cpu_executor_task_post(ucc_ee_executor_t *executor,
                                         const ucc_ee_executor_task_args_t *task_args,
                                         ucc_ee_executor_task_t **task)
 {
-    ucc_status_t            status = UCC_OK;
-    ucc_ee_executor_task_t *eee_task;
+    ucc_status_t                status = UCC_OK;
+    ucc_ec_cpu_executor_task_t *eee_task;
+    size_t                      size, total, i;
 
     eee_task = ucc_mpool_get(&ucc_ec_cpu.executor_tasks);
     if (ucc_unlikely(!eee_task)) {
         return UCC_ERR_NO_MEMORY;
     }
 
-    eee_task->eee = executor;
+    eee_task->super.eee = executor;
+    size = (EC_CPU_CONFIG->exec_num_threads > 0)
+               ? ucc_ec_cpu_task_size(task_args, &total) : 0;
+    if (size > 0 && size >= EC_CPU_CONFIG->exec_mt_thresh) {
+        /* task args may live on the caller stack, keep a copy */
+        eee_task->super.args   = *task_args;
+        eee_task->super.status = UCC_INPROGRESS;
+        eee_task->total        = total;
+        status                 = ucc_ec_cpu_pool_post(eee_task);
+        if (ucc_likely(UCC_OK == status)) {
+            *task = &eee_task->super;
+            return UCC_OK;
+        }
+        ec_debug(&ucc_ec_cpu.super,
+                 "failed to post task to worker threads: %s, executing it "
+                 "synchronously", ucc_status_string(status));
+    }
+
     switch (task_args->task_type) {
     case UCC_EE_EXECUTOR_TASK_REDUCE:
-        status = ucc_ec_cpu_reduce((ucc_eee_task_reduce_t *)&task_args->reduce, task_args->reduce.dst,
-                                   (task_args->flags &
-                                        UCC_EEE_TASK_FLAG_REDUCE_SRCS_EXT) ?
-                                        task_args->reduce.srcs_ext :
-                                        task_args->reduce.srcs,
-                                    task_args->flags);
-        if (ucc_unlikely(UCC_OK != status)) {
-            goto free_task;
-        }
+        status = ucc_ec_cpu_task_run(task_args, 0, task_args->reduce.count);
         break;
     case UCC_EE_EXECUTOR_TASK_REDUCE_STRIDED:
-    {
-        ucc_eee_task_reduce_strided_t *trs =
-            (ucc_eee_task_reduce_strided_t *)&task_args->reduce_strided;
-        size_t                n_srcs = trs->n_src2 + 1;
-        uint16_t              flags  = task_args->flags;
-        void **               srcs;
-        ucc_eee_task_reduce_t tr;
-        int                   i;
-
-        if (n_srcs <= UCC_EE_EXECUTOR_NUM_BUFS) {
-            srcs = &tr.srcs[0];
-        } else {
-            srcs = alloca(n_srcs * sizeof(void *));
-            flags |= UCC_EEE_TASK_FLAG_REDUCE_SRCS_EXT;
-            tr.srcs_ext = srcs;
-        }
-        srcs[0] = trs->src1;
-        for (i = 0; i < n_srcs - 1; i++) {
-            srcs[i + 1] = PTR_OFFSET(trs->src2, trs->stride * i);
-        }
-        tr.count  = trs->count;
-        tr.dt     = trs->dt;
-        tr.op     = trs->op;
-        tr.n_srcs = n_srcs;
-        tr.dst    = trs->dst;
-        tr.alpha  = trs->alpha;
-
-        status = ucc_ec_cpu_reduce(&tr, tr.dst, srcs, flags);
-        if (ucc_unlikely(UCC_OK != status)) {
-            goto free_task;
-        }
-    } break;
+        status = ucc_ec_cpu_task_run(task_args, 0,
+                                     task_args->reduce_strided.count);
+        break;
     case UCC_EE_EXECUTOR_TASK_COPY:
-        memcpy(task_args->copy.dst, task_args->copy.src, task_args->copy.len);
+        status = ucc_ec_cpu_task_run(task_args, 0, task_args->copy.len);
         break;
     case UCC_EE_EXECUTOR_TASK_COPY_MULTI:
+        for (i = 0; i < task_args->copy_multi.num_vectors; i++) {
+            status = ucc_mc_memcpy(task_args->copy_multi.dst[i],
+                                   task_args->copy_multi.src[i],
+                                   task_args->copy_multi.counts[i],
+                                   UCC_MEMORY_TYPE_HOST, UCC_MEMORY_TYPE_HOST);
+            if (ucc_unlikely(UCC_OK != status)) {
+                break;
+            }
+        }
+        break;
     default:
         status = UCC_ERR_NOT_SUPPORTED;
+        break;
+    }
+    if (ucc_unlikely(UCC_OK != status)) {
         goto free_task;
     }
-    eee_task->status = status;
-    *task = eee_task;
+    eee_task->super.status = status;
+    *task = &eee_task->super;
 
     return status;
 
@@ -176,11 +316,18 @@ free_task:
 
 ucc_status_t ucc_cpu_executor_task_test(const ucc_ee_executor_task_t *task)
 {
-    return task->status;
+    /* written by the worker completing the last chunk */
+    return ((volatile ucc_ee_executor_task_t *)task)->status;
 }
 
 ucc_status_t ucc_cpu_executor_task_finalize(ucc_ee_executor_task_t *task)
 {
+    /* error paths of the caller may finalize a task that worker threads
+       still run, don't release it before they are done with it */
+    while (ucc_cpu_executor_task_test(task) == UCC_INPROGRESS) {
+        sched_yield();
+    }
+    ucc_memory_cpu_load_fence();
     ucc_mpool_put(task);
     return UCC_OK;
 }
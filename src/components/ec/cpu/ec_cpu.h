@@ -11,19 +11,96 @@
 #include "components/ec/ucc_ec_log.h"
 #include "utils/ucc_mpool.h"
 
+#include "utils/ucc_list.h"
+#include <pthread.h>
+
+typedef enum ucc_ec_cpu_reduce_simd {
+    UCC_EC_CPU_REDUCE_SIMD_AUTO,
+    UCC_EC_CPU_REDUCE_SIMD_NONE,
+    UCC_EC_CPU_REDUCE_SIMD_AVX2,
+    UCC_EC_CPU_REDUCE_SIMD_AVX512,
+    UCC_EC_CPU_REDUCE_SIMD_NEON,
+    UCC_EC_CPU_REDUCE_SIMD_SVE,
+    UCC_EC_CPU_REDUCE_SIMD_LAST
+} ucc_ec_cpu_reduce_simd_t;
+
+extern const char *ucc_ec_cpu_reduce_simd_names[];
+
 typedef struct ucc_ec_cpu_config {
-    ucc_ec_config_t super;
+    ucc_ec_config_t          super;
+    unsigned long            exec_num_threads;
+    size_t                   exec_mt_thresh;
+    int                      exec_pin_threads;
+    ucc_ec_cpu_reduce_simd_t reduce_simd;
 } ucc_ec_cpu_config_t;
 
+/* Persistent pool of worker threads executing large executor tasks in
+   chunks, started on the first task that goes to the pool */
+typedef struct ucc_ec_cpu_pool {
+    int              initialized;
+    int              stop;
+    unsigned         n_threads;
+    pthread_t       *threads;
+    pthread_mutex_t  lock;
+    pthread_cond_t   cond;
+    ucc_list_link_t  tasks; /* tasks with chunks not yet taken by workers */
+} ucc_ec_cpu_pool_t;
+
+typedef struct ucc_ec_cpu_executor_task {
+    ucc_ee_executor_task_t super;
+    ucc_list_link_t        list_elem;
+    size_t                 total;      /* elements or bytes for copies */
+    size_t                 chunk;
+    uint32_t               n_chunks;
+    uint32_t               next_chunk; /* protected by pool lock */
+    uint32_t               n_done;
+    ucc_status_t           chunk_status;
+} ucc_ec_cpu_executor_task_t;
+
 typedef struct ucc_ec_cpu {
     ucc_ec_base_t     super;
     ucc_thread_mode_t thread_mode;
     ucc_mpool_t       executors;
     ucc_mpool_t       executor_tasks;
     ucc_spinlock_t    init_spinlock;
+    ucc_ec_cpu_pool_t pool;
+    size_t            memcpy_nt_thresh; /* from mc cpu */
 } ucc_ec_cpu_t;
 
 extern ucc_ec_cpu_t ucc_ec_cpu;
 
+#define EC_CPU_CONFIG                                                          \
+    (ucc_derived_of(ucc_ec_cpu.super.config, ucc_ec_cpu_config_t))
+
 ucc_status_t ucc_ec_cpu_reduce(ucc_eee_task_reduce_t *task, void * restrict dst, void * const * restrict srcs, uint16_t flags);
+
+/* reduces n_srcs buffers of count elements into dst, dst may be one of the
+   sources */
+typedef void (*ucc_ec_cpu_reduce_kernel_t)(void *dst, void *const *srcs,
+                                           size_t count, uint32_t n_srcs);
+
+/* reduces bfloat16 or float16 buffers in fp32, the result is multiplied by
+   alpha before conversion back */
+typedef void (*ucc_ec_cpu_reduce_half_kernel_t)(void *dst, void *const *srcs,
+                                                size_t count, uint32_t n_srcs,
+                                                float alpha);
+
+/* selects the vectorized kernels used by ucc_ec_cpu_reduce */
+void ucc_ec_cpu_reduce_simd_init(ucc_ec_cpu_reduce_simd_t isa);
+
+/* returns NULL if there is no vectorized kernel for dt and op */
+ucc_ec_cpu_reduce_kernel_t
+ucc_ec_cpu_reduce_simd_kernel(ucc_datatype_t dt, ucc_reduction_op_t op);
+
+ucc_ec_cpu_reduce_half_kernel_t
+ucc_ec_cpu_reduce_simd_half_kernel(ucc_datatype_t dt, ucc_reduction_op_t op);
+
+/* executes elements [offset, offset + count) of the task, offset and count
+   are in bytes for copies */
+ucc_status_t ucc_ec_cpu_task_run(const ucc_ee_executor_task_args_t *args,
+                                 size_t offset, size_t count);
+
+ucc_status_t ucc_ec_cpu_pool_post(ucc_ec_cpu_executor_task_t *task);
+
+void ucc_ec_cpu_pool_finalize(ucc_ec_cpu_pool_t *pool);
 #endif
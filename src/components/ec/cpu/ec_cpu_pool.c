@@ -0,0 +1,245 @@
+/**
+ * Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "ec_cpu.h"
+#include "core/ucc_dt.h"
+#include "utils/ucc_math.h"
+#include "utils/ucc_atomic.h"
+#include "utils/arch/cpu.h"
+#include <sched.h>
+#include <string.h>
+
+/* Worker threads take chunks of posted tasks in FIFO order: a large task is
+   split into one chunk per worker so all of them reduce it concurrently
+   while the posting thread keeps driving the network. The task completes
+   when the worker finishing the last chunk publishes its status. */
+
+static void *ucc_ec_cpu_pool_worker(void *arg)
+{
+    ucc_ec_cpu_pool_t          *pool = arg;
+    ucc_ec_cpu_executor_task_t *task;
+    ucc_status_t                status;
+    uint32_t                    idx;
+    size_t                      offset;
+
+    pthread_mutex_lock(&pool->lock);
+    while (1) {
+        while (!pool->stop && ucc_list_is_empty(&pool->tasks)) {
+            pthread_cond_wait(&pool->cond, &pool->lock);
+        }
+        if (pool->stop) {
+            break;
+        }
+        task = ucc_list_head(&pool->tasks, ucc_ec_cpu_executor_task_t,
+                             list_elem);
+        idx  = task->next_chunk++;
+        if (task->next_chunk == task->n_chunks) {
+            ucc_list_del(&task->list_elem);
+        }
+        pthread_mutex_unlock(&pool->lock);
+
+        offset = idx * task->chunk;
+        status = ucc_ec_cpu_task_run(&task->super.args, offset,
+                                     ucc_min(task->chunk,
+                                             task->total - offset));
+        if (ucc_unlikely(UCC_OK != status)) {
+            task->chunk_status = status;
+        }
+        ucc_memory_cpu_store_fence();
+        if (ucc_atomic_fadd32(&task->n_done, 1) + 1 == task->n_chunks) {
+            ucc_memory_cpu_store_fence();
+            task->super.status = task->chunk_status;
+        }
+        pthread_mutex_lock(&pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+/* cpus of the process affinity mask in the order workers are pinned to
+   them, starting after the cpu of the calling thread. If the process is
+   bound to a numa node (or socket) workers stay there as well */
+static int ucc_ec_cpu_pool_cpus(int *cpus, int max_cpus)
+{
+    cpu_set_t mask;
+    int       n_cpus, cur, i, start;
+
+    if (sched_getaffinity(0, sizeof(mask), &mask)) {
+        return 0;
+    }
+    n_cpus = 0;
+    cur    = sched_getcpu();
+    start  = 0;
+    for (i = 0; i < CPU_SETSIZE && n_cpus < max_cpus; i++) {
+        if (CPU_ISSET(i, &mask)) {
+            if (i == cur) {
+                start = n_cpus;
+            }
+            cpus[n_cpus++] = i;
+        }
+    }
+    if (n_cpus > 1 && cur >= 0) {
+        /* rotate so that the calling cpu goes last */
+        for (i = 0; i < start + 1; i++) {
+            int tmp = cpus[0];
+
+            memmove(cpus, cpus + 1, (n_cpus - 1) * sizeof(int));
+            cpus[n_cpus - 1] = tmp;
+        }
+    }
+    return n_cpus;
+}
+
+static ucc_status_t ucc_ec_cpu_pool_init(ucc_ec_cpu_pool_t *pool,
+                                         unsigned           n_threads,
+                                         int                pin)
+{
+    int            cpus[CPU_SETSIZE];
+    int            n_cpus;
+    pthread_attr_t attr;
+    cpu_set_t      cpuset;
+    unsigned       i;
+    int            ret;
+
+    /* workers only help if they get cpus of their own: sharing the cpus of
+       the affinity mask with the posting thread, e.g. with one core per
+       rank, just adds context switches to the synchronous execution */
+    n_cpus = ucc_ec_cpu_pool_cpus(cpus, CPU_SETSIZE);
+    if (n_cpus > 0 && (unsigned)n_cpus <= n_threads) {
+        if (n_cpus == 1) {
+            ec_warn(&ucc_ec_cpu.super,
+                    "process is bound to a single cpu, ec cpu worker threads "
+                    "are disabled");
+            return UCC_ERR_NOT_SUPPORTED;
+        }
+        ec_warn(&ucc_ec_cpu.super,
+                "process is bound to %d cpus, using %d ec cpu worker threads "
+                "instead of %u", n_cpus, n_cpus - 1, n_threads);
+        n_threads = n_cpus - 1;
+    }
+    if (!pin) {
+        n_cpus = 0;
+    }
+
+    pool->threads = ucc_malloc(n_threads * sizeof(pthread_t), "ec cpu pool");
+    if (!pool->threads) {
+        ec_error(&ucc_ec_cpu.super,
+                 "failed to allocate %zd bytes for ec cpu pool threads",
+                 n_threads * sizeof(pthread_t));
+        return UCC_ERR_NO_MEMORY;
+    }
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->cond, NULL);
+    ucc_list_head_init(&pool->tasks);
+    pool->stop      = 0;
+    pool->n_threads = 0;
+
+    for (i = 0; i < n_threads; i++) {
+        pthread_attr_init(&attr);
+        if (n_cpus > 0) {
+            CPU_ZERO(&cpuset);
+            CPU_SET(cpus[i % n_cpus], &cpuset);
+            pthread_attr_setaffinity_np(&attr, sizeof(cpuset), &cpuset);
+        }
+        ret = pthread_create(&pool->threads[i], &attr, ucc_ec_cpu_pool_worker,
+                             pool);
+        pthread_attr_destroy(&attr);
+        if (ret != 0) {
+            ec_error(&ucc_ec_cpu.super,
+                     "failed to start ec cpu worker thread, error: %d(%s)",
+                     ret, strerror(ret));
+            ucc_ec_cpu_pool_finalize(pool);
+            return UCC_ERR_NO_RESOURCE;
+        }
+        pool->n_threads++;
+    }
+    ec_debug(&ucc_ec_cpu.super, "started %u ec cpu worker threads%s",
+             n_threads, n_cpus > 0 ? " (pinned)" : "");
+    return UCC_OK;
+}
+
+void ucc_ec_cpu_pool_finalize(ucc_ec_cpu_pool_t *pool)
+{
+    unsigned i;
+
+    if (!pool->threads) {
+        return;
+    }
+    pthread_mutex_lock(&pool->lock);
+    pool->stop = 1;
+    pthread_cond_broadcast(&pool->cond);
+    pthread_mutex_unlock(&pool->lock);
+    for (i = 0; i < pool->n_threads; i++) {
+        pthread_join(pool->threads[i], NULL);
+    }
+    pthread_cond_destroy(&pool->cond);
+    pthread_mutex_destroy(&pool->lock);
+    ucc_free(pool->threads);
+    pool->threads     = NULL;
+    pool->initialized = 0;
+}
+
+static size_t ucc_ec_cpu_task_elem_size(const ucc_ee_executor_task_args_t *args)
+{
+    switch (args->task_type) {
+    case UCC_EE_EXECUTOR_TASK_REDUCE:
+        return ucc_dt_size(args->reduce.dt);
+    case UCC_EE_EXECUTOR_TASK_REDUCE_STRIDED:
+        return ucc_dt_size(args->reduce_strided.dt);
+    default:
+        return 1;
+    }
+}
+
+ucc_status_t ucc_ec_cpu_pool_post(ucc_ec_cpu_executor_task_t *task)
+{
+    ucc_ec_cpu_pool_t *pool = &ucc_ec_cpu.pool;
+    size_t             align;
+    ucc_status_t       status;
+
+    if (ucc_unlikely(!pool->initialized)) {
+        ucc_spin_lock(&ucc_ec_cpu.init_spinlock);
+        if (!pool->initialized) {
+            status = ucc_ec_cpu_pool_init(pool,
+                                          EC_CPU_CONFIG->exec_num_threads,
+                                          EC_CPU_CONFIG->exec_pin_threads);
+            if (UCC_ERR_NOT_SUPPORTED == status) {
+                /* pool stays empty, tasks are executed synchronously */
+                pool->threads   = NULL;
+                pool->n_threads = 0;
+            } else if (UCC_OK != status) {
+                ucc_spin_unlock(&ucc_ec_cpu.init_spinlock);
+                return status;
+            }
+            pool->initialized = 1;
+        }
+        ucc_spin_unlock(&ucc_ec_cpu.init_spinlock);
+    }
+    if (ucc_unlikely(0 == pool->n_threads)) {
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+
+    /* chunk boundaries are kept cache line aligned */
+    align = ucc_max(UCC_CACHE_LINE_SIZE /
+                        ucc_ec_cpu_task_elem_size(&task->super.args), 1);
+    task->chunk        = ucc_align_up(ucc_div_round_up(task->total,
+                                                       pool->n_threads),
+                                      align);
+    task->n_chunks     = ucc_div_round_up(task->total, task->chunk);
+    task->next_chunk   = 0;
+    task->n_done       = 0;
+    task->chunk_status = UCC_OK;
+
+    pthread_mutex_lock(&pool->lock);
+    ucc_list_add_tail(&pool->tasks, &task->list_elem);
+    if (task->n_chunks > 1) {
+        pthread_cond_broadcast(&pool->cond);
+    } else {
+        pthread_cond_signal(&pool->cond);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return UCC_OK;
+}
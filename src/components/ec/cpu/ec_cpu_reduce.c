@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2022-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2022-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  *
  * See file LICENSE for terms.
  */
@@ -13,6 +13,10 @@
         size_t _i, _j;                                                         \
         type  _tmp;                                                            \
         size_t __count = _count;                                               \
+        if (kernel) {                                                          \
+            kernel(d, (void *const *)s, __count, _n_srcs);                     \
+            break;                                                             \
+        }                                                                      \
         switch (_n_srcs) {                                                     \
         case 2:                                                                \
             for (_i = 0; _i < __count; _i++) {                                 \
@@ -122,48 +126,56 @@
         }                                                                      \
     } while (0)
 
-#define DO_DT_REDUCE_WITH_OP_BFLOAT16(_srcs, _dst, _count, _n_srcs, _OP,       \
-                                      _alpha)                                  \
+/* bfloat16 and float16 are reduced in fp32 across all the sources and
+   converted back once */
+#define DO_DT_REDUCE_WITH_OP_HALF(_srcs, _dst, _count, _n_srcs, _OP, _alpha,  \
+                                  _to_f32, _from_f32)                          \
     do {                                                                       \
         float     _tmp;                                                        \
         size_t    _i, _j;                                                      \
         int16_t **_s = (int16_t **)_srcs;                                      \
         int16_t * _d = (int16_t *)_dst;                                        \
         for (_i = 0; _i < _count; _i++) {                                      \
-            _tmp = _OP(bfloat16tofloat32(&_s[0][_i]),                          \
-                       bfloat16tofloat32(&_s[1][_i]));                         \
+            _tmp = _OP(_to_f32(&_s[0][_i]), _to_f32(&_s[1][_i]));              \
             for (_j = 2; _j < _n_srcs; _j++) {                                 \
-                _tmp = _OP(_tmp, bfloat16tofloat32(&_s[_j][_i]));              \
+                _tmp = _OP(_tmp, _to_f32(&_s[_j][_i]));                        \
             }                                                                  \
-            float32tobfloat16(_tmp *_alpha, &_d[_i]);                          \
+            _from_f32(_tmp *_alpha, &_d[_i]);                                  \
         }                                                                      \
     } while (0)
 
-#define DO_DT_REDUCE_BFLOAT16(_srcs, _dst, _op, _count, _n_srcs)               \
+#define DO_DT_REDUCE_HALF(_name, _srcs, _dst, _op, _count, _n_srcs, _to_f32,  \
+                          _from_f32)                                           \
     do {                                                                       \
         float _a = (flags & UCC_EEE_TASK_FLAG_REDUCE_WITH_ALPHA) ? task->alpha \
                                                                  : 1.0f;       \
+        ucc_ec_cpu_reduce_half_kernel_t _kernel =                              \
+            ucc_ec_cpu_reduce_simd_half_kernel(task->dt, _op);                 \
+        if (_kernel) {                                                         \
+            _kernel(_dst, _srcs, _count, _n_srcs, _a);                         \
+            break;                                                             \
+        }                                                                      \
         switch (_op) {                                                         \
         case UCC_OP_AVG:                                                       \
         case UCC_OP_SUM:                                                       \
-            DO_DT_REDUCE_WITH_OP_BFLOAT16(_srcs, _dst, _count, _n_srcs,        \
-                                          DO_OP_SUM, _a);                      \
+            DO_DT_REDUCE_WITH_OP_HALF(_srcs, _dst, _count, _n_srcs,            \
+                                      DO_OP_SUM, _a, _to_f32, _from_f32);      \
             break;                                                             \
         case UCC_OP_PROD:                                                      \
-            DO_DT_REDUCE_WITH_OP_BFLOAT16(_srcs, _dst, _count, _n_srcs,        \
-                                          DO_OP_PROD, _a);                     \
+            DO_DT_REDUCE_WITH_OP_HALF(_srcs, _dst, _count, _n_srcs,            \
+                                      DO_OP_PROD, _a, _to_f32, _from_f32);     \
             break;                                                             \
         case UCC_OP_MIN:                                                       \
-            DO_DT_REDUCE_WITH_OP_BFLOAT16(_srcs, _dst, _count, _n_srcs,        \
-                                          DO_OP_MIN, _a);                      \
+            DO_DT_REDUCE_WITH_OP_HALF(_srcs, _dst, _count, _n_srcs,            \
+                                      DO_OP_MIN, _a, _to_f32, _from_f32);      \
             break;                                                             \
         case UCC_OP_MAX:                                                       \
-            DO_DT_REDUCE_WITH_OP_BFLOAT16(_srcs, _dst, _count, _n_srcs,        \
-                                          DO_OP_MAX, _a);                      \
+            DO_DT_REDUCE_WITH_OP_HALF(_srcs, _dst, _count, _n_srcs,            \
+                                      DO_OP_MAX, _a, _to_f32, _from_f32);      \
             break;                                                             \
         default:                                                               \
             ec_error(&ucc_ec_cpu.super,                                        \
-                     "bfloat16 dtype does not support "                        \
+                     _name " dtype does not support "                          \
                      "requested reduce op: %s",                                \
                      ucc_reduction_op_str(_op));                               \
             return UCC_ERR_NOT_SUPPORTED;                                      \
@@ -227,6 +239,10 @@
 ucc_status_t ucc_ec_cpu_reduce(ucc_eee_task_reduce_t *task, void * restrict dst,
                                void * const * restrict srcs, uint16_t flags)
 {
+    /* vectorized kernel selected at init, used by DO_DT_REDUCE_WITH_OP */
+    ucc_ec_cpu_reduce_kernel_t kernel =
+        ucc_ec_cpu_reduce_simd_kernel(task->dt, task->op);
+
     switch (task->dt) {
     case UCC_DT_INT8:
         DO_DT_REDUCE_INT(int8_t, srcs, dst, task->op, task->count,
@@ -285,8 +301,12 @@ ucc_status_t ucc_ec_cpu_reduce(ucc_eee_task_reduce_t *task, void * restrict dst,
         return UCC_ERR_NOT_SUPPORTED;
 #endif
     case UCC_DT_BFLOAT16:
-        DO_DT_REDUCE_BFLOAT16(srcs, dst, task->op, task->count,
-                              task->n_srcs);
+        DO_DT_REDUCE_HALF("bfloat16", srcs, dst, task->op, task->count,
+                          task->n_srcs, bfloat16tofloat32, float32tobfloat16);
+        break;
+    case UCC_DT_FLOAT16:
+        DO_DT_REDUCE_HALF("float16", srcs, dst, task->op, task->count,
+                          task->n_srcs, float16tofloat32, float32tofloat16);
         break;
     case UCC_DT_FLOAT32_COMPLEX:
 #if SIZEOF_FLOAT__COMPLEX == 8
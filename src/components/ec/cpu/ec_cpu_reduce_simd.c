@@ -0,0 +1,724 @@
+/**
+ * Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "ec_cpu.h"
+#include "utils/ucc_math_op.h"
+#include "utils/ucc_math.h"
+#include "utils/arch/cpu.h"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#ifdef __ARM_FEATURE_SVE
+#include <arm_sve.h>
+#endif
+#endif
+
+/* Vectorized reductions of float32/float64/int32/int64 for sum/avg, prod,
+   min and max. Sources are folded left to right, the same order the scalar
+   code uses, so sum and prod results are bitwise identical to it. Kernels
+   for a given isa are compiled with the matching target attribute and
+   selected at ec init from the cpu flags, so the library still runs on cpus
+   without them. Combinations without a kernel (e.g. int64 prod, which needs
+   AVX-512DQ) fall back to the scalar code.
+
+   bfloat16 and float16 are widened to fp32 in registers, reduced in fp32
+   across all the sources and narrowed once, like the scalar code does.
+   bfloat16 is narrowed by truncation as float32tobfloat16 does rather than
+   with the rounding AVX-512 BF16 instructions, so that the result does not
+   depend on the cpu of the rank computing it. */
+
+enum {
+    UCC_EC_CPU_SIMD_DT_FLOAT32,
+    UCC_EC_CPU_SIMD_DT_FLOAT64,
+    UCC_EC_CPU_SIMD_DT_INT32,
+    UCC_EC_CPU_SIMD_DT_INT64,
+    UCC_EC_CPU_SIMD_DT_LAST
+};
+
+enum {
+    UCC_EC_CPU_SIMD_OP_SUM,
+    UCC_EC_CPU_SIMD_OP_PROD,
+    UCC_EC_CPU_SIMD_OP_MIN,
+    UCC_EC_CPU_SIMD_OP_MAX,
+    UCC_EC_CPU_SIMD_OP_LAST
+};
+
+typedef ucc_ec_cpu_reduce_kernel_t
+    ucc_ec_cpu_reduce_kernels_t[UCC_EC_CPU_SIMD_DT_LAST]
+                               [UCC_EC_CPU_SIMD_OP_LAST];
+
+enum {
+    UCC_EC_CPU_SIMD_HALF_DT_BFLOAT16,
+    UCC_EC_CPU_SIMD_HALF_DT_FLOAT16,
+    UCC_EC_CPU_SIMD_HALF_DT_LAST
+};
+
+typedef ucc_ec_cpu_reduce_half_kernel_t
+    ucc_ec_cpu_reduce_half_kernels_t[UCC_EC_CPU_SIMD_HALF_DT_LAST]
+                                    [UCC_EC_CPU_SIMD_OP_LAST];
+
+static const ucc_ec_cpu_reduce_kernels_t      *ucc_ec_cpu_reduce_kernels = NULL;
+static const ucc_ec_cpu_reduce_half_kernels_t *ucc_ec_cpu_reduce_half_kernels =
+    NULL;
+
+const char *ucc_ec_cpu_reduce_simd_names[] = {
+    [UCC_EC_CPU_REDUCE_SIMD_AUTO]   = "auto",
+    [UCC_EC_CPU_REDUCE_SIMD_NONE]   = "none",
+    [UCC_EC_CPU_REDUCE_SIMD_AVX2]   = "avx2",
+    [UCC_EC_CPU_REDUCE_SIMD_AVX512] = "avx512",
+    [UCC_EC_CPU_REDUCE_SIMD_NEON]   = "neon",
+    [UCC_EC_CPU_REDUCE_SIMD_SVE]    = "sve",
+    [UCC_EC_CPU_REDUCE_SIMD_LAST]   = NULL
+};
+
+#define UCC_EC_CPU_REDUCE_KERNEL_NAME(_isa, _dt, _op)                          \
+    ucc_ec_cpu_reduce_##_isa##_##_dt##_##_op
+
+/* fixed width vector loop, two vectors per iteration, scalar tail */
+#define UCC_EC_CPU_REDUCE_KERNEL(_isa, _dt, _op, _attr, _type, _vtype,         \
+                                 _width, _load, _store, _vop, _sop)            \
+    static _attr void UCC_EC_CPU_REDUCE_KERNEL_NAME(_isa, _dt, _op)(           \
+        void *dst, void *const *srcs, size_t count, uint32_t n_srcs)           \
+    {                                                                          \
+        const _type **s = (const _type **)srcs;                                \
+        _type        *d = (_type *)dst;                                        \
+        size_t        i;                                                       \
+        uint32_t      j;                                                       \
+        _vtype        a0, a1, v0, v1;                                          \
+        _type         t;                                                       \
+                                                                               \
+        for (i = 0; i + 2 * _width <= count; i += 2 * _width) {                \
+            a0 = _load(s[0] + i);                                              \
+            a1 = _load(s[0] + i + _width);                                     \
+            for (j = 1; j < n_srcs; j++) {                                     \
+                v0 = _load(s[j] + i);                                          \
+                v1 = _load(s[j] + i + _width);                                 \
+                a0 = _vop(a0, v0);                                             \
+                a1 = _vop(a1, v1);                                             \
+            }                                                                  \
+            _store(d + i, a0);                                                 \
+            _store(d + i + _width, a1);                                        \
+        }                                                                      \
+        for (; i + _width <= count; i += _width) {                             \
+            a0 = _load(s[0] + i);                                              \
+            for (j = 1; j < n_srcs; j++) {                                     \
+                v0 = _load(s[j] + i);                                          \
+                a0 = _vop(a0, v0);                                             \
+            }                                                                  \
+            _store(d + i, a0);                                                 \
+        }                                                                      \
+        for (; i < count; i++) {                                               \
+            t = s[0][i];                                                       \
+            for (j = 1; j < n_srcs; j++) {                                     \
+                t = _sop(t, s[j][i]);                                          \
+            }                                                                  \
+            d[i] = t;                                                          \
+        }                                                                      \
+    }
+
+/* 16 bit sources are loaded to and stored from fp32 vectors, alpha is
+   applied before narrowing */
+#define UCC_EC_CPU_REDUCE_HALF_KERNEL(_isa, _dt, _op, _attr, _vtype, _width,   \
+                                      _load, _store, _vop, _mul, _set1,        \
+                                      _sop, _to_f32, _from_f32)                \
+    static _attr void UCC_EC_CPU_REDUCE_KERNEL_NAME(_isa, _dt, _op)(           \
+        void *dst, void *const *srcs, size_t count, uint32_t n_srcs,           \
+        float alpha)                                                           \
+    {                                                                          \
+        const uint16_t **s = (const uint16_t **)srcs;                          \
+        uint16_t        *d = (uint16_t *)dst;                                  \
+        _vtype           va = _set1(alpha);                                    \
+        size_t           i;                                                    \
+        uint32_t         j;                                                    \
+        _vtype           a0, a1, v0, v1;                                       \
+        float            t;                                                    \
+                                                                               \
+        for (i = 0; i + 2 * _width <= count; i += 2 * _width) {                \
+            a0 = _load(s[0] + i);                                              \
+            a1 = _load(s[0] + i + _width);                                     \
+            for (j = 1; j < n_srcs; j++) {                                     \
+                v0 = _load(s[j] + i);                                          \
+                v1 = _load(s[j] + i + _width);                                 \
+                a0 = _vop(a0, v0);                                             \
+                a1 = _vop(a1, v1);                                             \
+            }                                                                  \
+            a0 = _mul(a0, va);                                                 \
+            a1 = _mul(a1, va);                                                 \
+            _store(d + i, a0);                                                 \
+            _store(d + i + _width, a1);                                        \
+        }                                                                      \
+        for (; i + _width <= count; i += _width) {                             \
+            a0 = _load(s[0] + i);                                              \
+            for (j = 1; j < n_srcs; j++) {                                     \
+                v0 = _load(s[j] + i);                                          \
+                a0 = _vop(a0, v0);                                             \
+            }                                                                  \
+            a0 = _mul(a0, va);                                                 \
+            _store(d + i, a0);                                                 \
+        }                                                                      \
+        for (; i < count; i++) {                                               \
+            t = _to_f32(&s[0][i]);                                             \
+            for (j = 1; j < n_srcs; j++) {                                     \
+                t = _sop(t, _to_f32(&s[j][i]));                                \
+            }                                                                  \
+            _from_f32(t * alpha, &d[i]);                                       \
+        }                                                                      \
+    }
+
+#define UCC_EC_CPU_REDUCE_HALF_TABLE(_isa)                                     \
+    {                                                                          \
+        [UCC_EC_CPU_SIMD_HALF_DT_BFLOAT16] =                                   \
+            {ucc_ec_cpu_reduce_##_isa##_bf16_sum,                              \
+             ucc_ec_cpu_reduce_##_isa##_bf16_prod,                             \
+             ucc_ec_cpu_reduce_##_isa##_bf16_min,                              \
+             ucc_ec_cpu_reduce_##_isa##_bf16_max},                             \
+        [UCC_EC_CPU_SIMD_HALF_DT_FLOAT16] =                                    \
+            {ucc_ec_cpu_reduce_##_isa##_f16_sum,                               \
+             ucc_ec_cpu_reduce_##_isa##_f16_prod,                              \
+             ucc_ec_cpu_reduce_##_isa##_f16_min,                               \
+             ucc_ec_cpu_reduce_##_isa##_f16_max}                               \
+    }
+
+#if defined(__x86_64__)
+
+/* all cpus with AVX2 implement F16C as well */
+#define UCC_EC_CPU_TARGET_AVX2   __attribute__((target("avx2,f16c")))
+#define UCC_EC_CPU_TARGET_AVX512 __attribute__((target("avx512f")))
+
+#define AVX2_LOAD_SI(_p)        _mm256_loadu_si256((const __m256i *)(_p))
+#define AVX2_STORE_SI(_p, _v)   _mm256_storeu_si256((__m256i *)(_p), _v)
+#define AVX2_MIN_I64(_a, _b)                                                   \
+    _mm256_blendv_epi8(_a, _b, _mm256_cmpgt_epi64(_a, _b))
+#define AVX2_MAX_I64(_a, _b)                                                   \
+    _mm256_blendv_epi8(_b, _a, _mm256_cmpgt_epi64(_a, _b))
+
+#define AVX2_KERNEL(_dt, _op, _type, _vtype, _width, _load, _store, _vop,      \
+                    _sop)                                                      \
+    UCC_EC_CPU_REDUCE_KERNEL(avx2, _dt, _op, UCC_EC_CPU_TARGET_AVX2, _type,    \
+                             _vtype, _width, _load, _store, _vop, _sop)
+
+AVX2_KERNEL(f32, sum,  float, __m256, 8, _mm256_loadu_ps, _mm256_storeu_ps,
+            _mm256_add_ps, DO_OP_SUM_2)
+AVX2_KERNEL(f32, prod, float, __m256, 8, _mm256_loadu_ps, _mm256_storeu_ps,
+            _mm256_mul_ps, DO_OP_PROD_2)
+AVX2_KERNEL(f32, min,  float, __m256, 8, _mm256_loadu_ps, _mm256_storeu_ps,
+            _mm256_min_ps, DO_OP_MIN_2)
+AVX2_KERNEL(f32, max,  float, __m256, 8, _mm256_loadu_ps, _mm256_storeu_ps,
+            _mm256_max_ps, DO_OP_MAX_2)
+AVX2_KERNEL(f64, sum,  double, __m256d, 4, _mm256_loadu_pd, _mm256_storeu_pd,
+            _mm256_add_pd, DO_OP_SUM_2)
+AVX2_KERNEL(f64, prod, double, __m256d, 4, _mm256_loadu_pd, _mm256_storeu_pd,
+            _mm256_mul_pd, DO_OP_PROD_2)
+AVX2_KERNEL(f64, min,  double, __m256d, 4, _mm256_loadu_pd, _mm256_storeu_pd,
+            _mm256_min_pd, DO_OP_MIN_2)
+AVX2_KERNEL(f64, max,  double, __m256d, 4, _mm256_loadu_pd, _mm256_storeu_pd,
+            _mm256_max_pd, DO_OP_MAX_2)
+AVX2_KERNEL(i32, sum,  int32_t, __m256i, 8, AVX2_LOAD_SI, AVX2_STORE_SI,
+            _mm256_add_epi32, DO_OP_SUM_2)
+AVX2_KERNEL(i32, prod, int32_t, __m256i, 8, AVX2_LOAD_SI, AVX2_STORE_SI,
+            _mm256_mullo_epi32, DO_OP_PROD_2)
+AVX2_KERNEL(i32, min,  int32_t, __m256i, 8, AVX2_LOAD_SI, AVX2_STORE_SI,
+            _mm256_min_epi32, DO_OP_MIN_2)
+AVX2_KERNEL(i32, max,  int32_t, __m256i, 8, AVX2_LOAD_SI, AVX2_STORE_SI,
+            _mm256_max_epi32, DO_OP_MAX_2)
+AVX2_KERNEL(i64, sum,  int64_t, __m256i, 4, AVX2_LOAD_SI, AVX2_STORE_SI,
+            _mm256_add_epi64, DO_OP_SUM_2)
+AVX2_KERNEL(i64, min,  int64_t, __m256i, 4, AVX2_LOAD_SI, AVX2_STORE_SI,
+            AVX2_MIN_I64, DO_OP_MIN_2)
+AVX2_KERNEL(i64, max,  int64_t, __m256i, 4, AVX2_LOAD_SI, AVX2_STORE_SI,
+            AVX2_MAX_I64, DO_OP_MAX_2)
+
+static const ucc_ec_cpu_reduce_kernels_t ucc_ec_cpu_reduce_kernels_avx2 = {
+    [UCC_EC_CPU_SIMD_DT_FLOAT32] = {ucc_ec_cpu_reduce_avx2_f32_sum,
+                                    ucc_ec_cpu_reduce_avx2_f32_prod,
+                                    ucc_ec_cpu_reduce_avx2_f32_min,
+                                    ucc_ec_cpu_reduce_avx2_f32_max},
+    [UCC_EC_CPU_SIMD_DT_FLOAT64] = {ucc_ec_cpu_reduce_avx2_f64_sum,
+                                    ucc_ec_cpu_reduce_avx2_f64_prod,
+                                    ucc_ec_cpu_reduce_avx2_f64_min,
+                                    ucc_ec_cpu_reduce_avx2_f64_max},
+    [UCC_EC_CPU_SIMD_DT_INT32]   = {ucc_ec_cpu_reduce_avx2_i32_sum,
+                                    ucc_ec_cpu_reduce_avx2_i32_prod,
+                                    ucc_ec_cpu_reduce_avx2_i32_min,
+                                    ucc_ec_cpu_reduce_avx2_i32_max},
+    [UCC_EC_CPU_SIMD_DT_INT64]   = {ucc_ec_cpu_reduce_avx2_i64_sum,
+                                    NULL,
+                                    ucc_ec_cpu_reduce_avx2_i64_min,
+                                    ucc_ec_cpu_reduce_avx2_i64_max}};
+
+#define AVX2_LOAD_BF16(_p)                                                     \
+    _mm256_castsi256_ps(_mm256_slli_epi32(                                     \
+        _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(_p))), 16))
+#define AVX2_STORE_BF16(_p, _v)                                                \
+    do {                                                                       \
+        __m256i _t = _mm256_srli_epi32(_mm256_castps_si256(_v), 16);           \
+        _mm_storeu_si128((__m128i *)(_p),                                      \
+                         _mm_packus_epi32(_mm256_castsi256_si128(_t),          \
+                                          _mm256_extracti128_si256(_t, 1)));   \
+    } while (0)
+#define AVX2_LOAD_F16(_p)                                                      \
+    _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *)(_p)))
+#define AVX2_STORE_F16(_p, _v)                                                 \
+    _mm_storeu_si128((__m128i *)(_p),                                          \
+                     _mm256_cvtps_ph(_v, _MM_FROUND_TO_NEAREST_INT))
+
+#define AVX2_HALF_KERNEL(_dt, _op, _load, _store, _vop, _sop, _to, _from)      \
+    UCC_EC_CPU_REDUCE_HALF_KERNEL(avx2, _dt, _op, UCC_EC_CPU_TARGET_AVX2,      \
+                                  __m256, 8, _load, _store, _vop,              \
+                                  _mm256_mul_ps, _mm256_set1_ps, _sop, _to,    \
+                                  _from)
+#define AVX2_HALF_KERNELS(_dt, _load, _store, _to, _from)                      \
+    AVX2_HALF_KERNEL(_dt, sum, _load, _store, _mm256_add_ps, DO_OP_SUM_2,      \
+                     _to, _from)                                               \
+    AVX2_HALF_KERNEL(_dt, prod, _load, _store, _mm256_mul_ps, DO_OP_PROD_2,    \
+                     _to, _from)                                               \
+    AVX2_HALF_KERNEL(_dt, min, _load, _store, _mm256_min_ps, DO_OP_MIN_2,      \
+                     _to, _from)                                               \
+    AVX2_HALF_KERNEL(_dt, max, _load, _store, _mm256_max_ps, DO_OP_MAX_2,      \
+                     _to, _from)
+
+AVX2_HALF_KERNELS(bf16, AVX2_LOAD_BF16, AVX2_STORE_BF16, bfloat16tofloat32,
+                  float32tobfloat16)
+AVX2_HALF_KERNELS(f16, AVX2_LOAD_F16, AVX2_STORE_F16, float16tofloat32,
+                  float32tofloat16)
+
+static const ucc_ec_cpu_reduce_half_kernels_t
+    ucc_ec_cpu_reduce_half_kernels_avx2 = UCC_EC_CPU_REDUCE_HALF_TABLE(avx2);
+
+#define AVX512_LOAD_SI(_p)      _mm512_loadu_si512((const void *)(_p))
+#define AVX512_STORE_SI(_p, _v) _mm512_storeu_si512((void *)(_p), _v)
+
+#define AVX512_KERNEL(_dt, _op, _type, _vtype, _width, _load, _store, _vop,    \
+                      _sop)                                                    \
+    UCC_EC_CPU_REDUCE_KERNEL(avx512, _dt, _op, UCC_EC_CPU_TARGET_AVX512,       \
+                             _type, _vtype, _width, _load, _store, _vop, _sop)
+
+AVX512_KERNEL(f32, sum,  float, __m512, 16, _mm512_loadu_ps, _mm512_storeu_ps,
+              _mm512_add_ps, DO_OP_SUM_2)
+AVX512_KERNEL(f32, prod, float, __m512, 16, _mm512_loadu_ps, _mm512_storeu_ps,
+              _mm512_mul_ps, DO_OP_PROD_2)
+AVX512_KERNEL(f32, min,  float, __m512, 16, _mm512_loadu_ps, _mm512_storeu_ps,
+              _mm512_min_ps, DO_OP_MIN_2)
+AVX512_KERNEL(f32, max,  float, __m512, 16, _mm512_loadu_ps, _mm512_storeu_ps,
+              _mm512_max_ps, DO_OP_MAX_2)
+AVX512_KERNEL(f64, sum,  double, __m512d, 8, _mm512_loadu_pd,
+              _mm512_storeu_pd, _mm512_add_pd, DO_OP_SUM_2)
+AVX512_KERNEL(f64, prod, double, __m512d, 8, _mm512_loadu_pd,
+              _mm512_storeu_pd, _mm512_mul_pd, DO_OP_PROD_2)
+AVX512_KERNEL(f64, min,  double, __m512d, 8, _mm512_loadu_pd,
+              _mm512_storeu_pd, _mm512_min_pd, DO_OP_MIN_2)
+AVX512_KERNEL(f64, max,  double, __m512d, 8, _mm512_loadu_pd,
+              _mm512_storeu_pd, _mm512_max_pd, DO_OP_MAX_2)
+AVX512_KERNEL(i32, sum,  int32_t, __m512i, 16, AVX512_LOAD_SI,
+              AVX512_STORE_SI, _mm512_add_epi32, DO_OP_SUM_2)
+AVX512_KERNEL(i32, prod, int32_t, __m512i, 16, AVX512_LOAD_SI,
+              AVX512_STORE_SI, _mm512_mullo_epi32, DO_OP_PROD_2)
+AVX512_KERNEL(i32, min,  int32_t, __m512i, 16, AVX512_LOAD_SI,
+              AVX512_STORE_SI, _mm512_min_epi32, DO_OP_MIN_2)
+AVX512_KERNEL(i32, max,  int32_t, __m512i, 16, AVX512_LOAD_SI,
+              AVX512_STORE_SI, _mm512_max_epi32, DO_OP_MAX_2)
+AVX512_KERNEL(i64, sum,  int64_t, __m512i, 8, AVX512_LOAD_SI,
+              AVX512_STORE_SI, _mm512_add_epi64, DO_OP_SUM_2)
+AVX512_KERNEL(i64, min,  int64_t, __m512i, 8, AVX512_LOAD_SI,
+              AVX512_STORE_SI, _mm512_min_epi64, DO_OP_MIN_2)
+AVX512_KERNEL(i64, max,  int64_t, __m512i, 8, AVX512_LOAD_SI,
+              AVX512_STORE_SI, _mm512_max_epi64, DO_OP_MAX_2)
+
+static const ucc_ec_cpu_reduce_kernels_t ucc_ec_cpu_reduce_kernels_avx512 = {
+    [UCC_EC_CPU_SIMD_DT_FLOAT32] = {ucc_ec_cpu_reduce_avx512_f32_sum,
+                                    ucc_ec_cpu_reduce_avx512_f32_prod,
+                                    ucc_ec_cpu_reduce_avx512_f32_min,
+                                    ucc_ec_cpu_reduce_avx512_f32_max},
+    [UCC_EC_CPU_SIMD_DT_FLOAT64] = {ucc_ec_cpu_reduce_avx512_f64_sum,
+                                    ucc_ec_cpu_reduce_avx512_f64_prod,
+                                    ucc_ec_cpu_reduce_avx512_f64_min,
+                                    ucc_ec_cpu_reduce_avx512_f64_max},
+    [UCC_EC_CPU_SIMD_DT_INT32]   = {ucc_ec_cpu_reduce_avx512_i32_sum,
+                                    ucc_ec_cpu_reduce_avx512_i32_prod,
+                                    ucc_ec_cpu_reduce_avx512_i32_min,
+                                    ucc_ec_cpu_reduce_avx512_i32_max},
+    [UCC_EC_CPU_SIMD_DT_INT64]   = {ucc_ec_cpu_reduce_avx512_i64_sum,
+                                    NULL,
+                                    ucc_ec_cpu_reduce_avx512_i64_min,
+                                    ucc_ec_cpu_reduce_avx512_i64_max}};
+
+#define AVX512_LOAD_BF16(_p)                                                   \
+    _mm512_castsi512_ps(_mm512_slli_epi32(                                     \
+        _mm512_cvtepu16_epi32(_mm256_loadu_si256((const __m256i *)(_p))), 16))
+#define AVX512_STORE_BF16(_p, _v)                                              \
+    _mm256_storeu_si256((__m256i *)(_p),                                       \
+                        _mm512_cvtepi32_epi16(_mm512_srli_epi32(               \
+                            _mm512_castps_si512(_v), 16)))
+#define AVX512_LOAD_F16(_p)                                                    \
+    _mm512_cvtph_ps(_mm256_loadu_si256((const __m256i *)(_p)))
+#define AVX512_STORE_F16(_p, _v)                                               \
+    _mm256_storeu_si256((__m256i *)(_p),                                       \
+                        _mm512_cvtps_ph(_v, _MM_FROUND_TO_NEAREST_INT))
+
+#define AVX512_HALF_KERNEL(_dt, _op, _load, _store, _vop, _sop, _to, _from)    \
+    UCC_EC_CPU_REDUCE_HALF_KERNEL(avx512, _dt, _op, UCC_EC_CPU_TARGET_AVX512,  \
+                                  __m512, 16, _load, _store, _vop,             \
+                                  _mm512_mul_ps, _mm512_set1_ps, _sop, _to,    \
+                                  _from)
+#define AVX512_HALF_KERNELS(_dt, _load, _store, _to, _from)                    \
+    AVX512_HALF_KERNEL(_dt, sum, _load, _store, _mm512_add_ps, DO_OP_SUM_2,    \
+                       _to, _from)                                             \
+    AVX512_HALF_KERNEL(_dt, prod, _load, _store, _mm512_mul_ps, DO_OP_PROD_2,  \
+                       _to, _from)                                             \
+    AVX512_HALF_KERNEL(_dt, min, _load, _store, _mm512_min_ps, DO_OP_MIN_2,    \
+                       _to, _from)                                             \
+    AVX512_HALF_KERNEL(_dt, max, _load, _store, _mm512_max_ps, DO_OP_MAX_2,    \
+                       _to, _from)
+
+AVX512_HALF_KERNELS(bf16, AVX512_LOAD_BF16, AVX512_STORE_BF16,
+                    bfloat16tofloat32, float32tobfloat16)
+AVX512_HALF_KERNELS(f16, AVX512_LOAD_F16, AVX512_STORE_F16, float16tofloat32,
+                    float32tofloat16)
+
+static const ucc_ec_cpu_reduce_half_kernels_t
+    ucc_ec_cpu_reduce_half_kernels_avx512 =
+        UCC_EC_CPU_REDUCE_HALF_TABLE(avx512);
+
+#elif defined(__aarch64__)
+
+/* NEON is part of the base aarch64 isa. Floating point min/max use compare
+   and select rather than vminq/vmaxq to keep the NaN handling of the scalar
+   code */
+#define NEON_MIN(_sfx, _a, _b) vbslq_##_sfx(vcltq_##_sfx(_a, _b), _a, _b)
+#define NEON_MAX(_sfx, _a, _b) vbslq_##_sfx(vcgtq_##_sfx(_a, _b), _a, _b)
+#define NEON_MIN_F32(_a, _b)   NEON_MIN(f32, _a, _b)
+#define NEON_MAX_F32(_a, _b)   NEON_MAX(f32, _a, _b)
+#define NEON_MIN_F64(_a, _b)   NEON_MIN(f64, _a, _b)
+#define NEON_MAX_F64(_a, _b)   NEON_MAX(f64, _a, _b)
+#define NEON_MIN_S64(_a, _b)   NEON_MIN(s64, _a, _b)
+#define NEON_MAX_S64(_a, _b)   NEON_MAX(s64, _a, _b)
+
+#define NEON_KERNEL(_dt, _op, _type, _vtype, _width, _load, _store, _vop,      \
+                    _sop)                                                      \
+    UCC_EC_CPU_REDUCE_KERNEL(neon, _dt, _op, , _type, _vtype, _width, _load,   \
+                             _store, _vop, _sop)
+
+NEON_KERNEL(f32, sum,  float, float32x4_t, 4, vld1q_f32, vst1q_f32, vaddq_f32,
+            DO_OP_SUM_2)
+NEON_KERNEL(f32, prod, float, float32x4_t, 4, vld1q_f32, vst1q_f32, vmulq_f32,
+            DO_OP_PROD_2)
+NEON_KERNEL(f32, min,  float, float32x4_t, 4, vld1q_f32, vst1q_f32,
+            NEON_MIN_F32, DO_OP_MIN_2)
+NEON_KERNEL(f32, max,  float, float32x4_t, 4, vld1q_f32, vst1q_f32,
+            NEON_MAX_F32, DO_OP_MAX_2)
+NEON_KERNEL(f64, sum,  double, float64x2_t, 2, vld1q_f64, vst1q_f64,
+            vaddq_f64, DO_OP_SUM_2)
+NEON_KERNEL(f64, prod, double, float64x2_t, 2, vld1q_f64, vst1q_f64,
+            vmulq_f64, DO_OP_PROD_2)
+NEON_KERNEL(f64, min,  double, float64x2_t, 2, vld1q_f64, vst1q_f64,
+            NEON_MIN_F64, DO_OP_MIN_2)
+NEON_KERNEL(f64, max,  double, float64x2_t, 2, vld1q_f64, vst1q_f64,
+            NEON_MAX_F64, DO_OP_MAX_2)
+NEON_KERNEL(i32, sum,  int32_t, int32x4_t, 4, vld1q_s32, vst1q_s32,
+            vaddq_s32, DO_OP_SUM_2)
+NEON_KERNEL(i32, prod, int32_t, int32x4_t, 4, vld1q_s32, vst1q_s32,
+            vmulq_s32, DO_OP_PROD_2)
+NEON_KERNEL(i32, min,  int32_t, int32x4_t, 4, vld1q_s32, vst1q_s32,
+            vminq_s32, DO_OP_MIN_2)
+NEON_KERNEL(i32, max,  int32_t, int32x4_t, 4, vld1q_s32, vst1q_s32,
+            vmaxq_s32, DO_OP_MAX_2)
+NEON_KERNEL(i64, sum,  int64_t, int64x2_t, 2, vld1q_s64, vst1q_s64,
+            vaddq_s64, DO_OP_SUM_2)
+NEON_KERNEL(i64, min,  int64_t, int64x2_t, 2, vld1q_s64, vst1q_s64,
+            NEON_MIN_S64, DO_OP_MIN_2)
+NEON_KERNEL(i64, max,  int64_t, int64x2_t, 2, vld1q_s64, vst1q_s64,
+            NEON_MAX_S64, DO_OP_MAX_2)
+
+static const ucc_ec_cpu_reduce_kernels_t ucc_ec_cpu_reduce_kernels_neon = {
+    [UCC_EC_CPU_SIMD_DT_FLOAT32] = {ucc_ec_cpu_reduce_neon_f32_sum,
+                                    ucc_ec_cpu_reduce_neon_f32_prod,
+                                    ucc_ec_cpu_reduce_neon_f32_min,
+                                    ucc_ec_cpu_reduce_neon_f32_max},
+    [UCC_EC_CPU_SIMD_DT_FLOAT64] = {ucc_ec_cpu_reduce_neon_f64_sum,
+                                    ucc_ec_cpu_reduce_neon_f64_prod,
+                                    ucc_ec_cpu_reduce_neon_f64_min,
+                                    ucc_ec_cpu_reduce_neon_f64_max},
+    [UCC_EC_CPU_SIMD_DT_INT32]   = {ucc_ec_cpu_reduce_neon_i32_sum,
+                                    ucc_ec_cpu_reduce_neon_i32_prod,
+                                    ucc_ec_cpu_reduce_neon_i32_min,
+                                    ucc_ec_cpu_reduce_neon_i32_max},
+    [UCC_EC_CPU_SIMD_DT_INT64]   = {ucc_ec_cpu_reduce_neon_i64_sum,
+                                    NULL,
+                                    ucc_ec_cpu_reduce_neon_i64_min,
+                                    ucc_ec_cpu_reduce_neon_i64_max}};
+
+#define NEON_LOAD_BF16(_p)                                                     \
+    vreinterpretq_f32_u32(vshll_n_u16(vld1_u16(_p), 16))
+#define NEON_STORE_BF16(_p, _v)                                                \
+    vst1_u16(_p, vshrn_n_u32(vreinterpretq_u32_f32(_v), 16))
+#define NEON_LOAD_F16(_p)                                                      \
+    vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(_p)))
+#define NEON_STORE_F16(_p, _v)                                                 \
+    vst1_u16(_p, vreinterpret_u16_f16(vcvt_f16_f32(_v)))
+
+#define NEON_HALF_KERNEL(_dt, _op, _load, _store, _vop, _sop, _to, _from)      \
+    UCC_EC_CPU_REDUCE_HALF_KERNEL(neon, _dt, _op, , float32x4_t, 4, _load,     \
+                                  _store, _vop, vmulq_f32, vdupq_n_f32, _sop,  \
+                                  _to, _from)
+#define NEON_HALF_KERNELS(_dt, _load, _store, _to, _from)                      \
+    NEON_HALF_KERNEL(_dt, sum, _load, _store, vaddq_f32, DO_OP_SUM_2, _to,     \
+                     _from)                                                    \
+    NEON_HALF_KERNEL(_dt, prod, _load, _store, vmulq_f32, DO_OP_PROD_2, _to,   \
+                     _from)                                                    \
+    NEON_HALF_KERNEL(_dt, min, _load, _store, NEON_MIN_F32, DO_OP_MIN_2, _to,  \
+                     _from)                                                    \
+    NEON_HALF_KERNEL(_dt, max, _load, _store, NEON_MAX_F32, DO_OP_MAX_2, _to,  \
+                     _from)
+
+NEON_HALF_KERNELS(bf16, NEON_LOAD_BF16, NEON_STORE_BF16, bfloat16tofloat32,
+                  float32tobfloat16)
+NEON_HALF_KERNELS(f16, NEON_LOAD_F16, NEON_STORE_F16, float16tofloat32,
+                  float32tofloat16)
+
+/* also used with SVE, conversions are a small part of the work */
+static const ucc_ec_cpu_reduce_half_kernels_t
+    ucc_ec_cpu_reduce_half_kernels_neon = UCC_EC_CPU_REDUCE_HALF_TABLE(neon);
+
+#ifdef __ARM_FEATURE_SVE
+/* vector length agnostic loop, the tail is handled by the predicate */
+#define SVE_KERNEL(_dt, _op, _type, _vtype, _cnt, _whilelt, _vop)              \
+    static void UCC_EC_CPU_REDUCE_KERNEL_NAME(sve, _dt, _op)(                  \
+        void *dst, void *const *srcs, size_t count, uint32_t n_srcs)           \
+    {                                                                          \
+        const _type **s = (const _type **)srcs;                                \
+        _type        *d = (_type *)dst;                                        \
+        uint64_t      i;                                                       \
+        uint32_t      j;                                                       \
+        svbool_t      pg;                                                      \
+        _vtype        acc, v;                                                  \
+                                                                               \
+        for (i = 0; i < count; i += _cnt()) {                                  \
+            pg  = _whilelt(i, (uint64_t)count);                                \
+            acc = svld1(pg, s[0] + i);                                         \
+            for (j = 1; j < n_srcs; j++) {                                     \
+                v   = svld1(pg, s[j] + i);                                     \
+                acc = _vop(pg, acc, v);                                        \
+            }                                                                  \
+            svst1(pg, d + i, acc);                                             \
+        }                                                                      \
+    }
+
+#define SVE_MIN_FP(_pg, _a, _b) svsel(svcmplt(_pg, _a, _b), _a, _b)
+#define SVE_MAX_FP(_pg, _a, _b) svsel(svcmpgt(_pg, _a, _b), _a, _b)
+
+SVE_KERNEL(f32, sum,  float, svfloat32_t, svcntw, svwhilelt_b32, svadd_x)
+SVE_KERNEL(f32, prod, float, svfloat32_t, svcntw, svwhilelt_b32, svmul_x)
+SVE_KERNEL(f32, min,  float, svfloat32_t, svcntw, svwhilelt_b32, SVE_MIN_FP)
+SVE_KERNEL(f32, max,  float, svfloat32_t, svcntw, svwhilelt_b32, SVE_MAX_FP)
+SVE_KERNEL(f64, sum,  double, svfloat64_t, svcntd, svwhilelt_b64, svadd_x)
+SVE_KERNEL(f64, prod, double, svfloat64_t, svcntd, svwhilelt_b64, svmul_x)
+SVE_KERNEL(f64, min,  double, svfloat64_t, svcntd, svwhilelt_b64, SVE_MIN_FP)
+SVE_KERNEL(f64, max,  double, svfloat64_t, svcntd, svwhilelt_b64, SVE_MAX_FP)
+SVE_KERNEL(i32, sum,  int32_t, svint32_t, svcntw, svwhilelt_b32, svadd_x)
+SVE_KERNEL(i32, prod, int32_t, svint32_t, svcntw, svwhilelt_b32, svmul_x)
+SVE_KERNEL(i32, min,  int32_t, svint32_t, svcntw, svwhilelt_b32, svmin_x)
+SVE_KERNEL(i32, max,  int32_t, svint32_t, svcntw, svwhilelt_b32, svmax_x)
+SVE_KERNEL(i64, sum,  int64_t, svint64_t, svcntd, svwhilelt_b64, svadd_x)
+SVE_KERNEL(i64, prod, int64_t, svint64_t, svcntd, svwhilelt_b64, svmul_x)
+SVE_KERNEL(i64, min,  int64_t, svint64_t, svcntd, svwhilelt_b64, svmin_x)
+SVE_KERNEL(i64, max,  int64_t, svint64_t, svcntd, svwhilelt_b64, svmax_x)
+
+static const ucc_ec_cpu_reduce_kernels_t ucc_ec_cpu_reduce_kernels_sve = {
+    [UCC_EC_CPU_SIMD_DT_FLOAT32] = {ucc_ec_cpu_reduce_sve_f32_sum,
+                                    ucc_ec_cpu_reduce_sve_f32_prod,
+                                    ucc_ec_cpu_reduce_sve_f32_min,
+                                    ucc_ec_cpu_reduce_sve_f32_max},
+    [UCC_EC_CPU_SIMD_DT_FLOAT64] = {ucc_ec_cpu_reduce_sve_f64_sum,
+                                    ucc_ec_cpu_reduce_sve_f64_prod,
+                                    ucc_ec_cpu_reduce_sve_f64_min,
+                                    ucc_ec_cpu_reduce_sve_f64_max},
+    [UCC_EC_CPU_SIMD_DT_INT32]   = {ucc_ec_cpu_reduce_sve_i32_sum,
+                                    ucc_ec_cpu_reduce_sve_i32_prod,
+                                    ucc_ec_cpu_reduce_sve_i32_min,
+                                    ucc_ec_cpu_reduce_sve_i32_max},
+    [UCC_EC_CPU_SIMD_DT_INT64]   = {ucc_ec_cpu_reduce_sve_i64_sum,
+                                    ucc_ec_cpu_reduce_sve_i64_prod,
+                                    ucc_ec_cpu_reduce_sve_i64_min,
+                                    ucc_ec_cpu_reduce_sve_i64_max}};
+#endif
+
+#endif
+
+static const ucc_ec_cpu_reduce_kernels_t *
+ucc_ec_cpu_reduce_simd_kernels(ucc_ec_cpu_reduce_simd_t isa)
+{
+    switch (isa) {
+#if defined(__x86_64__)
+    case UCC_EC_CPU_REDUCE_SIMD_AVX2:
+        return &ucc_ec_cpu_reduce_kernels_avx2;
+    case UCC_EC_CPU_REDUCE_SIMD_AVX512:
+        return &ucc_ec_cpu_reduce_kernels_avx512;
+#elif defined(__aarch64__)
+    case UCC_EC_CPU_REDUCE_SIMD_NEON:
+        return &ucc_ec_cpu_reduce_kernels_neon;
+#ifdef __ARM_FEATURE_SVE
+    case UCC_EC_CPU_REDUCE_SIMD_SVE:
+        return &ucc_ec_cpu_reduce_kernels_sve;
+#endif
+#endif
+    default:
+        return NULL;
+    }
+}
+
+static const ucc_ec_cpu_reduce_half_kernels_t *
+ucc_ec_cpu_reduce_simd_half_kernels(ucc_ec_cpu_reduce_simd_t isa)
+{
+    switch (isa) {
+#if defined(__x86_64__)
+    case UCC_EC_CPU_REDUCE_SIMD_AVX2:
+        return &ucc_ec_cpu_reduce_half_kernels_avx2;
+    case UCC_EC_CPU_REDUCE_SIMD_AVX512:
+        return &ucc_ec_cpu_reduce_half_kernels_avx512;
+#elif defined(__aarch64__)
+    case UCC_EC_CPU_REDUCE_SIMD_NEON:
+    case UCC_EC_CPU_REDUCE_SIMD_SVE:
+        return &ucc_ec_cpu_reduce_half_kernels_neon;
+#endif
+    default:
+        return NULL;
+    }
+}
+
+static int ucc_ec_cpu_reduce_simd_supported(ucc_ec_cpu_reduce_simd_t isa,
+                                            int cpu_flags)
+{
+    switch (isa) {
+    case UCC_EC_CPU_REDUCE_SIMD_AVX2:
+        return (cpu_flags & UCC_CPU_FLAG_AVX2) &&
+               (cpu_flags & UCC_CPU_FLAG_F16C);
+    case UCC_EC_CPU_REDUCE_SIMD_AVX512:
+        return !!(cpu_flags & UCC_CPU_FLAG_AVX512F);
+    case UCC_EC_CPU_REDUCE_SIMD_NEON:
+        return !!(cpu_flags & UCC_CPU_FLAG_NEON);
+    case UCC_EC_CPU_REDUCE_SIMD_SVE:
+        return !!(cpu_flags & UCC_CPU_FLAG_SVE);
+    default:
+        return 0;
+    }
+}
+
+void ucc_ec_cpu_reduce_simd_init(ucc_ec_cpu_reduce_simd_t isa)
+{
+    /* preferred first */
+    static const ucc_ec_cpu_reduce_simd_t auto_order[] = {
+        UCC_EC_CPU_REDUCE_SIMD_AVX512, UCC_EC_CPU_REDUCE_SIMD_AVX2,
+        UCC_EC_CPU_REDUCE_SIMD_SVE, UCC_EC_CPU_REDUCE_SIMD_NEON};
+    int cpu_flags = ucc_arch_get_cpu_flag();
+    int i;
+
+    ucc_ec_cpu_reduce_kernels      = NULL;
+    ucc_ec_cpu_reduce_half_kernels = NULL;
+    if (isa == UCC_EC_CPU_REDUCE_SIMD_AUTO) {
+        for (i = 0; i < sizeof(auto_order) / sizeof(auto_order[0]); i++) {
+            if (ucc_ec_cpu_reduce_simd_supported(auto_order[i], cpu_flags) &&
+                ucc_ec_cpu_reduce_simd_kernels(auto_order[i])) {
+                isa = auto_order[i];
+                break;
+            }
+        }
+    } else if (isa != UCC_EC_CPU_REDUCE_SIMD_NONE &&
+               (!ucc_ec_cpu_reduce_simd_supported(isa, cpu_flags) ||
+                !ucc_ec_cpu_reduce_simd_kernels(isa))) {
+        ec_warn(&ucc_ec_cpu.super,
+                "%s reduction kernels are not supported by the cpu or the "
+                "build, using scalar reductions",
+                ucc_ec_cpu_reduce_simd_names[isa]);
+        isa = UCC_EC_CPU_REDUCE_SIMD_NONE;
+    }
+
+    ucc_ec_cpu_reduce_kernels      = ucc_ec_cpu_reduce_simd_kernels(isa);
+    ucc_ec_cpu_reduce_half_kernels = ucc_ec_cpu_reduce_simd_half_kernels(isa);
+    ec_debug(&ucc_ec_cpu.super, "using %s reduction kernels",
+             ucc_ec_cpu_reduce_kernels ? ucc_ec_cpu_reduce_simd_names[isa]
+                                       : "scalar");
+}
+
+static inline int ucc_ec_cpu_reduce_simd_op_idx(ucc_reduction_op_t op)
+{
+    switch (op) {
+    case UCC_OP_SUM:
+    case UCC_OP_AVG:
+        return UCC_EC_CPU_SIMD_OP_SUM;
+    case UCC_OP_PROD:
+        return UCC_EC_CPU_SIMD_OP_PROD;
+    case UCC_OP_MIN:
+        return UCC_EC_CPU_SIMD_OP_MIN;
+    case UCC_OP_MAX:
+        return UCC_EC_CPU_SIMD_OP_MAX;
+    default:
+        return -1;
+    }
+}
+
+ucc_ec_cpu_reduce_kernel_t
+ucc_ec_cpu_reduce_simd_kernel(ucc_datatype_t dt, ucc_reduction_op_t op)
+{
+    int dt_idx, op_idx;
+
+    if (!ucc_ec_cpu_reduce_kernels) {
+        return NULL;
+    }
+
+    switch (dt) {
+    case UCC_DT_FLOAT32:
+        dt_idx = UCC_EC_CPU_SIMD_DT_FLOAT32;
+        break;
+    case UCC_DT_FLOAT64:
+        dt_idx = UCC_EC_CPU_SIMD_DT_FLOAT64;
+        break;
+    case UCC_DT_INT32:
+        dt_idx = UCC_EC_CPU_SIMD_DT_INT32;
+        break;
+    case UCC_DT_INT64:
+        dt_idx = UCC_EC_CPU_SIMD_DT_INT64;
+        break;
+    default:
+        return NULL;
+    }
+
+    op_idx = ucc_ec_cpu_reduce_simd_op_idx(op);
+    if (op_idx < 0) {
+        return NULL;
+    }
+
+    return (*ucc_ec_cpu_reduce_kernels)[dt_idx][op_idx];
+}
+
+ucc_ec_cpu_reduce_half_kernel_t
+ucc_ec_cpu_reduce_simd_half_kernel(ucc_datatype_t dt, ucc_reduction_op_t op)
+{
+    int dt_idx, op_idx;
+
+    if (!ucc_ec_cpu_reduce_half_kernels) {
+        return NULL;
+    }
+
+    switch (dt) {
+    case UCC_DT_BFLOAT16:
+        dt_idx = UCC_EC_CPU_SIMD_HALF_DT_BFLOAT16;
+        break;
+    case UCC_DT_FLOAT16:
+        dt_idx = UCC_EC_CPU_SIMD_HALF_DT_FLOAT16;
+        break;
+    default:
+        return NULL;
+    }
+
+    op_idx = ucc_ec_cpu_reduce_simd_op_idx(op);
+    if (op_idx < 0) {
+        return NULL;
+    }
+
+    return (*ucc_ec_cpu_reduce_half_kernels)[dt_idx][op_idx];
+}
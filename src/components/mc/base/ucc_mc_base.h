@@ -74,6 +74,8 @@ typedef enum ucc_mc_attr_field {
     UCC_MC_ATTR_FIELD_THREAD_MODE      = UCC_BIT(0),
  /* size of memory pool chunk element */
     UCC_MC_ATTR_FIELD_FAST_ALLOC_SIZE  = UCC_BIT(1),
+ /* copies of this size and larger use non-temporal stores */
+    UCC_MC_ATTR_FIELD_MEMCPY_NT_THRESH = UCC_BIT(2),
 }  ucc_mc_attr_field_t;
 
 typedef struct ucc_mc_attr {
@@ -84,6 +86,7 @@ typedef struct ucc_mc_attr {
     uint64_t          field_mask;
     ucc_thread_mode_t thread_mode;
     size_t            fast_alloc_size;
+    size_t            memcpy_nt_thresh;
 } ucc_mc_attr_t;
 
 /**
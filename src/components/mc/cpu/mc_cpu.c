@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2020-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2020-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  *
  * See file LICENSE for terms.
  */
@@ -7,8 +7,12 @@
 #include "mc_cpu.h"
 #include "utils/ucc_malloc.h"
 #include "utils/ucc_math.h"
+#include "utils/ucc_sys.h"
+#include "utils/ucc_proc_info.h"
 #include "utils/arch/cpu.h"
 #include <sys/types.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
 
 static ucc_config_field_t ucc_mc_cpu_config_table[] = {
     {"", "", NULL, ucc_offsetof(ucc_mc_cpu_config_t, super),
@@ -21,6 +25,27 @@ static ucc_config_field_t ucc_mc_cpu_config_table[] = {
     {"MPOOL_MAX_ELEMS", "8", "The max amount of elements in mc cpu mpool",
      ucc_offsetof(ucc_mc_cpu_config_t, mpool_max_elems), UCC_CONFIG_TYPE_UINT},
 
+    {"MPOOL_LARGE_MAX_SIZE", "0",
+     "Buffers larger than MPOOL_ELEM_SIZE and up to this size are taken from "
+     "hugepage backed pools of power of two size classes, one set of pools "
+     "per numa node. Memory of the pools stays pinned until the component "
+     "is finalized. 0 - disable",
+     ucc_offsetof(ucc_mc_cpu_config_t, mpool_large_max_size),
+     UCC_CONFIG_TYPE_MEMUNITS},
+
+    {"MPOOL_LARGE_MAX_ELEMS", "2",
+     "The max amount of elements in each size class pool of a numa node",
+     ucc_offsetof(ucc_mc_cpu_config_t, mpool_large_max_elems),
+     UCC_CONFIG_TYPE_UINT},
+
+    {"MEMCPY_NT_THRESH", "16Mb",
+     "Host copies of this size and larger use non-temporal stores that do "
+     "not evict the rest of the data from the cache. When the copy is split "
+     "across executor worker threads the threshold applies to the whole "
+     "copy. inf - disable",
+     ucc_offsetof(ucc_mc_cpu_config_t, memcpy_nt_thresh),
+     UCC_CONFIG_TYPE_MEMUNITS},
+
     {NULL}
 
 };
@@ -42,6 +67,9 @@ static ucc_status_t ucc_mc_cpu_get_attr(ucc_mc_attr_t *mc_attr)
     if (mc_attr->field_mask & UCC_MC_ATTR_FIELD_THREAD_MODE) {
         mc_attr->thread_mode = ucc_mc_cpu.thread_mode;
     }
+    if (mc_attr->field_mask & UCC_MC_ATTR_FIELD_MEMCPY_NT_THRESH) {
+        mc_attr->memcpy_nt_thresh = MC_CPU_CONFIG->memcpy_nt_thresh;
+    }
     return UCC_OK;
 }
 
@@ -65,6 +93,87 @@ static ucc_status_t ucc_mc_cpu_mem_alloc(ucc_mc_buffer_header_t **h_ptr,
     return UCC_OK;
 }
 
+/* ceil(log2(size)) */
+static inline unsigned ucc_mc_cpu_log2_ceil(size_t size)
+{
+    return (size <= 1) ? 0 : ucc_ilog2(size - 1) + 1;
+}
+
+/* numa node of the thread, -1 if it is out of the supported range */
+static inline int ucc_mc_cpu_numa_node()
+{
+    static __thread int node = -1;
+    unsigned            cpu, n;
+
+    if (ucc_local_proc.numa_id != UCC_NUMA_ID_INVALID) {
+        return (ucc_local_proc.numa_id < UCC_MC_CPU_MAX_NUMA_NODES) ?
+               ucc_local_proc.numa_id : -1;
+    }
+    if (node < 0) {
+        /* not bound to a numa node, use the one the thread first runs on */
+        node = syscall(SYS_getcpu, &cpu, &n, NULL) ? 0 : (int)n;
+    }
+    return (node < UCC_MC_CPU_MAX_NUMA_NODES) ? node : -1;
+}
+
+static ucc_mpool_ops_t ucc_mc_large_ops;
+
+static ucc_status_t ucc_mc_cpu_large_mpool_init(ucc_mc_cpu_large_mpool_t *lmp,
+                                                unsigned                  log)
+{
+    ucc_status_t status = UCC_OK;
+
+    ucc_spin_lock(&ucc_mc_cpu.mpool_init_spinlock);
+    if (!lmp->init_flag) {
+        /* buffer header and mpool/hugetlb bookkeeping fit in the reserve,
+           so that the chunk of 2^log bytes is not rounded up to one more
+           hugepage */
+        lmp->size = ((size_t)1 << log) - UCC_MC_CPU_LARGE_ELEM_RESERVE;
+        status    = ucc_mpool_init(
+            &lmp->mpool, 0, sizeof(ucc_mc_buffer_header_t) + lmp->size, 0,
+            UCC_CACHE_LINE_SIZE, 1, MC_CPU_CONFIG->mpool_large_max_elems,
+            &ucc_mc_large_ops, ucc_mc_cpu.thread_mode,
+            "mc cpu large mpool buffers");
+        if (ucc_likely(status == UCC_OK)) {
+            ucc_memory_cpu_store_fence();
+            lmp->init_flag = 1;
+        }
+    }
+    ucc_spin_unlock(&ucc_mc_cpu.mpool_init_spinlock);
+    return status;
+}
+
+/* every numa node has its own size class pools, a pool grows from a thread
+   of its node so the memory gets first touched there */
+static ucc_mc_buffer_header_t *ucc_mc_cpu_large_mpool_get(size_t size)
+{
+    unsigned                  log;
+    unsigned                  cls;
+    int                       node;
+    ucc_mc_cpu_large_mpool_t *lmp;
+
+    if (size > MC_CPU_CONFIG->mpool_large_max_size ||
+        MC_CPU_CONFIG->mpool_large_max_elems <= 0) {
+        return NULL;
+    }
+    log = ucc_mc_cpu_log2_ceil(size + UCC_MC_CPU_LARGE_ELEM_RESERVE);
+    if (log < ucc_mc_cpu.large_min_log) {
+        return NULL;
+    }
+    cls  = log - ucc_mc_cpu.large_min_log;
+    node = ucc_mc_cpu_numa_node();
+    if (cls >= UCC_MC_CPU_MAX_SIZE_CLASSES || node < 0) {
+        return NULL;
+    }
+    lmp = &ucc_mc_cpu.large_mpool[node][cls];
+    if (ucc_unlikely(!lmp->init_flag)) {
+        if (UCC_OK != ucc_mc_cpu_large_mpool_init(lmp, log)) {
+            return NULL;
+        }
+    }
+    return (ucc_mc_buffer_header_t *)ucc_mpool_get(&lmp->mpool);
+}
+
 static ucc_status_t ucc_mc_cpu_mem_pool_alloc(ucc_mc_buffer_header_t **h_ptr,
                                               size_t                   size,
                                               ucc_memory_type_t        mt)
@@ -72,6 +181,8 @@ static ucc_status_t ucc_mc_cpu_mem_pool_alloc(ucc_mc_buffer_header_t **h_ptr,
     ucc_mc_buffer_header_t *h = NULL;
     if (size <= MC_CPU_CONFIG->mpool_elem_size) {
         h = (ucc_mc_buffer_header_t *)ucc_mpool_get(&ucc_mc_cpu.mpool);
+    } else {
+        h = ucc_mc_cpu_large_mpool_get(size);
     }
     if (!h) {
         // Slow path
@@ -113,6 +224,56 @@ static ucc_mpool_ops_t ucc_mc_ops = {.chunk_alloc   = ucc_mc_cpu_chunk_alloc,
                                      .obj_init      = ucc_mc_cpu_chunk_init,
                                      .obj_cleanup   = NULL};
 
+static ucc_status_t ucc_mc_cpu_large_chunk_alloc(ucc_mpool_t *mp,
+                                                 size_t *size_p,
+                                                 void **chunk_p)
+{
+    ucc_status_t status;
+#ifdef MADV_HUGEPAGE
+    size_t       page = ucc_get_page_size();
+    void        *start;
+#endif
+
+    status = ucc_mpool_hugetlb_malloc(mp, size_p, chunk_p);
+    if (ucc_unlikely(status != UCC_OK)) {
+        mc_error(&ucc_mc_cpu.super, "failed to allocate %zd bytes", *size_p);
+        return status;
+    }
+    /* hugetlb is not available: let THP back the malloc fallback, fails
+       harmlessly for hugetlb chunks */
+#ifdef MADV_HUGEPAGE
+    start = (void *)ucc_align_up_pow2((uintptr_t)*chunk_p, page);
+    if (*size_p > 2 * page) {
+        madvise(start, ucc_align_down_pow2(*size_p - page, page),
+                MADV_HUGEPAGE);
+    }
+#endif
+    return UCC_OK;
+}
+
+static void ucc_mc_cpu_large_chunk_init(ucc_mpool_t *mp, void *obj,
+                                        void *chunk)
+{
+    ucc_mc_cpu_large_mpool_t *lmp =
+        ucc_derived_of(mp, ucc_mc_cpu_large_mpool_t);
+    ucc_mc_buffer_header_t   *h    = (ucc_mc_buffer_header_t *)obj;
+    size_t                    page = ucc_get_page_size();
+    size_t                    i;
+
+    ucc_mc_cpu_chunk_init(mp, obj, chunk);
+    /* first touch on the numa node of the allocating thread, so that
+       collectives do not take page faults later */
+    for (i = 0; i < lmp->size; i += page) {
+        ((volatile char *)h->addr)[i] = 0;
+    }
+}
+
+static ucc_mpool_ops_t ucc_mc_large_ops = {
+    .chunk_alloc   = ucc_mc_cpu_large_chunk_alloc,
+    .chunk_release = ucc_mpool_hugetlb_free,
+    .obj_init      = ucc_mc_cpu_large_chunk_init,
+    .obj_cleanup   = NULL};
+
 static ucc_status_t ucc_mc_cpu_mem_free(ucc_mc_buffer_header_t *h_ptr)
 {
     ucc_free(h_ptr);
@@ -154,6 +315,8 @@ ucc_mc_cpu_mem_pool_alloc_with_init(ucc_mc_buffer_header_t **h_ptr,
             ucc_spin_unlock(&ucc_mc_cpu.mpool_init_spinlock);
             return status;
         }
+        ucc_mc_cpu.large_min_log = ucc_mc_cpu_log2_ceil(
+            MC_CPU_CONFIG->mpool_elem_size + 1 + UCC_MC_CPU_LARGE_ELEM_RESERVE);
         ucc_mc_cpu.super.ops.mem_alloc = ucc_mc_cpu_mem_pool_alloc;
         ucc_mc_cpu.mpool_init_flag     = 1;
     }
@@ -167,7 +330,11 @@ static ucc_status_t ucc_mc_cpu_memcpy(void *dst, const void *src, size_t len,
 {
     ucc_assert((dst_mem == UCC_MEMORY_TYPE_HOST) &&
                (src_mem == UCC_MEMORY_TYPE_HOST));
-    memcpy(dst, src, len);
+    if (len >= MC_CPU_CONFIG->memcpy_nt_thresh) {
+        ucc_arch_memcpy_nt(dst, src, len);
+    } else {
+        memcpy(dst, src, len);
+    }
     return UCC_OK;
 }
 
@@ -188,6 +355,18 @@ static ucc_status_t ucc_mc_cpu_mem_query(const void *ptr, //NOLINT
 
 static ucc_status_t ucc_mc_cpu_finalize()
 {
+    ucc_mc_cpu_large_mpool_t *lmp;
+    int                       i, j;
+
+    for (i = 0; i < UCC_MC_CPU_MAX_NUMA_NODES; i++) {
+        for (j = 0; j < UCC_MC_CPU_MAX_SIZE_CLASSES; j++) {
+            lmp = &ucc_mc_cpu.large_mpool[i][j];
+            if (lmp->init_flag) {
+                ucc_mpool_cleanup(&lmp->mpool, 1);
+                lmp->init_flag = 0;
+            }
+        }
+    }
     if (ucc_mc_cpu.mpool_init_flag) {
         ucc_mpool_cleanup(&ucc_mc_cpu.mpool, 1);
         ucc_mc_cpu.mpool_init_flag     = 0;
@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2020-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2020-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  *
  * See file LICENSE for terms.
  */
@@ -10,18 +10,36 @@
 #include "components/mc/base/ucc_mc_base.h"
 #include "components/mc/ucc_mc_log.h"
 
+#define UCC_MC_CPU_MAX_NUMA_NODES   8
+#define UCC_MC_CPU_MAX_SIZE_CLASSES 16
+/* part of a large size class element not available to the user */
+#define UCC_MC_CPU_LARGE_ELEM_RESERVE (4 * UCC_CACHE_LINE_SIZE)
+
 typedef struct ucc_mc_cpu_config {
     ucc_mc_config_t super;
     size_t          mpool_elem_size;
     int             mpool_max_elems;
+    size_t          mpool_large_max_size;
+    int             mpool_large_max_elems;
+    size_t          memcpy_nt_thresh;
 } ucc_mc_cpu_config_t;
 
+/* pool of buffers of one power of two size class on one numa node */
+typedef struct ucc_mc_cpu_large_mpool {
+    ucc_mpool_t mpool;
+    size_t      size;
+    int         init_flag;
+} ucc_mc_cpu_large_mpool_t;
+
 typedef struct ucc_mc_cpu {
-    ucc_mc_base_t     super;
-    ucc_mpool_t       mpool;
-    int               mpool_init_flag;
-    ucc_spinlock_t    mpool_init_spinlock;
-    ucc_thread_mode_t thread_mode;
+    ucc_mc_base_t            super;
+    ucc_mpool_t              mpool;
+    int                      mpool_init_flag;
+    ucc_spinlock_t           mpool_init_spinlock;
+    ucc_thread_mode_t        thread_mode;
+    ucc_mc_cpu_large_mpool_t large_mpool[UCC_MC_CPU_MAX_NUMA_NODES]
+                                        [UCC_MC_CPU_MAX_SIZE_CLASSES];
+    unsigned                 large_min_log;
 } ucc_mc_cpu_t;
 
 extern ucc_mc_cpu_t ucc_mc_cpu;
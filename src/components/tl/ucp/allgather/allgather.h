@@ -14,6 +14,7 @@ enum {
     UCC_TL_UCP_ALLGATHER_ALG_NEIGHBOR,
     UCC_TL_UCP_ALLGATHER_ALG_BRUCK,
     UCC_TL_UCP_ALLGATHER_ALG_SPARBIT,
+    UCC_TL_UCP_ALLGATHER_ALG_ONESIDED,
     UCC_TL_UCP_ALLGATHER_ALG_LAST
 };
 
@@ -74,6 +75,15 @@ ucc_status_t ucc_tl_ucp_allgather_sparbit_init(ucc_base_coll_args_t *coll_args,
                                                 ucc_base_team_t      *team,
                                                 ucc_coll_task_t     **task_h);
 
+/* Onesided */
+ucc_status_t ucc_tl_ucp_allgather_onesided_init(ucc_base_coll_args_t *coll_args,
+                                                ucc_base_team_t      *team,
+                                                ucc_coll_task_t     **task_h);
+
+void ucc_tl_ucp_allgather_onesided_progress(ucc_coll_task_t *task);
+
+ucc_status_t ucc_tl_ucp_allgather_onesided_start(ucc_coll_task_t *task);
+
 /* Uses allgather_kn_radix from config */
 ucc_status_t ucc_tl_ucp_allgather_knomial_init(ucc_base_coll_args_t *coll_args,
                                                ucc_base_team_t      *team,
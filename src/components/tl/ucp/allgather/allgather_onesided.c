@@ -0,0 +1,165 @@
+/**
+ * Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "tl_ucp.h"
+#include "allgather.h"
+#include "core/ucc_progress_queue.h"
+#include "tl_ucp_sendrecv.h"
+#include "utils/ucc_math.h"
+#include "components/mc/ucc_mc.h"
+
+/* Put-based ring allgather. At step i every rank puts block (rank - i) of its
+   dst directly into the dst of the right neighbour and bumps the ring signal
+   of the team symmetric region there, the block received at step i is
+   forwarded at step i + 1. Only the left neighbour writes into the dst of a
+   rank, so on start every rank posts "ready" to the left neighbour: the user
+   handed dst over to this call and the results of the previous one are no
+   longer read. A rank waits for "ready" of the right neighbour before its
+   first put, ranks may then post the next call at different times. */
+
+#define ALLGATHER_ONESIDED_RING_SIGNAL(_team)                                  \
+    UCC_TL_UCP_SYM_SIGNAL(_team, UCC_TL_UCP_SYM_SIGNAL_ALLGATHER_ONESIDED)
+#define ALLGATHER_ONESIDED_READY_SIGNAL(_team)                                  \
+    UCC_TL_UCP_SYM_SIGNAL(_team, UCC_TL_UCP_SYM_SIGNAL_ALLGATHER_ONESIDED + 1)
+
+ucc_status_t ucc_tl_ucp_allgather_onesided_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task  = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team  = TASK_TEAM(task);
+    ucc_coll_args_t   *args  = &TASK_ARGS(task);
+    ucc_rank_t         trank = UCC_TL_TEAM_RANK(team);
+    ucc_rank_t         tsize = UCC_TL_TEAM_SIZE(team);
+    size_t             data_size =
+        (args->dst.info.count / tsize) * ucc_dt_size(args->dst.info.datatype);
+    ucc_status_t       status;
+
+    status = ucc_tl_ucp_sym_acquire(task);
+    if (ucc_unlikely(UCC_OK != status)) {
+        /* UCC_INPROGRESS: started again once the region is free */
+        return (UCC_INPROGRESS == status) ? UCC_OK : status;
+    }
+    ucc_tl_ucp_task_reset(task, UCC_INPROGRESS);
+    task->onesided.put_posted    = 0;
+    task->onesided.put_completed = 0;
+
+    if (!UCC_IS_INPLACE(*args)) {
+        status = ucc_mc_memcpy(
+            PTR_OFFSET(args->dst.info.buffer, data_size * trank),
+            args->src.info.buffer, data_size, args->dst.info.mem_type,
+            args->src.info.mem_type);
+        if (ucc_unlikely(UCC_OK != status)) {
+            return status;
+        }
+    }
+    if (tsize == 1) {
+        task->super.status = UCC_OK;
+        return ucc_task_complete(&task->super);
+    }
+
+    task->allgather_onesided.ring_base =
+        team->sym.signal_seq[UCC_TL_UCP_SYM_SIGNAL_ALLGATHER_ONESIDED];
+    task->allgather_onesided.ready_base =
+        team->sym.signal_seq[UCC_TL_UCP_SYM_SIGNAL_ALLGATHER_ONESIDED + 1];
+    team->sym.signal_seq[UCC_TL_UCP_SYM_SIGNAL_ALLGATHER_ONESIDED] += tsize - 1;
+    team->sym.signal_seq[UCC_TL_UCP_SYM_SIGNAL_ALLGATHER_ONESIDED + 1] += 1;
+    task->allgather_onesided.n_sent = 0;
+
+    status = ucc_tl_ucp_put_signal_nb(
+        NULL, NULL, 0, (void *)ALLGATHER_ONESIDED_READY_SIGNAL(team),
+        (trank - 1 + tsize) % tsize, team, task);
+    if (ucc_unlikely(UCC_OK != status)) {
+        return status;
+    }
+    return ucc_tl_ucp_sym_enqueue(task);
+}
+
+void ucc_tl_ucp_allgather_onesided_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task  = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team  = TASK_TEAM(task);
+    ucc_coll_args_t   *args  = &TASK_ARGS(task);
+    ucc_rank_t         trank = UCC_TL_TEAM_RANK(team);
+    ucc_rank_t         tsize = UCC_TL_TEAM_SIZE(team);
+    ucc_rank_t         right = (trank + 1) % tsize;
+    size_t             data_size =
+        (args->dst.info.count / tsize) * ucc_dt_size(args->dst.info.datatype);
+    volatile uint64_t *ring_signal  = ALLGATHER_ONESIDED_RING_SIGNAL(team);
+    volatile uint64_t *ready_signal = ALLGATHER_ONESIDED_READY_SIGNAL(team);
+    int                polls        = 0;
+    ucc_rank_t         step, block;
+    void              *buf;
+
+    while (1) {
+        step = task->allgather_onesided.n_sent;
+        /* block sent at step i arrived from the left neighbour at step i - 1,
+           dst of the right neighbour may be written once it is ready */
+        if (step < tsize - 1 &&
+            *ready_signal >= task->allgather_onesided.ready_base + 1 &&
+            *ring_signal >= task->allgather_onesided.ring_base + step) {
+            block = (trank - step + tsize) % tsize;
+            buf   = PTR_OFFSET(args->dst.info.buffer, block * data_size);
+            UCPCHECK_GOTO(ucc_tl_ucp_put_signal_nb(buf, buf, data_size,
+                                                   (void *)ring_signal, right,
+                                                   team, task),
+                          task, out);
+            task->allgather_onesided.n_sent++;
+            continue;
+        }
+        if (step == tsize - 1 &&
+            *ring_signal >= task->allgather_onesided.ring_base + tsize - 1 &&
+            UCC_TL_UCP_TASK_ONESIDED_P2P_COMPLETE(task)) {
+            task->super.status = UCC_OK;
+            return;
+        }
+        if (polls++ >= task->n_polls) {
+            return;
+        }
+        ucp_worker_progress(UCC_TL_UCP_TEAM_CTX(team)->worker.ucp_worker);
+    }
+out:
+    return;
+}
+
+ucc_status_t ucc_tl_ucp_allgather_onesided_init(ucc_base_coll_args_t *coll_args,
+                                                ucc_base_team_t      *team,
+                                                ucc_coll_task_t     **task_h)
+{
+    ucc_tl_ucp_team_t *tl_team = ucc_derived_of(team, ucc_tl_ucp_team_t);
+    ucc_tl_ucp_task_t *task;
+
+    if (!ucc_coll_args_is_predefined_dt(&coll_args->args, UCC_RANK_INVALID)) {
+        tl_debug(UCC_TL_TEAM_LIB(tl_team),
+                 "user defined datatype is not supported");
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    if (UCC_TL_TEAM_SIZE(tl_team) > 1) {
+        if (!UCC_TL_UCP_TEAM_HAS_SYM(tl_team)) {
+            tl_debug(UCC_TL_TEAM_LIB(tl_team),
+                     "symmetric memory is not available on team");
+            return UCC_ERR_NOT_SUPPORTED;
+        }
+        if (coll_args->args.dst.info.mem_type != UCC_MEMORY_TYPE_HOST) {
+            tl_debug(UCC_TL_TEAM_LIB(tl_team),
+                     "onesided allgather supports only host memory");
+            return UCC_ERR_NOT_SUPPORTED;
+        }
+        if (coll_args->args.mask & UCC_COLL_ARGS_FIELD_FLAGS) {
+            if (!(coll_args->args.flags &
+                  UCC_COLL_ARGS_FLAG_MEM_MAPPED_BUFFERS)) {
+                tl_debug(UCC_TL_TEAM_LIB(tl_team),
+                         "non memory mapped buffers are not supported");
+                return UCC_ERR_NOT_SUPPORTED;
+            }
+        }
+    }
+
+    task                 = ucc_tl_ucp_init_task(coll_args, team);
+    task->super.post     = ucc_tl_ucp_allgather_onesided_start;
+    task->super.progress = ucc_tl_ucp_allgather_onesided_progress;
+    *task_h              = &task->super;
+    return UCC_OK;
+}
@@ -9,324 +9,738 @@
 
 // TODO(cyx): progress调用了太多次，可以少一点
 
-#define ALLREDUCE_CYX_PHASE_IDLE    0
-#define ALLREDUCE_CYX_PHASE_PUTTING 1
-// #define ALLREDUCE_CYX_PHASE_ATOMICING 2
-// #define ALLREDUCE_CYX_PHASE_REDUCING  3
-// reduce 不应该放到 task->allreduce_cyx.phase 里。reduce_task 非空自然就是有 reduce 任务
+// team 对称内存里的信号槽位。信号只增不减，从不清零：
+// team->sym.signal_seq 记录本地已经消费了多少次到达，
+// 每次集合操作在 start 时领取自己的起始值（base），等待 base + k 即可。
+// ring 信号按 chunk 计数。左邻居的 chunk 是按 reduce 的顺序逐个 PUT 过来的，
+// 它开始下一次集合操作之前一定已经发完了本次所有的 ring 信号，
+// 所以提前到达的下一次信号不会被误认。
+// 最终结果的 PUT 来自所有 rank，但下一次的最终结果必须经过本 rank 的
+// reduce 才能产生，所以也不会提前到达。
+// allgather 走环时只有左邻居会写本 rank 的 buffer，final 信号改成反向的
+// "已经用完"通知：左邻居收到之后才能开始下一次操作
+// 双向模式下两个环各用一组槽位：环 r 用 2r 和 2r + 1，两级模式的三个阶段用环 2 到 4
+#define ALLREDUCE_CYX_SIGNAL_RING  0 // 左邻居 reduce-scatter chunk 的到达次数
+#define ALLREDUCE_CYX_SIGNAL_FINAL 1 // 其他 rank 最终结果 PUT 的到达次数
+#define ALLREDUCE_CYX_SIGNAL_SLOT(_task, _sig)                                 \
+    (2 * (_task)->allreduce_cyx.ring + (_sig))
 
-ucc_status_t ucc_tl_ucp_allreduce_cyx_init(ucc_base_coll_args_t *coll_args,
-                                           ucc_base_team_t      *team,
-                                           ucc_coll_task_t     **task_h)
+#define ALLREDUCE_CYX_N_RINGS_MAX 2
+
+// 两级模式下三个阶段各自的环编号（信号槽位），和单层的两个环错开
+#define ALLREDUCE_CYX_RING_NODE_RS 2
+#define ALLREDUCE_CYX_RING_NET     3
+#define ALLREDUCE_CYX_RING_NODE_AG 4
+
+// 一个 cyx task 做的事情：
+// ALLREDUCE: 完整的 reduce-scatter 环 + 最终结果 PUT 给所有 rank
+// RS:        只做 reduce-scatter 环，最终结果只拷贝到自己的 dst
+// AG:        没有 reduce，只把自己 dst 里负责的段 PUT 给所有 rank
+#define ALLREDUCE_CYX_MODE_ALLREDUCE 0
+#define ALLREDUCE_CYX_MODE_RS        1
+#define ALLREDUCE_CYX_MODE_AG        2
+
+// ALLREDUCE 模式的 allgather 走环：最终结果沿环转发 mpi_size - 1 步，
+// 第 mpi_size 到 2 * mpi_size - 2 步收到的段直接落在 dst 里
+#define ALLREDUCE_CYX_RING_AG(_task)                                           \
+    ((_task)->allreduce_cyx.mode == ALLREDUCE_CYX_MODE_ALLREDUCE &&            \
+     TASK_TEAM(_task)->cfg.allreduce_cyx_ring_allgather)
+
+// final 信号的个数：全连接 PUT 时每个其他 rank 一次，走环时只有右邻居的一次，
+// RS 的结果只留在本地，没有 final
+#define ALLREDUCE_CYX_N_FINAL(_task)                                           \
+    (((_task)->allreduce_cyx.mode == ALLREDUCE_CYX_MODE_RS)                    \
+         ? 0                                                                   \
+         : (ALLREDUCE_CYX_RING_AG(_task) ? 1                                   \
+                                         : (_task)->subset.map.ep_num - 1))
+
+#define ALLREDUCE_CYX_LANDING(_task, _offset)                                  \
+    PTR_OFFSET((_task)->allreduce_cyx.landing, (_offset))
+
+// 每个环负责 dst 的一部分（frag），frag 内段的划分和 reduce_scatter ring 一致：
+// 余数均摊到前面的段，count < mpi_size 时后面的段长度为 0（不搬数据也不发信号）
+// 段的偏移是相对整个 buffer 的，所以两个环的 landing 自然不重叠
+#define ALLREDUCE_CYX_BLOCK_SIZE(_task, _block)                                \
+    (ucc_buffer_block_count((_task)->allreduce_cyx.frag_count,                 \
+                            (_task)->subset.map.ep_num, (_block)) *            \
+     ucc_dt_size(TASK_ARGS(_task).dst.info.datatype))
+
+#define ALLREDUCE_CYX_BLOCK_OFFSET(_task, _block)                              \
+    ((_task)->allreduce_cyx.frag_offset +                                      \
+     ucc_buffer_block_offset((_task)->allreduce_cyx.frag_count,                \
+                             (_task)->subset.map.ep_num, (_block)) *           \
+         ucc_dt_size(TASK_ARGS(_task).dst.info.datatype))
+
+// subset 里的 rank 换算成 team 里的 rank：反向环的 subset 是倒序的
+#define ALLREDUCE_CYX_TEAM_RANK(_task, _rank)                                  \
+    ucc_ep_map_eval((_task)->subset.map, (_rank))
+
+// 第 k 步（从 1 开始）收到的段来自左邻居，ID 为 mpi_rank - k
+// 第 0 步是本 rank 自己的 src 段，第 mpi_size - 1 步 reduce 完成的段
+// （mpi_rank + 1）就是本 rank 负责的最终结果，之后 allgather 的环沿用同一个公式
+static inline ucc_rank_t ucc_tl_ucp_allreduce_cyx_block(ucc_rank_t mpi_rank,
+                                                       ucc_rank_t mpi_size,
+                                                       ucc_rank_t step)
 {
-    ucc_tl_ucp_team_t *tl_team = ucc_derived_of(team, ucc_tl_ucp_team_t);
-    ucc_tl_ucp_task_t *task;
-    ucc_status_t       status;
-    ALLREDUCE_TASK_CHECK(coll_args->args, tl_team);
-    // 要求 global_work_buffer 存在，并且在外部被置为 0！
-    if (!(coll_args->args.mask & UCC_COLL_ARGS_FIELD_GLOBAL_WORK_BUFFER)) {
-        tl_error(UCC_TL_TEAM_LIB(tl_team),
-                 "global work buffer not provided nor associated with team");
-        status = UCC_ERR_NOT_SUPPORTED;
-        goto out;
+    return (mpi_rank + 2 * mpi_size - step) % mpi_size;
+}
+
+static inline size_t ucc_tl_ucp_allreduce_cyx_n_chunks(ucc_tl_ucp_task_t *task,
+                                                       ucc_rank_t         step)
+{
+    ucc_rank_t block = ucc_tl_ucp_allreduce_cyx_block(
+        task->subset.myrank, (ucc_rank_t)task->subset.map.ep_num, step);
+
+    return ucc_div_round_up(ALLREDUCE_CYX_BLOCK_SIZE(task, block),
+                            task->allreduce_cyx.chunk_size);
+}
+
+// 每个段再切成 chunk_size 大小的 chunk，最后一个 chunk 可能更短
+static inline void ucc_tl_ucp_allreduce_cyx_chunk(ucc_tl_ucp_task_t *task,
+                                                  ucc_rank_t step, size_t chunk,
+                                                  size_t *offset, size_t *len)
+{
+    ucc_rank_t block = ucc_tl_ucp_allreduce_cyx_block(
+        task->subset.myrank, (ucc_rank_t)task->subset.map.ep_num, step);
+    size_t     shift = chunk * task->allreduce_cyx.chunk_size;
+
+    *offset = ALLREDUCE_CYX_BLOCK_OFFSET(task, block) + shift;
+    *len    = ucc_min(task->allreduce_cyx.chunk_size,
+                      ALLREDUCE_CYX_BLOCK_SIZE(task, block) - shift);
+}
+
+// 游标 (step, chunk) 跳过空段，指向下一个存在的 chunk；全部走完时 step == n_steps
+static inline void ucc_tl_ucp_allreduce_cyx_skip(ucc_tl_ucp_task_t *task,
+                                                 ucc_rank_t        *step,
+                                                 size_t            *chunk)
+{
+    while (*step < task->allreduce_cyx.n_steps &&
+           *chunk >= ucc_tl_ucp_allreduce_cyx_n_chunks(task, *step)) {
+        (*step)++;
+        *chunk = 0;
+    }
+}
+
+static inline void ucc_tl_ucp_allreduce_cyx_next(ucc_tl_ucp_task_t *task,
+                                                 ucc_rank_t        *step,
+                                                 size_t            *chunk)
+{
+    (*chunk)++;
+    ucc_tl_ucp_allreduce_cyx_skip(task, step, chunk);
+}
+
+// 多 rank 时的参数检查，单 rank 时只做本地拷贝，不需要这些
+static ucc_status_t
+ucc_tl_ucp_allreduce_cyx_check(ucc_base_coll_args_t *coll_args,
+                               ucc_tl_ucp_team_t    *tl_team)
+{
+    size_t data_size;
+
+    // 信号字和 scratch 都来自 team 创建时库分配并交换好 rkey 的对称内存
+    if (!UCC_TL_UCP_TEAM_HAS_SYM(tl_team)) {
+        tl_debug(UCC_TL_TEAM_LIB(tl_team),
+                 "symmetric scratch is not available on team");
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    if (coll_args->args.dst.info.mem_type != UCC_MEMORY_TYPE_HOST) {
+        tl_debug(UCC_TL_TEAM_LIB(tl_team),
+                 "allreduce_cyx supports only host memory");
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    // 左邻居的 chunk 总是落在 scratch 里，见 ucc_tl_ucp_allreduce_cyx_start
+    data_size = coll_args->args.dst.info.count *
+                ucc_dt_size(coll_args->args.dst.info.datatype);
+    if (data_size > UCC_TL_UCP_SYM_SCRATCH_SIZE(tl_team)) {
+        tl_debug(UCC_TL_TEAM_LIB(tl_team),
+                 "message size %zd exceeds symmetric scratch size %zd",
+                 data_size, UCC_TL_UCP_SYM_SCRATCH_SIZE(tl_team));
+        return UCC_ERR_NOT_SUPPORTED;
     }
     // 仿照我修改过后的 alltoall_oneside 检查是否已经被映射为适合单边操作的内存
     // 并不会真的检查有没有注册，只是看用户有没有意识到
+    // 只有 dst 会被远端写入（最终结果），src 只在本地读
     if (coll_args->args.mask & UCC_COLL_ARGS_FIELD_FLAGS) {
         if (!(coll_args->args.flags & UCC_COLL_ARGS_FLAG_MEM_MAPPED_BUFFERS)) {
             tl_error(UCC_TL_TEAM_LIB(tl_team),
                      "non memory mapped buffers are not supported");
-            status = UCC_ERR_NOT_SUPPORTED;
-            goto out;
+            return UCC_ERR_NOT_SUPPORTED;
         }
     }
-    // 简单起见，暂不支持 inplace 操作
-    if (UCC_IS_INPLACE(coll_args->args)) {
-        tl_error(UCC_TL_TEAM_LIB(tl_team),
-                 "inplace allreduce_cyx are not supported");
-        status = UCC_ERR_NOT_SUPPORTED;
-        goto out;
-    }
-    // 简单起见，暂不支持 persistent 操作
-    if (UCC_IS_PERSISTENT(coll_args->args)) {
-        tl_error(UCC_TL_TEAM_LIB(tl_team),
-                 "persistent allreduce_cyx are not supported");
-        status = UCC_ERR_NOT_SUPPORTED;
-        goto out;
-    }
+    // inplace 和 persistent 都支持：reduce-scatter 阶段的 PUT 落在对端
+    // scratch 里，不会覆盖还没参与 reduce 的 src；信号也不需要清零
+    return UCC_OK;
+}
+
+static ucc_status_t
+ucc_tl_ucp_allreduce_cyx_init_ring(ucc_base_coll_args_t *coll_args,
+                                   ucc_base_team_t *team, ucc_subset_t *subset,
+                                   int ring, int mode, size_t frag_offset,
+                                   size_t frag_count, ucc_tl_ucp_task_t **t)
+{
+    ucc_coll_args_t   *args = &coll_args->args;
+    ucc_tl_ucp_task_t *task;
 
     // 创建 task，设置 super（伪父类），标记 start、progress、finalize 函数
-    task    = ucc_tl_ucp_init_task(coll_args, team);
-    *task_h = &task->super;
-    task->super.flags |= UCC_COLL_TASK_FLAG_EXECUTOR;
+    task                 = ucc_tl_ucp_init_task(coll_args, team);
     task->super.post     = ucc_tl_ucp_allreduce_cyx_start;
     task->super.progress = ucc_tl_ucp_allreduce_cyx_progress;
     task->super.finalize = ucc_tl_ucp_allreduce_cyx_finalize;
+    task->subset         = *subset;
+
+    task->allreduce_cyx.ring           = ring;
+    task->allreduce_cyx.mode           = mode;
+    task->allreduce_cyx.frag_count     = frag_count;
+    task->allreduce_cyx.frag_offset    = frag_offset;
+    task->allreduce_cyx.landing_offset = 0;
+    task->allreduce_cyx.sbuf =
+        UCC_IS_INPLACE(*args) ? args->dst.info.buffer : args->src.info.buffer;
+    *t = task;
+    return UCC_OK;
+}
+
+static ucc_status_t
+ucc_tl_ucp_allreduce_cyx_sched_post(ucc_coll_task_t *coll_task)
+{
+    return ucc_schedule_start(coll_task);
+}
+
+static ucc_status_t
+ucc_tl_ucp_allreduce_cyx_sched_finalize(ucc_coll_task_t *task)
+{
+    ucc_tl_ucp_schedule_t *schedule =
+        ucc_derived_of(task, ucc_tl_ucp_schedule_t);
+    ucc_status_t status;
+
+    status = ucc_schedule_finalize(task);
+    ucc_tl_ucp_put_schedule(&schedule->super.super);
+    return status;
+}
+
+// 两级模式：节点内 reduce-scatter，同一 local rank 的跨节点环（每个 rail 一个环）
+// 对节点内负责的段做 allreduce，最后节点内 allgather。
+// 环长从 team size 降到节点数，节点内的传输走 UCX 的共享内存通道
+static int ucc_tl_ucp_allreduce_cyx_hier_enabled(ucc_base_coll_args_t *coll_args,
+                                                 ucc_tl_ucp_team_t    *tl_team)
+{
+    size_t      data_size;
+    ucc_sbgp_t *node, *net;
+
+    if (!tl_team->cfg.allreduce_cyx_hierarchical || !tl_team->topo) {
+        return 0;
+    }
+    node = ucc_topo_get_sbgp(tl_team->topo, UCC_SBGP_NODE);
+    net  = ucc_topo_get_sbgp(tl_team->topo, UCC_SBGP_NET);
+    // NET 只在跨节点且每个节点 rank 数相同时存在
+    if (node->status != UCC_SBGP_ENABLED || net->status != UCC_SBGP_ENABLED) {
+        return 0;
+    }
+    // 跨节点的环在 dst 上原地做，landing 在 scratch 里；节点内的环
+    // 用 scratch 的前一半，跨节点的环用后一半，互不干扰
+    data_size = coll_args->args.dst.info.count *
+                ucc_dt_size(coll_args->args.dst.info.datatype);
+    if (2 * data_size > UCC_TL_UCP_SYM_SCRATCH_SIZE(tl_team)) {
+        tl_debug(UCC_TL_TEAM_LIB(tl_team),
+                 "message size %zd is too large for hierarchical cyx, "
+                 "symmetric scratch size %zd",
+                 data_size, UCC_TL_UCP_SYM_SCRATCH_SIZE(tl_team));
+        return 0;
+    }
+    return 1;
+}
+
+static ucc_status_t
+ucc_tl_ucp_allreduce_cyx_hier_init(ucc_base_coll_args_t *coll_args,
+                                   ucc_base_team_t      *team,
+                                   ucc_coll_task_t     **task_h)
+{
+    ucc_tl_ucp_team_t *tl_team = ucc_derived_of(team, ucc_tl_ucp_team_t);
+    size_t             count   = coll_args->args.dst.info.count;
+    size_t             dt_size = ucc_dt_size(coll_args->args.dst.info.datatype);
+    ucc_sbgp_t        *node = ucc_topo_get_sbgp(tl_team->topo, UCC_SBGP_NODE);
+    ucc_sbgp_t        *net  = ucc_topo_get_sbgp(tl_team->topo, UCC_SBGP_NET);
+    ucc_subset_t       s_node = {.map    = node->map,
+                                 .myrank = node->group_rank};
+    ucc_subset_t       s_net  = {.map = net->map, .myrank = net->group_rank};
+    // 节点内 reduce-scatter 之后本 rank 负责的段，同一 rail 上的 rank 负责同一段
+    ucc_rank_t block = (node->group_rank + 1) % node->group_size;
+    ucc_tl_ucp_schedule_t *tl_schedule;
+    ucc_schedule_t        *schedule;
+    ucc_tl_ucp_task_t     *rs_task, *net_task, *ag_task;
+    ucc_status_t           status;
+
+    status = ucc_tl_ucp_get_schedule(tl_team, coll_args, &tl_schedule);
+    if (ucc_unlikely(UCC_OK != status)) {
+        return status;
+    }
+    schedule = &tl_schedule->super.super;
+
+    UCC_CHECK_GOTO(ucc_tl_ucp_allreduce_cyx_init_ring(
+                       coll_args, team, &s_node, ALLREDUCE_CYX_RING_NODE_RS,
+                       ALLREDUCE_CYX_MODE_RS, 0, count, &rs_task),
+                   out, status);
+    UCC_CHECK_GOTO(ucc_schedule_add_task(schedule, &rs_task->super), out,
+                   status);
+    UCC_CHECK_GOTO(ucc_task_subscribe_dep(&schedule->super, &rs_task->super,
+                                          UCC_EVENT_SCHEDULE_STARTED),
+                   out, status);
+
+    // 跨节点的环在 dst 上原地做 allreduce
+    UCC_CHECK_GOTO(ucc_tl_ucp_allreduce_cyx_init_ring(
+                       coll_args, team, &s_net, ALLREDUCE_CYX_RING_NET,
+                       ALLREDUCE_CYX_MODE_ALLREDUCE,
+                       ucc_buffer_block_offset(count, node->group_size,
+                                               block) * dt_size,
+                       ucc_buffer_block_count(count, node->group_size, block),
+                       &net_task),
+                   out, status);
+    net_task->allreduce_cyx.sbuf           = coll_args->args.dst.info.buffer;
+    net_task->allreduce_cyx.landing_offset = count * dt_size;
+    UCC_CHECK_GOTO(ucc_schedule_add_task(schedule, &net_task->super), out,
+                   status);
+    UCC_CHECK_GOTO(ucc_task_subscribe_dep(&rs_task->super, &net_task->super,
+                                          UCC_EVENT_COMPLETED),
+                   out, status);
+
+    UCC_CHECK_GOTO(ucc_tl_ucp_allreduce_cyx_init_ring(
+                       coll_args, team, &s_node, ALLREDUCE_CYX_RING_NODE_AG,
+                       ALLREDUCE_CYX_MODE_AG, 0, count, &ag_task),
+                   out, status);
+    ag_task->allreduce_cyx.sbuf = coll_args->args.dst.info.buffer;
+    UCC_CHECK_GOTO(ucc_schedule_add_task(schedule, &ag_task->super), out,
+                   status);
+    UCC_CHECK_GOTO(ucc_task_subscribe_dep(&net_task->super, &ag_task->super,
+                                          UCC_EVENT_COMPLETED),
+                   out, status);
+
+    schedule->super.flags   |= UCC_COLL_TASK_FLAG_EXECUTOR;
+    schedule->super.post     = ucc_tl_ucp_allreduce_cyx_sched_post;
+    schedule->super.finalize = ucc_tl_ucp_allreduce_cyx_sched_finalize;
+    *task_h                  = &schedule->super;
+    return UCC_OK;
 
-    status = UCC_OK;
+out:
+    ucc_schedule_finalize(&schedule->super);
+    ucc_tl_ucp_put_schedule(schedule);
+    return status;
+}
+
+ucc_status_t ucc_tl_ucp_allreduce_cyx_init(ucc_base_coll_args_t *coll_args,
+                                           ucc_base_team_t      *team,
+                                           ucc_coll_task_t     **task_h)
+{
+    ucc_tl_ucp_team_t *tl_team = ucc_derived_of(team, ucc_tl_ucp_team_t);
+    ucc_rank_t         size    = UCC_TL_TEAM_SIZE(tl_team);
+    size_t             count   = coll_args->args.dst.info.count;
+    size_t             dt_size = ucc_dt_size(coll_args->args.dst.info.datatype);
+    ucc_subset_t       s[ALLREDUCE_CYX_N_RINGS_MAX];
+    ucc_tl_ucp_schedule_t *tl_schedule;
+    ucc_schedule_t        *schedule;
+    ucc_tl_ucp_task_t     *task;
+    ucc_status_t           status;
+    int                    i, n_rings;
+
+    ALLREDUCE_TASK_CHECK(coll_args->args, tl_team);
+    if (size > 1) {
+        status = ucc_tl_ucp_allreduce_cyx_check(coll_args, tl_team);
+        if (status != UCC_OK) {
+            goto out;
+        }
+        if (ucc_tl_ucp_allreduce_cyx_hier_enabled(coll_args, tl_team)) {
+            return ucc_tl_ucp_allreduce_cyx_hier_init(coll_args, team, task_h);
+        }
+    }
+
+    // 第二个环反向，用上全双工链路的另一个方向。
+    // 两个 rank 时一个环已经用满两个方向；每个 rank 不到一个元素时也不值得拆
+    n_rings = (tl_team->cfg.allreduce_cyx_bidirectional && size > 2 &&
+               count > size) ? 2 : 1;
+    s[0].myrank     = UCC_TL_TEAM_RANK(tl_team);
+    s[0].map.type   = UCC_EP_MAP_FULL;
+    s[0].map.ep_num = size;
+    s[1].map        = ucc_ep_map_create_reverse(size);
+    s[1].myrank     = ucc_ep_map_eval(s[1].map, s[0].myrank);
+
+    if (n_rings == 1) {
+        status = ucc_tl_ucp_allreduce_cyx_init_ring(
+            coll_args, team, &s[0], 0, ALLREDUCE_CYX_MODE_ALLREDUCE, 0,
+            coll_args->args.dst.info.count, &task);
+        if (status != UCC_OK) {
+            goto out;
+        }
+        task->super.flags |= UCC_COLL_TASK_FLAG_EXECUTOR;
+        *task_h = &task->super;
+        goto out;
+    }
+
+    status = ucc_tl_ucp_get_schedule(tl_team, coll_args, &tl_schedule);
+    if (ucc_unlikely(UCC_OK != status)) {
+        goto out;
+    }
+    schedule = &tl_schedule->super.super;
+    for (i = 0; i < n_rings; i++) {
+        UCC_CHECK_GOTO(
+            ucc_tl_ucp_allreduce_cyx_init_ring(
+                coll_args, team, &s[i], i, ALLREDUCE_CYX_MODE_ALLREDUCE,
+                ucc_buffer_block_offset(count, n_rings, i) * dt_size,
+                ucc_buffer_block_count(count, n_rings, i), &task),
+            out_put, status);
+        task->super.n_deps = 1;
+        UCC_CHECK_GOTO(ucc_schedule_add_task(schedule, &task->super), out_put,
+                       status);
+        UCC_CHECK_GOTO(ucc_event_manager_subscribe(
+                           &schedule->super, UCC_EVENT_SCHEDULE_STARTED,
+                           &task->super, ucc_task_start_handler),
+                       out_put, status);
+    }
+    schedule->super.flags   |= UCC_COLL_TASK_FLAG_EXECUTOR;
+    schedule->super.post     = ucc_tl_ucp_allreduce_cyx_sched_post;
+    schedule->super.finalize = ucc_tl_ucp_allreduce_cyx_sched_finalize;
+    *task_h                  = &schedule->super;
+    return UCC_OK;
+
+out_put:
+    ucc_schedule_finalize(&schedule->super);
+    ucc_tl_ucp_put_schedule(schedule);
 out:
     return status;
 }
 
 // post 一个集合操作的会调用这个
-// 1. 主动发起一次 xsegment put
-// 2. 在 task 中标记好初始化信息
-// 3. ucc_progress_queue_enqueue
+// 1. 领取本次操作的信号起始值
+// 2. 设置 reduce 和 PUT 的游标
+// 3. ucc_tl_ucp_sym_enqueue 入队，第一个 chunk 的 PUT 在 progress 里发出
 ucc_status_t ucc_tl_ucp_allreduce_cyx_start(ucc_coll_task_t *coll_task)
 {
     ucc_tl_ucp_task_t *task     = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
     ucc_tl_ucp_team_t *team     = TASK_TEAM(task);
+    ucc_coll_args_t   *args     = &TASK_ARGS(task);
     ucc_rank_t         mpi_size = (ucc_rank_t)task->subset.map.ep_num;
-    ucc_rank_t         mpi_rank = task->subset.myrank;
-    ucc_rank_t peer_rank = (mpi_rank + 1) % mpi_size; // 始终向下个节点发送
-    ptrdiff_t      sbuf = (ptrdiff_t)TASK_ARGS(task).src.info.buffer; // src buf
-    ptrdiff_t      dbuf = (ptrdiff_t)TASK_ARGS(task).dst.info.buffer; // dst buf
-    size_t         count     = TASK_ARGS(task).dst.info.count;
-    ucc_datatype_t dt        = TASK_ARGS(task).dst.info.datatype;
-    size_t         data_size = count * ucc_dt_size(dt);
-    size_t xsegment_size = data_size / mpi_size; // 每次交换（PUT）的长度
-
-    ucc_status_t status;
+    size_t             dt_size  = ucc_dt_size(args->dst.info.datatype);
+    int                mode     = task->allreduce_cyx.mode;
+    uint64_t           n_ring   = 0;
+    ucc_status_t       status;
+    ucc_rank_t         step;
+    int                ring_slot, final_slot;
 
-    if (count % mpi_size || mpi_size < 2) {
-        tl_error(UCC_TL_TEAM_LIB(team),
-                 "allreduce_cyx count %lu is not multiple of mpi_size %d or "
-                 "mpi_size < 2",
-                 count, mpi_size);
-        return UCC_ERR_NOT_SUPPORTED;
+    // 信号和 scratch 整个 team 共用，同一时间只能有一个单边集合操作
+    status = ucc_tl_ucp_sym_acquire(task);
+    if (ucc_unlikely(UCC_OK != status)) {
+        /* UCC_INPROGRESS: started again once the region is free */
+        return (UCC_INPROGRESS == status) ? UCC_OK : status;
     }
-
     // 初始化 task 状态
     ucc_tl_ucp_task_reset(task, UCC_INPROGRESS);
+
+    // 只有一个 rank：结果就是自己的 src
+    if (mpi_size == 1) {
+        if (task->allreduce_cyx.sbuf != args->dst.info.buffer) {
+            status = ucc_mc_memcpy(
+                PTR_OFFSET(args->dst.info.buffer,
+                           task->allreduce_cyx.frag_offset),
+                PTR_OFFSET(task->allreduce_cyx.sbuf,
+                           task->allreduce_cyx.frag_offset),
+                task->allreduce_cyx.frag_count * dt_size,
+                args->dst.info.mem_type, args->src.info.mem_type);
+            if (ucc_unlikely(status != UCC_OK)) {
+                return status;
+            }
+        }
+        task->super.status = UCC_OK;
+        return ucc_task_complete(&task->super);
+    }
+
     // 这个在 ucc_tl_ucp_put_nb 中就会被修改，所以需要现在就设置
     task->onesided.put_posted    = 0;
     task->onesided.put_completed = 0;
 
-    // PUT 的描述从 1 开始，也就是没有第 0 次 PUT
-    // 第 1 次 PUT（PUT 完接收端 pSync[0] == 1）：从 src 到 dst
-    // 第 [2, mpi_size-1] 次 PUT：从 scratch 到 dst
-    // 第 [mpi_size, 2*mpi_size-2]次 PUT：从 dst 到 dst
-    ptrdiff_t put_src_by_src = sbuf + xsegment_size * mpi_rank;
-    ptrdiff_t put_dst_by_dst = dbuf + xsegment_size * mpi_rank;
-
     // 获得 reduce 任务的执行器
     status =
         ucc_coll_task_get_executor(&task->super, &task->allreduce_cyx.executor);
     if (status != UCC_OK) {
         tl_error(UCC_TL_TEAM_LIB(team), "ucc_coll_task_get_executor failed!");
-        goto out;
+        return status;
     }
 
-    // 进行第一次 PUT
-    status = ucc_tl_ucp_put_nb((void *)put_dst_by_dst, (void *)put_src_by_src,
-                               xsegment_size, peer_rank, team, task);
-    if (status != UCC_OK) {
-        tl_error(UCC_TL_TEAM_LIB(team), "ucc_tl_ucp_put_nb failed!");
-        goto out;
+    // chunk 按元素对齐，reduce 不会切开一个元素
+    task->allreduce_cyx.chunk_size =
+        ucc_max(team->cfg.allreduce_cyx_chunk_size / dt_size, 1) * dt_size;
+    task->allreduce_cyx.n_steps =
+        ALLREDUCE_CYX_RING_AG(task) ? 2 * mpi_size - 1 : mpi_size;
+    // 左邻居的 chunk 落在 scratch 里，reduce 也原地写回，只有最后一步写进 dst。
+    // 不能落在 dst 里：左邻居可能已经开始下一次操作，而本 rank 的用户还在读
+    // 上一次的结果。写进 dst 的只有最终结果，它要等所有 rank 都 post 了
+    // 本次操作才能产生
+    task->allreduce_cyx.landing = PTR_OFFSET(
+        UCC_TL_UCP_SYM_SCRATCH(team), task->allreduce_cyx.landing_offset);
+
+    // 领取本次操作的信号起始值：
+    // ring 按 chunk 到达（第 1 到 n_steps - 1 步），final 见 ALLREDUCE_CYX_N_FINAL
+    for (step = 1; mode != ALLREDUCE_CYX_MODE_AG &&
+                   step < task->allreduce_cyx.n_steps; step++) {
+        n_ring += ucc_tl_ucp_allreduce_cyx_n_chunks(task, step);
     }
+    ring_slot  = ALLREDUCE_CYX_SIGNAL_SLOT(task, ALLREDUCE_CYX_SIGNAL_RING);
+    final_slot = ALLREDUCE_CYX_SIGNAL_SLOT(task, ALLREDUCE_CYX_SIGNAL_FINAL);
+    task->allreduce_cyx.ring_base  = team->sym.signal_seq[ring_slot];
+    task->allreduce_cyx.final_base = team->sym.signal_seq[final_slot];
+    team->sym.signal_seq[ring_slot]  += n_ring;
+    team->sym.signal_seq[final_slot] += ALLREDUCE_CYX_N_FINAL(task);
 
-    // 注意：这里不能设置 pSync[0] = 0！
-    // 因为其他进程可能已经在 PUT 本进程了
-    // 应当在外部确保 global_work_buffer 为 0
-    task->allreduce_cyx.last_pSync = 0; // 已经感知并处理完了几个 PUT
-    task->allreduce_cyx.phase = ALLREDUCE_CYX_PHASE_PUTTING; // 处于 PUTTING 态
-    task->allreduce_cyx.reduce_task = NULL; // 当前没有 reduce task 在进行
-    task->allreduce_cyx.atomiced_cnt = 0; // 已经进行了多少个原子操作
+    task->allreduce_cyx.reduce_task    = NULL; // 当前没有 reduce task 在进行
+    task->allreduce_cyx.n_reduced      = 0;
+    task->allreduce_cyx.final_signaled = (mode == ALLREDUCE_CYX_MODE_RS);
+    // 第 0 步没有 reduce，直接 PUT 自己的 src 段
+    // AG 没有 reduce，只有最后一步：dst 里已经是本 rank 负责的最终结果
+    task->allreduce_cyx.reduce_step =
+        (mode == ALLREDUCE_CYX_MODE_AG) ? task->allreduce_cyx.n_steps : 1;
+    task->allreduce_cyx.reduce_chunk = 0;
+    task->allreduce_cyx.out_step =
+        (mode == ALLREDUCE_CYX_MODE_AG) ? mpi_size - 1 : 0;
+    task->allreduce_cyx.out_chunk    = 0;
+    ucc_tl_ucp_allreduce_cyx_skip(task, &task->allreduce_cyx.reduce_step,
+                                  &task->allreduce_cyx.reduce_chunk);
+    ucc_tl_ucp_allreduce_cyx_skip(task, &task->allreduce_cyx.out_step,
+                                  &task->allreduce_cyx.out_chunk);
 
-    return ucc_progress_queue_enqueue(UCC_TL_CORE_CTX(team)->pq, &task->super);
-out:
-    return status;
+    return ucc_tl_ucp_sym_enqueue(task);
 }
 
-// progress: 探查是否完成。完成时设置 task->super.status = UCC_OK
-// put、atomic、reduce 操作不允许同时进行，以简化代码
-void ucc_tl_ucp_allreduce_cyx_progress(ucc_coll_task_t *coll_task)
+// reduce 游标指向的 chunk 已经到达 landing：和 src 的对应部分做 reduce，结果原地写回 landing，
+// 最后一步直接写进 dst
+// user-defined 类型会同步完成，此时 reduce_task 仍为 NULL
+static ucc_status_t ucc_tl_ucp_allreduce_cyx_reduce(ucc_tl_ucp_task_t *task)
+{
+    ucc_coll_args_t   *args    = &TASK_ARGS(task);
+    ucc_rank_t         step    = task->allreduce_cyx.reduce_step;
+    int                is_avg  =
+        (args->op == UCC_OP_AVG) &&
+        (task->allreduce_cyx.mode == ALLREDUCE_CYX_MODE_ALLREDUCE) &&
+        (step == task->subset.map.ep_num - 1);
+    size_t             offset, len;
+    void              *landing;
+
+    ucc_tl_ucp_allreduce_cyx_chunk(task, step, task->allreduce_cyx.reduce_chunk,
+                                   &offset, &len);
+    landing = ALLREDUCE_CYX_LANDING(task, offset);
+    return ucc_dt_reduce(PTR_OFFSET(task->allreduce_cyx.sbuf, offset), landing,
+                         step == task->subset.map.ep_num - 1
+                             ? PTR_OFFSET(args->dst.info.buffer, offset)
+                             : landing,
+                         len / ucc_dt_size(args->dst.info.datatype),
+                         args->dst.info.datatype, args,
+                         is_avg ? UCC_EEE_TASK_FLAG_REDUCE_WITH_ALPHA : 0,
+                         AVG_ALPHA(task), task->allreduce_cyx.executor,
+                         &task->allreduce_cyx.reduce_task);
+}
+
+// PUT 游标指向的 chunk 已经准备好：
+// 第 0 步把 src 传给下个节点，reduce-scatter 阶段把 landing 传给下个节点继续 reduce。
+// 最后一步的结果已经在 dst 里：走环时沿环转发给下个节点的 dst，收到的段再接着转发，
+// 否则直接 PUT 到所有 rank 的 dst（RS 不需要再发）
+static ucc_status_t ucc_tl_ucp_allreduce_cyx_forward(ucc_tl_ucp_task_t *task)
 {
-    ucc_tl_ucp_task_t *task     = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
     ucc_coll_args_t   *args     = &TASK_ARGS(task);
     ucc_tl_ucp_team_t *team     = TASK_TEAM(task);
     ucc_rank_t         mpi_size = (ucc_rank_t)task->subset.map.ep_num;
     ucc_rank_t         mpi_rank = task->subset.myrank;
-    ucc_rank_t peer_rank = (mpi_rank + 1) % mpi_size; // 始终向下个节点发送
-    ptrdiff_t sbuf = (ptrdiff_t)TASK_ARGS(task).src.info.buffer; // src buf
-    ptrdiff_t dbuf = (ptrdiff_t)TASK_ARGS(task).dst.info.buffer; // dst buf
-    ptrdiff_t scratch_buf =
-        (ptrdiff_t)TASK_ARGS(task).cyx_scratch.info.buffer; // 保存 reduce 结果
-    size_t         count = TASK_ARGS(task).dst.info.count;
-    ucc_datatype_t dt    = TASK_ARGS(task).dst.info.datatype;
-    size_t data_size     = count * ucc_dt_size(dt); // sbuf or dbuf 的长度
-    size_t xsegment_size = data_size / mpi_size; // 每次交换（PUT）的长度
-    volatile long *pSync =
-        TASK_ARGS(task).global_work_buffer; // 本 rank 已经被几个人完成了 put
+    ucc_rank_t         step     = task->allreduce_cyx.out_step;
+    int                mode     = task->allreduce_cyx.mode;
+    size_t             offset, len;
+    void              *src, *dst;
+    ucc_status_t       status;
+    ucc_rank_t         i;
 
-    ucc_status_t status;
+    ucc_tl_ucp_allreduce_cyx_chunk(task, step, task->allreduce_cyx.out_chunk,
+                                   &offset, &len);
+    dst = PTR_OFFSET(args->dst.info.buffer, offset);
 
-    if (task->allreduce_cyx.phase == ALLREDUCE_CYX_PHASE_PUTTING) {
-        // 检查 task->n_polls + 1 次
-        // 完成了就执行 atomic 操作并进入 IDLE 态
-        // 没完成就没完成，下次再来
-        for (int polls = 0; polls <= task->n_polls; polls++) {
-            if (UCC_TL_UCP_TASK_ONESIDED_P2P_COMPLETE(task)) {
-                task->allreduce_cyx.phase = ALLREDUCE_CYX_PHASE_IDLE;
-                break;
+    if (step < task->allreduce_cyx.n_steps - 1 &&
+        (step < mpi_size - 1 || ALLREDUCE_CYX_RING_AG(task))) {
+        // landing 和 dst 在每个 rank 上的偏移相同，数据和信号一起发出，
+        // fence 保证下个节点看到信号时数据已经到达
+        if (step == 0) {
+            src = PTR_OFFSET(task->allreduce_cyx.sbuf, offset);
+        } else if (step < mpi_size - 1) {
+            src = ALLREDUCE_CYX_LANDING(task, offset);
+        } else {
+            src = dst;
+        }
+        return ucc_tl_ucp_put_signal_nb(
+            src, step < mpi_size - 1 ? ALLREDUCE_CYX_LANDING(task, offset) : dst,
+            len,
+            (void *)UCC_TL_UCP_SYM_SIGNAL(
+                team, ALLREDUCE_CYX_SIGNAL_SLOT(task, ALLREDUCE_CYX_SIGNAL_RING)),
+            ALLREDUCE_CYX_TEAM_RANK(task, (mpi_rank + 1) % mpi_size), team,
+            task);
+    }
+    // 走环时最后一步收到的段不用再转发
+    for (i = 0; step == mpi_size - 1 && mode != ALLREDUCE_CYX_MODE_RS &&
+                i < mpi_size; i++) {
+        if (i != mpi_rank) {
+            status = ucc_tl_ucp_put_nb(dst, dst, len,
+                                       ALLREDUCE_CYX_TEAM_RANK(task, i), team,
+                                       task);
+            if (ucc_unlikely(status != UCC_OK)) {
+                return status;
             }
-            ucp_worker_progress(UCC_TL_UCP_TASK_TEAM(task)->worker->ucp_worker);
         }
-        if (task->allreduce_cyx.atomiced_cnt < task->onesided.put_completed) {
-            if (task->onesided.put_completed <= mpi_size - 1) {
-                status =
-                    ucc_tl_ucp_atomic_inc_block((void *)pSync, peer_rank,
-                                                team); // 自己写的阻塞原子操作
-                task->allreduce_cyx.atomiced_cnt++;
+    }
+    return UCC_OK;
+}
+
+// progress: 探查是否完成。完成时设置 task->super.status = UCC_OK
+// 流水线：左邻居的 chunk 到达后交给 executor 做 reduce，reduce 完的 chunk
+// 马上按顺序 PUT 给下个节点，不等之前的 PUT 完成。同一时刻最多有一个 reduce，
+// 所以第 k 个 chunk 在网络上传输的同时，第 k+1 个 chunk 在做 reduce。
+// allgather 阶段到达的 chunk 不需要计算，到达即可转发
+void ucc_tl_ucp_allreduce_cyx_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task     = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team     = TASK_TEAM(task);
+    ucc_rank_t         mpi_size = (ucc_rank_t)task->subset.map.ep_num;
+    ucc_rank_t         mpi_rank = task->subset.myrank;
+    ucc_rank_t         n_steps  = task->allreduce_cyx.n_steps;
+    volatile uint64_t *ring_signal = UCC_TL_UCP_SYM_SIGNAL(
+        team, ALLREDUCE_CYX_SIGNAL_SLOT(task, ALLREDUCE_CYX_SIGNAL_RING));
+    volatile uint64_t *final_signal = UCC_TL_UCP_SYM_SIGNAL(
+        team, ALLREDUCE_CYX_SIGNAL_SLOT(task, ALLREDUCE_CYX_SIGNAL_FINAL));
+    int                polls        = 0;
+    ucc_status_t       status;
+    ucc_rank_t         i;
+    int                progressed;
+    int                had_progress = 0;
+
+    while (1) {
+        progressed = 0;
+
+        // 还有 reduce 任务，则检查 reduce 是否完成
+        if (task->allreduce_cyx.reduce_task != NULL) {
+            status = ucc_ee_executor_task_test(task->allreduce_cyx.reduce_task);
+            if (status != UCC_INPROGRESS) {
+                // 完成则释放 reduce 任务
+                ucc_ee_executor_task_finalize(task->allreduce_cyx.reduce_task);
+                task->allreduce_cyx.reduce_task = NULL;
                 if (status < 0) {
-                    tl_error(
-                        UCC_TASK_LIB(task),
-                        "allreduce_cyx ucc_tl_ucp_atomic_inc_block failed");
+                    tl_error(UCC_TASK_LIB(task),
+                             "allreduce_cyx reduction failed");
                     task->super.status = status;
                     return;
                 }
-            } else if (task->onesided.put_completed == 2 * mpi_size - 2) {
-                for (int i = 0; i < mpi_size; i++) {
-                    if (i != mpi_rank) {
-                        status = ucc_tl_ucp_atomic_inc_block(
-                            (void *)pSync, i,
-                            team); // 自己写的阻塞原子操作
-                        task->allreduce_cyx.atomiced_cnt++;
-                        if (status < 0) {
-                            tl_error(UCC_TASK_LIB(task),
-                                     "allreduce_cyx "
-                                     "ucc_tl_ucp_atomic_inc_block failed");
-                            task->super.status = status;
-                            return;
-                        }
-                    }
-                }
-            } else {
-                if (task->allreduce_cyx.atomiced_cnt != mpi_size - 1) {
-                    fprintf(stderr,
-                            "cyx debuging confusing atomiced_cnt %d "
-                            "put_completed %d\n",
-                            task->allreduce_cyx.atomiced_cnt,
-                            task->onesided.put_completed);
+                task->allreduce_cyx.n_reduced++;
+                ucc_tl_ucp_allreduce_cyx_next(
+                    task, &task->allreduce_cyx.reduce_step,
+                    &task->allreduce_cyx.reduce_chunk);
+                progressed = 1;
+            }
+        }
+
+        // 没有 reduce 任务，则检查左邻居的下一个 chunk 是否到达
+        if (task->allreduce_cyx.reduce_task == NULL &&
+            task->allreduce_cyx.reduce_step < n_steps &&
+            *ring_signal >
+                task->allreduce_cyx.ring_base + task->allreduce_cyx.n_reduced) {
+            if (task->allreduce_cyx.reduce_step < mpi_size) {
+                status = ucc_tl_ucp_allreduce_cyx_reduce(task);
+                if (status != UCC_OK) {
+                    tl_error(UCC_TASK_LIB(task),
+                             "failed to perform dt reduction");
+                    task->super.status = status;
+                    return;
                 }
             }
+            if (task->allreduce_cyx.reduce_task == NULL) {
+                task->allreduce_cyx.n_reduced++;
+                ucc_tl_ucp_allreduce_cyx_next(
+                    task, &task->allreduce_cyx.reduce_step,
+                    &task->allreduce_cyx.reduce_chunk);
+            }
+            progressed = 1;
         }
-        // return;
-    }
 
-    if (task->allreduce_cyx.phase == ALLREDUCE_CYX_PHASE_IDLE) {
-        // 还有 reduce 任务，则检查 reduce 是否完成
-        if (task->allreduce_cyx.reduce_task != NULL) {
-            for (int ii = 0; ii <= task->n_polls; ii++) {
-                status =
-                    ucc_ee_executor_task_test(task->allreduce_cyx.reduce_task);
-                if (status == UCC_OK) {
-                    // 完成则释放 reduce 任务
+        // 发出下一个已经 reduce 完的 chunk
+        if (task->allreduce_cyx.out_step < n_steps &&
+            (task->allreduce_cyx.out_step < task->allreduce_cyx.reduce_step ||
+             (task->allreduce_cyx.out_step == task->allreduce_cyx.reduce_step &&
+              task->allreduce_cyx.out_chunk <
+                  task->allreduce_cyx.reduce_chunk))) {
+            status = ucc_tl_ucp_allreduce_cyx_forward(task);
+            if (status != UCC_OK) {
+                tl_error(UCC_TASK_LIB(task),
+                         "allreduce_cyx failed to put chunk");
+                // executor 可能还在写 landing 和 dst，等它做完再报错
+                if (task->allreduce_cyx.reduce_task != NULL) {
                     ucc_ee_executor_task_finalize(
                         task->allreduce_cyx.reduce_task);
                     task->allreduce_cyx.reduce_task = NULL;
-                    int xsegment_id =
-                        (mpi_rank + task->allreduce_cyx.last_pSync + mpi_size -
-                         2) %
-                        mpi_size;
-                    // 并发起 PUT
-                    ptrdiff_t put_src_by_scratch =
-                        scratch_buf + xsegment_size * xsegment_id;
-                    ptrdiff_t put_dst_by_dst =
-                        dbuf + xsegment_size * xsegment_id;
-                    status = ucc_tl_ucp_put_nb(
-                        (void *)put_dst_by_dst, (void *)put_src_by_scratch,
-                        xsegment_size, peer_rank, team, task);
-
-                    if (status < 0) {
+                }
+                task->super.status = status;
+                return;
+            }
+            ucc_tl_ucp_allreduce_cyx_next(task, &task->allreduce_cyx.out_step,
+                                          &task->allreduce_cyx.out_chunk);
+            progressed = 1;
+        } else if (task->allreduce_cyx.out_step == n_steps &&
+                   !task->allreduce_cyx.final_signaled) {
+            if (ALLREDUCE_CYX_RING_AG(task)) {
+                // 走环时等自己发出的 PUT 都完成（不再读 landing 和 dst），
+                // 再通知左邻居可以开始下一次操作
+                if (task->allreduce_cyx.reduce_step == n_steps &&
+                    UCC_TL_UCP_TASK_ONESIDED_P2P_COMPLETE(task)) {
+                    status = ucc_tl_ucp_put_signal_nb(
+                        NULL, NULL, 0, (void *)final_signal,
+                        ALLREDUCE_CYX_TEAM_RANK(
+                            task, (mpi_rank - 1 + mpi_size) % mpi_size),
+                        team, task);
+                    if (status != UCC_OK) {
                         tl_error(UCC_TASK_LIB(task),
-                                 "allreduce_cyx ucc_ee_executor_task_test or "
-                                 "ucc_tl_ucp_put_nb failed");
+                                 "allreduce_cyx ucc_tl_ucp_put_signal_nb "
+                                 "failed");
                         task->super.status = status;
                         return;
                     }
-                    task->allreduce_cyx.phase = ALLREDUCE_CYX_PHASE_PUTTING;
-                    // 如果是最后一个 reduce 任务，则还要拷贝自己的到 dst
-                    if (task->allreduce_cyx.last_pSync == mpi_size - 1) {
-                        // fprintf(stderr, "cyx debuging last_pSync %ld\n",
-                        //         task->allreduce_cyx.last_pSync);
-                        for (int i = 0; i < mpi_size; i++) {
-                            if (i != mpi_rank && i != peer_rank) {
-                                // fprintf(stderr,
-                                //         "cyx debuging batch put from %d to %d\n",
-                                //         mpi_rank, i);
-                                status = ucc_tl_ucp_put_nb(
-                                    (void *)put_dst_by_dst,
-                                    (void *)put_src_by_scratch, xsegment_size,
-                                    i, team, task);
-
-                                if (status < 0) {
-                                    tl_error(UCC_TASK_LIB(task),
-                                             "allreduce_cyx "
-                                             "ucc_ee_executor_task_test or "
-                                             "ucc_tl_ucp_put_nb failed");
-                                    task->super.status = status;
-                                    return;
-                                }
-                            }
-                        }
-                        ucc_mc_memcpy((void *)put_dst_by_dst,
-                                      (void *)put_src_by_scratch, xsegment_size,
-                                      TASK_ARGS(task).dst.info.mem_type,
-                                      TASK_ARGS(task).src.info.mem_type);
-                    }
-                    break;
+                    task->allreduce_cyx.final_signaled = 1;
+                    progressed = 1;
                 }
-                // ucp_worker_progress(UCC_TL_UCP_TASK_TEAM(task)->worker->ucp_worker);
-                // return;
-            }
-            return;
-        }
-        for (int polls = 0; polls <= task->n_polls; polls++) {
-
-            // 此时没有 reduce 任务，则检查是否 pSync 变化，变化说明前一个人的 PUT 最新到达
-            if (pSync[0] > task->allreduce_cyx.last_pSync) {
-                task->allreduce_cyx.last_pSync++;
-                int xsegment_id =
-                    (mpi_rank + task->allreduce_cyx.last_pSync + mpi_size - 2) %
-                    mpi_size; // 刚刚收到的 xsegment 的 ID
-                ptrdiff_t reduce_start_src = sbuf + xsegment_size * xsegment_id;
-                ptrdiff_t reduce_start_dst = dbuf + xsegment_size * xsegment_id;
-                ptrdiff_t reduce_start_scratch =
-                    scratch_buf + xsegment_size * xsegment_id;
-                if (task->allreduce_cyx.last_pSync <=
-                    mpi_size - 1) { // 需要触发 reduce
-                    // reduce 结果总是在 scratch 中
-                    status = ucc_dt_reduce(
-                        (void *)reduce_start_src, (void *)reduce_start_dst,
-                        (void *)reduce_start_scratch,
-                        xsegment_size / ucc_dt_size(dt), dt, args, 0, 0,
-                        task->allreduce_cyx.executor,
-                        &task->allreduce_cyx.reduce_task);
+            } else {
+                // 最终结果已经 PUT 给所有其他节点，只发信号，fence 保证它排在数据之后
+                for (i = 0; i < mpi_size; i++) {
+                    if (i == mpi_rank) {
+                        continue;
+                    }
+                    status = ucc_tl_ucp_put_signal_nb(
+                        NULL, NULL, 0, (void *)final_signal,
+                        ALLREDUCE_CYX_TEAM_RANK(task, i), team, task);
                     if (status != UCC_OK) {
                         tl_error(UCC_TASK_LIB(task),
-                                 "failed to perform dt reduction");
+                                 "allreduce_cyx ucc_tl_ucp_put_signal_nb "
+                                 "failed");
                         task->super.status = status;
                         return;
                     }
-                } else if (task->allreduce_cyx.last_pSync <
-                           2 * mpi_size - 2) { // 不需要 reduce 但是需要传递 PUT
-                    // do nothing because 已经发送了
-                } else if (
-                    task->allreduce_cyx.last_pSync ==
-                    2 * mpi_size -
-                        2) { // 我的任务完成啦（所有 PUT、atomic、reduce）
-                    task->super.status = UCC_OK;
-                    return;
                 }
-                return;
-            } else {
+                task->allreduce_cyx.final_signaled = 1;
+                progressed = 1;
+            }
+        }
 
-                ucp_worker_progress(
-                    UCC_TL_UCP_TASK_TEAM(task)->worker->ucp_worker);
+        // final 信号都已到达，自己发出的 PUT 也都完成了：我的任务完成啦
+        if (task->allreduce_cyx.final_signaled &&
+            UCC_TL_UCP_TASK_ONESIDED_P2P_COMPLETE(task) &&
+            *final_signal >=
+                task->allreduce_cyx.final_base + ALLREDUCE_CYX_N_FINAL(task)) {
+            task->super.status = UCC_OK;
+            return;
+        }
+
+        if (progressed) {
+            had_progress = 1;
+        } else {
+            if (polls++ >= task->n_polls) {
+                ucc_tl_ucp_task_adapt_polls(task, had_progress);
+                return;
             }
+            ucp_worker_progress(UCC_TL_UCP_TASK_TEAM(task)->worker->ucp_worker);
         }
-        // return;
     }
 }
 
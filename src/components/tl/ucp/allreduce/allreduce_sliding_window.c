@@ -43,6 +43,22 @@ static inline void ucc_tl_ucp_allreduce_sliding_window_reset_pipeline(
     memset(pipe->put_requests, 0, put_window_size * sizeof(ucs_status_ptr_t));
 }
 
+/* Imports the memh exported by the user if there is one, otherwise registers
+   the buffer through the context registration cache */
+static ucc_status_t ucc_tl_ucp_allreduce_sliding_window_reg_buf(
+    ucc_tl_ucp_team_t *team, struct ucc_tl_ucp_allreduce_sw_export_buf *ebuf,
+    void *packed_memh, void *buf, size_t length, ucc_memory_type_t mem_type)
+{
+    ucc_tl_ucp_context_t *tl_ctx = UCC_TL_UCP_TEAM_CTX(team);
+
+    if (!packed_memh && tl_ctx->rcache) {
+        return ucc_tl_ucp_allreduce_sliding_window_register_cached(
+            team, ebuf, buf, length, mem_type);
+    }
+    return ucc_tl_ucp_allreduce_sliding_window_register(
+        tl_ctx->worker.ucp_context, team, ebuf, packed_memh);
+}
+
 ucc_status_t
 ucc_tl_ucp_allreduce_sliding_window_start(ucc_coll_task_t *coll_task)
 {
@@ -50,7 +66,6 @@ ucc_tl_ucp_allreduce_sliding_window_start(ucc_coll_task_t *coll_task)
     ucc_schedule_t       *schedule  = ucc_derived_of(coll_task, ucc_schedule_t);
     ucc_base_team_t      *base_team = schedule->super.team;
     ucc_tl_ucp_team_t    *team   = ucc_derived_of(base_team, ucc_tl_ucp_team_t);
-    ucc_tl_ucp_context_t *tl_ctx = UCC_TL_UCP_TEAM_CTX(team);
     ucc_rank_t            rank   = UCC_TL_TEAM_RANK(team);
     uint32_t              count_total = coll_task->bargs.args.dst.info.count;
     ucc_rank_t            size        = UCC_TL_TEAM_SIZE(team);
@@ -61,7 +76,9 @@ ucc_tl_ucp_allreduce_sliding_window_start(ucc_coll_task_t *coll_task)
     ucc_rank_t            put_window_size =
         UCC_TL_UCP_TEAM_LIB(team)->cfg.allreduce_sliding_window_put_window_size;
     ucc_tl_ucp_allreduce_sw_global_work_buf_info_t *gwbi_p =
-        coll_args->args.global_work_buffer;
+        (coll_args->args.mask & UCC_COLL_ARGS_FIELD_GLOBAL_WORK_BUFFER)
+            ? coll_args->args.global_work_buffer
+            : NULL;
     ucc_tl_ucp_task_t *rdma_task =
         ucc_derived_of(schedule->tasks[0], ucc_tl_ucp_task_t);
     ucc_tl_ucp_allreduce_sw_pipeline_t       *pipe;
@@ -72,10 +89,11 @@ ucc_tl_ucp_allreduce_sliding_window_start(ucc_coll_task_t *coll_task)
 
     // Register the src buf
     if (!inplace) {
-        status = ucc_tl_ucp_allreduce_sliding_window_register(
-            tl_ctx->worker.ucp_context, team,
-            rdma_task->allreduce_sliding_window.bufs->src_ebuf,
-            gwbi_p->packed_src_memh);
+        status = ucc_tl_ucp_allreduce_sliding_window_reg_buf(
+            team, rdma_task->allreduce_sliding_window.bufs->src_ebuf,
+            gwbi_p ? gwbi_p->packed_src_memh : NULL,
+            coll_args->args.src.info.buffer, count_total * dt_size,
+            coll_args->args.src.info.mem_type);
         if (status != UCC_OK) {
             tl_error(UCC_TASK_LIB(rdma_task), "failed to register src memh: %s",
                      ucc_status_string(status));
@@ -90,10 +108,11 @@ ucc_tl_ucp_allreduce_sliding_window_start(ucc_coll_task_t *coll_task)
     }
 
     // Register the dst buf
-    status = ucc_tl_ucp_allreduce_sliding_window_register(
-        tl_ctx->worker.ucp_context, team,
-        rdma_task->allreduce_sliding_window.bufs->dst_ebuf,
-        gwbi_p->packed_dst_memh);
+    status = ucc_tl_ucp_allreduce_sliding_window_reg_buf(
+        team, rdma_task->allreduce_sliding_window.bufs->dst_ebuf,
+        gwbi_p ? gwbi_p->packed_dst_memh : NULL,
+        coll_args->args.dst.info.buffer, count_total * dt_size,
+        coll_args->args.dst.info.mem_type);
     if (status != UCC_OK) {
         tl_error(UCC_TASK_LIB(rdma_task), "failed to register dst memh: %s",
                  ucc_status_string(status));
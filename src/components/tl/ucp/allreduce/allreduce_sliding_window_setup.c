@@ -155,7 +155,8 @@ ucc_tl_ucp_allreduce_sliding_window_task_init(ucc_base_coll_args_t *coll_args,
     }
 
     ptr = task->allreduce_sliding_window.bufs->dst_ebuf = PTR_OFFSET(ptr, dst_rkeys_sz);
-    task->allreduce_sliding_window.bufs->dst_ebuf->memh = NULL;
+    task->allreduce_sliding_window.bufs->dst_ebuf->memh   = NULL;
+    task->allreduce_sliding_window.bufs->dst_ebuf->region = NULL;
 
     allgather_data->dst_buf = dst_buf;
 
@@ -172,7 +173,8 @@ ucc_tl_ucp_allreduce_sliding_window_task_init(ucc_base_coll_args_t *coll_args,
         }
 
         task->allreduce_sliding_window.bufs->src_ebuf = PTR_OFFSET(ptr, src_rkeys_sz);
-        task->allreduce_sliding_window.bufs->src_ebuf->memh = NULL;
+        task->allreduce_sliding_window.bufs->src_ebuf->memh   = NULL;
+        task->allreduce_sliding_window.bufs->src_ebuf->region = NULL;
     } else {
         task->allreduce_sliding_window.bufs->src_ebuf = NULL;
     }
@@ -253,12 +255,20 @@ ucc_tl_ucp_allreduce_sliding_window_free_task(ucc_coll_task_t *coll_task)
                               task->allreduce_sliding_window.bufs->src_ebuf->memh);
                 task->allreduce_sliding_window.bufs->src_ebuf->memh = NULL;
             }
+            if (task->allreduce_sliding_window.bufs->src_ebuf->region) {
+                ucc_tl_ucp_rcache_put(
+                    tl_ctx, task->allreduce_sliding_window.bufs->src_ebuf->region);
+            }
         }
 
         if (task->allreduce_sliding_window.bufs->dst_ebuf->memh != NULL) {
             ucp_mem_unmap(tl_ctx->worker.ucp_context,
                           task->allreduce_sliding_window.bufs->dst_ebuf->memh);
         }
+        if (task->allreduce_sliding_window.bufs->dst_ebuf->region) {
+            ucc_tl_ucp_rcache_put(
+                tl_ctx, task->allreduce_sliding_window.bufs->dst_ebuf->region);
+        }
         ucc_free(task->allreduce_sliding_window.bufs);
     }
 }
@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  *
  * See file LICENSE for terms.
  */
@@ -188,13 +188,14 @@ ucc_tl_ucp_allreduce_sra_knomial_get_pipeline_params(ucc_tl_ucp_team_t *team,
         pp->frag_size = mc_attr.fast_alloc_size;
         pp->order     = UCC_PIPELINE_PARALLEL;
         pp->pdepth    = 2;
+        pp->bdp       = 0;
     } else {
         pp->threshold = SIZE_MAX;
         pp->n_frags   = 0;
         pp->frag_size = 0;
         pp->pdepth    = 1;
         pp->order     = UCC_PIPELINE_PARALLEL;
-
+        pp->bdp       = 0;
     }
 }
 
@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  *
  * See file LICENSE for terms.
  */
@@ -7,6 +7,7 @@
 #include "config.h"
 #include "tl_ucp.h"
 #include "alltoall.h"
+#include "tl_ucp_sendrecv.h"
 
 #define ALLTOALL_MAX_PATTERN_SIZE                                              \
     (sizeof(UCC_TL_UCP_ALLTOALL_DEFAULT_ALG_SELECT_STR_PATTERN) + 32)
@@ -76,31 +77,58 @@ ucc_status_t ucc_tl_ucp_alltoall_onesided_init(ucc_base_coll_args_t *coll_args,
                                                ucc_coll_task_t     **task_h)
 {
     ucc_tl_ucp_team_t *tl_team = ucc_derived_of(team, ucc_tl_ucp_team_t);
+    ucc_coll_args_t   *args    = &coll_args->args;
     ucc_tl_ucp_task_t *task;
     ucc_status_t       status;
+    void              *bufs[2];
+    size_t             lens[2];
+    ucc_memory_type_t  mem_types[2];
+    int                mapped, gwb;
 
     ALLTOALL_TASK_CHECK(coll_args->args, tl_team);
 
-    if (!(coll_args->args.mask & UCC_COLL_ARGS_FIELD_GLOBAL_WORK_BUFFER)) {
-
+    /* without a global work buffer the signals go to the team symmetric
+       region */
+    gwb = !!(coll_args->args.mask & UCC_COLL_ARGS_FIELD_GLOBAL_WORK_BUFFER);
+    if (!gwb && !UCC_TL_UCP_TEAM_HAS_SYM(tl_team)) {
         tl_error(UCC_TL_TEAM_LIB(tl_team),
                  "global work buffer not provided nor associated with team");
         status = UCC_ERR_NOT_SUPPORTED;
         goto out;
     }
-    if (coll_args->args.mask & UCC_COLL_ARGS_FIELD_FLAGS) {
-        if (!(coll_args->args.flags & UCC_COLL_ARGS_FLAG_MEM_MAPPED_BUFFERS)) {
-            tl_error(UCC_TL_TEAM_LIB(tl_team),
-                     "non memory mapped buffers are not supported");
-            status = UCC_ERR_NOT_SUPPORTED;
-            goto out;
-        }
+    mapped = !(args->mask & UCC_COLL_ARGS_FIELD_FLAGS) ||
+             (args->flags & UCC_COLL_ARGS_FLAG_MEM_MAPPED_BUFFERS);
+    if (UCC_TL_UCP_TEAM_CTX(tl_team)->rcache) {
+        /* buffers that are not mapped get registered on first use */
+        mapped = ucc_tl_ucp_is_mapped(tl_team, args->dst.info.buffer) &&
+                 (!gwb ||
+                  ucc_tl_ucp_is_mapped(tl_team, args->global_work_buffer));
+    } else if (!mapped) {
+        tl_error(UCC_TL_TEAM_LIB(tl_team),
+                 "non memory mapped buffers are not supported");
+        status = UCC_ERR_NOT_SUPPORTED;
+        goto out;
     }
     task                 = ucc_tl_ucp_init_task(coll_args, team);
     *task_h              = &task->super;
     task->super.post     = ucc_tl_ucp_alltoall_onesided_start;
     task->super.progress = ucc_tl_ucp_alltoall_onesided_progress;
     status               = UCC_OK;
+    if (mapped) {
+        goto out;
+    }
+
+    bufs[0]      = args->dst.info.buffer;
+    lens[0]      = args->dst.info.count * ucc_dt_size(args->dst.info.datatype);
+    mem_types[0] = args->dst.info.mem_type;
+    bufs[1]      = args->global_work_buffer;
+    lens[1]      = ONESIDED_SYNC_SIZE * sizeof(long);
+    mem_types[1] = UCC_MEMORY_TYPE_HOST;
+    status = ucc_tl_ucp_dyn_mem_schedule_init(task, gwb ? 2 : 1, bufs, lens,
+                                              mem_types, task_h);
+    if (UCC_OK != status) {
+        ucc_tl_ucp_put_task(task);
+    }
 out:
     return status;
 }
@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  *
  * See file LICENSE for terms.
  */
@@ -13,52 +13,82 @@
 
 void ucc_tl_ucp_alltoall_onesided_progress(ucc_coll_task_t *ctask);
 
-ucc_status_t ucc_tl_ucp_alltoall_onesided_start(ucc_coll_task_t *ctask)
+/* issue puts to the next peers while the window allows */
+static ucc_status_t ucc_tl_ucp_alltoall_onesided_post(ucc_tl_ucp_task_t *task)
 {
-    ucc_tl_ucp_task_t *task   = ucc_derived_of(ctask, ucc_tl_ucp_task_t);
     ucc_tl_ucp_team_t *team   = TASK_TEAM(task);
     ptrdiff_t          src    = (ptrdiff_t)TASK_ARGS(task).src.info.buffer;
     ptrdiff_t          dest   = (ptrdiff_t)TASK_ARGS(task).dst.info.buffer;
     size_t             nelems = TASK_ARGS(task).src.info.count;
     ucc_rank_t         grank  = UCC_TL_TEAM_RANK(team);
     ucc_rank_t         gsize  = UCC_TL_TEAM_SIZE(team);
-    ucc_rank_t         start  = (grank + 1) % gsize;
-    long *             pSync  = TASK_ARGS(task).global_work_buffer;
+    long *             pSync  = (long *)task->onesided.sync;
+    ucc_rank_t         nreqs  = ucc_tl_ucp_onesided_num_posts(
+        team, UCC_TL_UCP_TEAM_LIB(team)->cfg.alltoall_onesided_num_posts);
     ucc_rank_t         peer;
 
-    ucc_tl_ucp_task_reset(task, UCC_INPROGRESS);
     /* TODO: change when support for library-based work buffers is complete */
     nelems = (nelems / gsize) * ucc_dt_size(TASK_ARGS(task).src.info.datatype);
     dest   = dest + grank * nelems;
-    UCPCHECK_GOTO(ucc_tl_ucp_put_nb((void *)(src + start * nelems),
-                                    (void *)dest, nelems, start, team, task),
-                  task, out);
-    UCPCHECK_GOTO(ucc_tl_ucp_atomic_inc(pSync, start, team), task, out);
-
-    for (peer = (start + 1) % gsize; peer != start; peer = (peer + 1) % gsize) {
-        UCPCHECK_GOTO(ucc_tl_ucp_put_nb((void *)(src + peer * nelems),
-                                        (void *)dest, nelems, peer, team, task),
+    while (task->onesided.put_posted < gsize &&
+           (task->onesided.put_posted - task->onesided.put_completed) < nreqs) {
+        peer = ucc_tl_ucp_onesided_peer(team, task->onesided.put_posted);
+        UCPCHECK_GOTO(ucc_tl_ucp_put_signal_nb((void *)(src + peer * nelems),
+                                               (void *)dest, nelems, pSync,
+                                               peer, team, task),
                       task, out);
-        UCPCHECK_GOTO(ucc_tl_ucp_atomic_inc(pSync, peer, team), task,
-                      out);
     }
-
-    return ucc_progress_queue_enqueue(UCC_TL_CORE_CTX(team)->pq, &task->super);
+    return UCC_OK;
 out:
     return task->super.status;
 }
 
+ucc_status_t ucc_tl_ucp_alltoall_onesided_start(ucc_coll_task_t *ctask)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(ctask, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team = TASK_TEAM(task);
+    ucc_status_t       status;
+
+    if (!(TASK_ARGS(task).mask & UCC_COLL_ARGS_FIELD_GLOBAL_WORK_BUFFER)) {
+        /* signals go to the team symmetric region */
+        status = ucc_tl_ucp_sym_acquire(task);
+        if (ucc_unlikely(UCC_OK != status)) {
+            /* UCC_INPROGRESS: started again once the region is free */
+            return (UCC_INPROGRESS == status) ? UCC_OK : status;
+        }
+    }
+    ucc_tl_ucp_task_reset(task, UCC_INPROGRESS);
+    ucc_tl_ucp_onesided_sync_start(
+        task, UCC_TL_UCP_SYM_SIGNAL_ALLTOALL_ONESIDED, UCC_TL_TEAM_SIZE(team));
+    status = ucc_tl_ucp_alltoall_onesided_post(task);
+    if (UCC_OK != status) {
+        return status;
+    }
+    return ucc_tl_ucp_sym_enqueue(task);
+}
+
 void ucc_tl_ucp_alltoall_onesided_progress(ucc_coll_task_t *ctask)
 {
     ucc_tl_ucp_task_t *task  = ucc_derived_of(ctask, ucc_tl_ucp_task_t);
     ucc_tl_ucp_team_t *team  = TASK_TEAM(task);
     ucc_rank_t         gsize = UCC_TL_TEAM_SIZE(team);
-    long *             pSync = TASK_ARGS(task).global_work_buffer;
+    int                polls = 0;
 
-    if (ucc_tl_ucp_test_onesided(task, gsize) == UCC_INPROGRESS) {
+    while (task->onesided.put_posted < gsize) {
+        if (UCC_OK != ucc_tl_ucp_alltoall_onesided_post(task) ||
+            task->onesided.put_posted == gsize || polls++ >= task->n_polls) {
+            break;
+        }
+        ucp_worker_progress(UCC_TL_UCP_TEAM_CTX(team)->worker.ucp_worker);
+    }
+    if (task->super.status != UCC_INPROGRESS ||
+        task->onesided.put_posted < gsize) {
+        return;
+    }
+    if (ucc_tl_ucp_test_onesided(task) == UCC_INPROGRESS) {
         return;
     }
 
-    pSync[0]           = 0;
+    ucc_tl_ucp_onesided_sync_consume(task);
     task->super.status = UCC_OK;
 }
@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2023-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  *
  * See file LICENSE for terms.
  */
@@ -11,28 +11,28 @@
 #include "utils/ucc_math.h"
 #include "tl_ucp_sendrecv.h"
 
-ucc_status_t ucc_tl_ucp_alltoallv_onesided_start(ucc_coll_task_t *ctask)
+/* issue puts to the next peers while the window allows */
+static ucc_status_t ucc_tl_ucp_alltoallv_onesided_post(ucc_tl_ucp_task_t *task)
 {
-    ucc_tl_ucp_task_t *task     = ucc_derived_of(ctask, ucc_tl_ucp_task_t);
     ucc_tl_ucp_team_t *team     = TASK_TEAM(task);
     ptrdiff_t          src      = (ptrdiff_t)TASK_ARGS(task).src.info_v.buffer;
     ptrdiff_t          dest     = (ptrdiff_t)TASK_ARGS(task).dst.info_v.buffer;
-    ucc_rank_t         grank    = UCC_TL_TEAM_RANK(team);
     ucc_rank_t         gsize    = UCC_TL_TEAM_SIZE(team);
-    long              *pSync    = TASK_ARGS(task).global_work_buffer;
+    long              *pSync    = (long *)task->onesided.sync;
     ucc_aint_t        *s_disp   = TASK_ARGS(task).src.info_v.displacements;
     ucc_aint_t        *d_disp   = TASK_ARGS(task).dst.info_v.displacements;
     size_t             sdt_size = ucc_dt_size(TASK_ARGS(task).src.info_v.datatype);
     size_t             rdt_size = ucc_dt_size(TASK_ARGS(task).dst.info_v.datatype);
+    ucc_rank_t         nreqs    = ucc_tl_ucp_onesided_num_posts(
+        team, UCC_TL_UCP_TEAM_LIB(team)->cfg.alltoallv_onesided_num_posts);
     ucc_rank_t         peer;
     size_t             sd_disp, dd_disp, data_size;
 
-    ucc_tl_ucp_task_reset(task, UCC_INPROGRESS);
-
     /* perform a put to each member peer using the peer's index in the
      * destination displacement. */
-    for (peer = (grank + 1) % gsize; task->onesided.put_posted < gsize;
-         peer = (peer + 1) % gsize) {
+    while (task->onesided.put_posted < gsize &&
+           (task->onesided.put_posted - task->onesided.put_completed) < nreqs) {
+        peer = ucc_tl_ucp_onesided_peer(team, task->onesided.put_posted);
         sd_disp =
             ucc_coll_args_get_displacement(&TASK_ARGS(task), s_disp, peer) *
             sdt_size;
@@ -44,29 +44,64 @@ ucc_status_t ucc_tl_ucp_alltoallv_onesided_start(ucc_coll_task_t *ctask)
                                     TASK_ARGS(task).src.info_v.counts, peer) *
             sdt_size;
 
-        UCPCHECK_GOTO(ucc_tl_ucp_put_nb(PTR_OFFSET(src, sd_disp),
-                                        PTR_OFFSET(dest, dd_disp),
-                                        data_size, peer, team, task),
+        UCPCHECK_GOTO(ucc_tl_ucp_put_signal_nb(PTR_OFFSET(src, sd_disp),
+                                               PTR_OFFSET(dest, dd_disp),
+                                               data_size, pSync, peer, team,
+                                               task),
                       task, out);
-        UCPCHECK_GOTO(ucc_tl_ucp_atomic_inc(pSync, peer, team), task, out);
     }
-    return ucc_progress_queue_enqueue(UCC_TL_CORE_CTX(team)->pq, &task->super);
+    return UCC_OK;
 out:
     return task->super.status;
 }
 
+ucc_status_t ucc_tl_ucp_alltoallv_onesided_start(ucc_coll_task_t *ctask)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(ctask, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team = TASK_TEAM(task);
+    ucc_status_t       status;
+
+    if (!(TASK_ARGS(task).mask & UCC_COLL_ARGS_FIELD_GLOBAL_WORK_BUFFER)) {
+        /* signals go to the team symmetric region */
+        status = ucc_tl_ucp_sym_acquire(task);
+        if (ucc_unlikely(UCC_OK != status)) {
+            /* UCC_INPROGRESS: started again once the region is free */
+            return (UCC_INPROGRESS == status) ? UCC_OK : status;
+        }
+    }
+    ucc_tl_ucp_task_reset(task, UCC_INPROGRESS);
+    ucc_tl_ucp_onesided_sync_start(
+        task, UCC_TL_UCP_SYM_SIGNAL_ALLTOALLV_ONESIDED, UCC_TL_TEAM_SIZE(team));
+    status = ucc_tl_ucp_alltoallv_onesided_post(task);
+    if (UCC_OK != status) {
+        return status;
+    }
+    return ucc_tl_ucp_sym_enqueue(task);
+}
+
 void ucc_tl_ucp_alltoallv_onesided_progress(ucc_coll_task_t *ctask)
 {
     ucc_tl_ucp_task_t *task  = ucc_derived_of(ctask, ucc_tl_ucp_task_t);
     ucc_tl_ucp_team_t *team  = TASK_TEAM(task);
     ucc_rank_t         gsize = UCC_TL_TEAM_SIZE(team);
-    long              *pSync = TASK_ARGS(task).global_work_buffer;
+    int                polls = 0;
 
-    if (ucc_tl_ucp_test_onesided(task, gsize) == UCC_INPROGRESS) {
+    while (task->onesided.put_posted < gsize) {
+        if (UCC_OK != ucc_tl_ucp_alltoallv_onesided_post(task) ||
+            task->onesided.put_posted == gsize || polls++ >= task->n_polls) {
+            break;
+        }
+        ucp_worker_progress(UCC_TL_UCP_TEAM_CTX(team)->worker.ucp_worker);
+    }
+    if (task->super.status != UCC_INPROGRESS ||
+        task->onesided.put_posted < gsize) {
+        return;
+    }
+    if (ucc_tl_ucp_test_onesided(task) == UCC_INPROGRESS) {
         return;
     }
 
-    pSync[0]           = 0;
+    ucc_tl_ucp_onesided_sync_consume(task);
     task->super.status = UCC_OK;
 }
 
@@ -79,7 +114,10 @@ ucc_status_t ucc_tl_ucp_alltoallv_onesided_init(ucc_base_coll_args_t *coll_args,
     ucc_status_t       status;
 
     ALLTOALLV_TASK_CHECK(coll_args->args, tl_team);
-    if (!(coll_args->args.mask & UCC_COLL_ARGS_FIELD_GLOBAL_WORK_BUFFER)) {
+    /* without a global work buffer the signals go to the team symmetric
+       region */
+    if (!(coll_args->args.mask & UCC_COLL_ARGS_FIELD_GLOBAL_WORK_BUFFER) &&
+        !UCC_TL_UCP_TEAM_HAS_SYM(tl_team)) {
         tl_error(UCC_TL_TEAM_LIB(tl_team),
                  "global work buffer not provided nor associated with team");
         status = UCC_ERR_NOT_SUPPORTED;
@@ -0,0 +1,318 @@
+/**
+ * Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "tl_ucp.h"
+#include "bcast.h"
+#include "core/ucc_progress_queue.h"
+#include "tl_ucp_sendrecv.h"
+#include "utils/ucc_math.h"
+
+/* Receiver driven bcast over a knomial tree: every non-root rank pulls the
+   data from its parent with a single get, so the root does not have to drive
+   a send per child and no tag matching or rendezvous is involved.
+   Readiness is pushed rather than polled remotely: once the data is in place
+   locally a rank bumps the "ready" signal of each of its children, a child
+   spins on its own ready signal and fetches the data when it has been
+   bumped. After its get has completed the child bumps the "done" signal of
+   the parent, parent completes when all its children are done and only then
+   may reuse the buffer. Both signals are counters that are never reset:
+   every non-root rank receives exactly one ready signal per bcast and every
+   rank one done signal per child, so the number of signals consumed so far,
+   kept in signal_seq, identifies the current bcast.
+   Trees of consecutive bcasts differ with the root, so the parent of the next
+   bcast may have the data while a child still waits for its parent of the
+   current one. Every rank therefore publishes the number of the bcast it has
+   posted in its "posted" word and a parent bumps a child only once it has
+   read the number of the current bcast there. The parent fetches the words
+   on start, so this is off the critical path unless the child is late. */
+
+enum {
+    UCC_TL_UCP_BCAST_ONESIDED_PHASE_POLL,
+    UCC_TL_UCP_BCAST_ONESIDED_PHASE_GET,
+    UCC_TL_UCP_BCAST_ONESIDED_PHASE_NOTIFY,
+    UCC_TL_UCP_BCAST_ONESIDED_PHASE_WAIT_CHILDREN
+};
+
+#define BCAST_ONESIDED_READY_SIGNAL(_team)                                     \
+    UCC_TL_UCP_SYM_SIGNAL(_team, UCC_TL_UCP_SYM_SIGNAL_BCAST_ONESIDED)
+#define BCAST_ONESIDED_DONE_SIGNAL(_team)                                      \
+    UCC_TL_UCP_SYM_SIGNAL(_team, UCC_TL_UCP_SYM_SIGNAL_BCAST_ONESIDED + 1)
+#define BCAST_ONESIDED_POSTED(_team)                                           \
+    UCC_TL_UCP_SYM_SIGNAL(_team, UCC_TL_UCP_SYM_SIGNAL_BCAST_ONESIDED + 2)
+
+/* posted[] value of a child which has already been bumped */
+#define BCAST_ONESIDED_NOTIFIED UINT64_MAX
+
+/* parent and number of children of vrank in the knomial tree rooted at 0,
+   parent is UCC_RANK_INVALID on the root */
+static void ucc_tl_ucp_bcast_onesided_tree(ucc_rank_t vrank, ucc_rank_t size,
+                                           uint32_t radix, ucc_rank_t *parent,
+                                           ucc_rank_t *n_children)
+{
+    ucc_rank_t dist, pos, i;
+
+    *parent     = UCC_RANK_INVALID;
+    *n_children = 0;
+    CALC_KN_TREE_DIST(size, radix, dist);
+    while (dist >= 1) {
+        if (vrank % dist == 0) {
+            pos = (vrank / dist) % radix;
+            if (pos == 0) {
+                for (i = 1; i < radix && vrank + i * dist < size; i++) {
+                    (*n_children)++;
+                }
+            } else if (*parent == UCC_RANK_INVALID) {
+                *parent = vrank - pos * dist;
+            }
+        }
+        dist /= radix;
+    }
+}
+
+/* bumps the ready signal of every child of vrank in the knomial tree which
+   has posted the current bcast, fetches the posted word of the others again */
+static ucc_status_t ucc_tl_ucp_bcast_onesided_notify(ucc_tl_ucp_task_t *task)
+{
+    ucc_tl_ucp_team_t *team   = TASK_TEAM(task);
+    ucc_rank_t         size   = (ucc_rank_t)task->subset.map.ep_num;
+    ucc_rank_t         root   = (ucc_rank_t)TASK_ARGS(task).root;
+    ucc_rank_t         vrank  = VRANK(task->subset.myrank, root, size);
+    uint32_t           radix  = task->bcast_onesided.radix;
+    uint64_t          *posted = task->bcast_onesided.posted;
+    ucc_rank_t         n      = 0;
+    ucc_rank_t         dist, child, i;
+    ucc_status_t       status;
+
+    CALC_KN_TREE_DIST(size, radix, dist);
+    while (dist >= 1) {
+        if (vrank % dist == 0 && (vrank / dist) % radix == 0) {
+            for (i = 1; i < radix && vrank + i * dist < size; i++, n++) {
+                if (posted[n] == BCAST_ONESIDED_NOTIFIED) {
+                    continue;
+                }
+                child = INV_VRANK(vrank + i * dist, root, size);
+                child = ucc_ep_map_eval(task->subset.map, child);
+                if (posted[n] >= task->bcast_onesided.seq) {
+                    status = ucc_tl_ucp_put_signal_nb(
+                        NULL, NULL, 0,
+                        (void *)BCAST_ONESIDED_READY_SIGNAL(team), child,
+                        team, task);
+                    posted[n] = BCAST_ONESIDED_NOTIFIED;
+                    task->bcast_onesided.n_notified++;
+                } else {
+                    status = ucc_tl_ucp_get_nb(
+                        &posted[n], (void *)BCAST_ONESIDED_POSTED(team),
+                        sizeof(uint64_t), child, team, task);
+                }
+                if (ucc_unlikely(UCC_OK != status)) {
+                    return status;
+                }
+            }
+        }
+        dist /= radix;
+    }
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_bcast_onesided_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task  = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team  = TASK_TEAM(task);
+    ucc_rank_t         size  = (ucc_rank_t)task->subset.map.ep_num;
+    ucc_rank_t         root  = (ucc_rank_t)TASK_ARGS(task).root;
+    ucc_rank_t         vrank = VRANK(task->subset.myrank, root, size);
+    ucc_rank_t         vparent;
+    ucc_status_t       status;
+
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task, "ucp_bcast_onesided_start", 0);
+    status = ucc_tl_ucp_sym_acquire(task);
+    if (ucc_unlikely(UCC_OK != status)) {
+        /* UCC_INPROGRESS: started again once the region is free */
+        return (UCC_INPROGRESS == status) ? UCC_OK : status;
+    }
+    ucc_tl_ucp_task_reset(task, UCC_INPROGRESS);
+    task->onesided.put_posted    = 0;
+    task->onesided.put_completed = 0;
+    task->onesided.get_posted    = 0;
+    task->onesided.get_completed = 0;
+
+    if (size == 1) {
+        task->super.status = UCC_OK;
+        return ucc_task_complete(&task->super);
+    }
+
+    ucc_tl_ucp_bcast_onesided_tree(vrank, size, task->bcast_onesided.radix,
+                                   &vparent, &task->bcast_onesided.n_children);
+    task->bcast_onesided.parent =
+        (vparent == UCC_RANK_INVALID)
+            ? UCC_RANK_INVALID
+            : ucc_ep_map_eval(task->subset.map,
+                              INV_VRANK(vparent, root, size));
+    task->bcast_onesided.done_base =
+        team->sym.signal_seq[UCC_TL_UCP_SYM_SIGNAL_BCAST_ONESIDED + 1];
+    team->sym.signal_seq[UCC_TL_UCP_SYM_SIGNAL_BCAST_ONESIDED + 1] +=
+        task->bcast_onesided.n_children;
+    task->bcast_onesided.seq =
+        ++team->sym.signal_seq[UCC_TL_UCP_SYM_SIGNAL_BCAST_ONESIDED + 2];
+    *BCAST_ONESIDED_POSTED(team) = task->bcast_onesided.seq;
+
+    /* fetch the posted words of the children while waiting for the data */
+    memset(task->bcast_onesided.posted, 0,
+           task->bcast_onesided.n_children * sizeof(uint64_t));
+    task->bcast_onesided.n_notified = 0;
+    status = ucc_tl_ucp_bcast_onesided_notify(task);
+    if (ucc_unlikely(UCC_OK != status)) {
+        return status;
+    }
+    if (task->bcast_onesided.parent == UCC_RANK_INVALID) {
+        task->bcast_onesided.phase = UCC_TL_UCP_BCAST_ONESIDED_PHASE_NOTIFY;
+    } else {
+        task->bcast_onesided.ready_base =
+            team->sym.signal_seq[UCC_TL_UCP_SYM_SIGNAL_BCAST_ONESIDED]++;
+        task->bcast_onesided.phase = UCC_TL_UCP_BCAST_ONESIDED_PHASE_POLL;
+    }
+    return ucc_tl_ucp_sym_enqueue(task);
+}
+
+void ucc_tl_ucp_bcast_onesided_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task   = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team   = TASK_TEAM(task);
+    void              *buffer = TASK_ARGS(task).src.info.buffer;
+    size_t             data_size =
+        TASK_ARGS(task).src.info.count *
+        ucc_dt_size(TASK_ARGS(task).src.info.datatype);
+    ucc_rank_t         parent       = task->bcast_onesided.parent;
+    volatile uint64_t *ready_signal = BCAST_ONESIDED_READY_SIGNAL(team);
+    volatile uint64_t *done_signal  = BCAST_ONESIDED_DONE_SIGNAL(team);
+    int                polls        = 0;
+
+    while (1) {
+        if (!UCC_TL_UCP_TASK_ONESIDED_P2P_COMPLETE(task)) {
+            goto poll;
+        }
+        switch (task->bcast_onesided.phase) {
+        case UCC_TL_UCP_BCAST_ONESIDED_PHASE_POLL:
+            if (*ready_signal > task->bcast_onesided.ready_base) {
+                UCPCHECK_GOTO(ucc_tl_ucp_get_nb(buffer, buffer, data_size,
+                                                parent, team, task),
+                              task, out);
+                task->bcast_onesided.phase =
+                    UCC_TL_UCP_BCAST_ONESIDED_PHASE_GET;
+                continue;
+            }
+            break;
+        case UCC_TL_UCP_BCAST_ONESIDED_PHASE_GET:
+            /* data is in place: release the buffer of the parent and let
+               the children fetch it */
+            UCPCHECK_GOTO(ucc_tl_ucp_put_signal_nb(NULL, NULL, 0,
+                                                   (void *)done_signal, parent,
+                                                   team, task),
+                          task, out);
+            task->bcast_onesided.phase = UCC_TL_UCP_BCAST_ONESIDED_PHASE_NOTIFY;
+            /* fall through */
+        case UCC_TL_UCP_BCAST_ONESIDED_PHASE_NOTIFY:
+            if (task->bcast_onesided.n_notified <
+                task->bcast_onesided.n_children) {
+                UCPCHECK_GOTO(ucc_tl_ucp_bcast_onesided_notify(task), task,
+                              out);
+                if (task->bcast_onesided.n_notified <
+                    task->bcast_onesided.n_children) {
+                    break;
+                }
+            }
+            task->bcast_onesided.phase =
+                UCC_TL_UCP_BCAST_ONESIDED_PHASE_WAIT_CHILDREN;
+            continue;
+        case UCC_TL_UCP_BCAST_ONESIDED_PHASE_WAIT_CHILDREN:
+            if (*done_signal >= task->bcast_onesided.done_base +
+                                    task->bcast_onesided.n_children) {
+                task->super.status = UCC_OK;
+                UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task,
+                                                 "ucp_bcast_onesided_done", 0);
+                return;
+            }
+            break;
+        }
+poll:
+        if (polls++ >= task->n_polls) {
+            return;
+        }
+        ucp_worker_progress(UCC_TL_UCP_TEAM_CTX(team)->worker.ucp_worker);
+    }
+out:
+    return;
+}
+
+ucc_status_t ucc_tl_ucp_bcast_onesided_init(ucc_base_coll_args_t *coll_args,
+                                            ucc_base_team_t      *team,
+                                            ucc_coll_task_t     **task_h)
+{
+    ucc_tl_ucp_team_t *tl_team = ucc_derived_of(team, ucc_tl_ucp_team_t);
+    ucc_rank_t         size    = UCC_TL_TEAM_SIZE(tl_team);
+    ucc_tl_ucp_task_t *task;
+    ucc_rank_t         parent, n_children;
+
+    if (UCC_COLL_ARGS_ACTIVE_SET(&coll_args->args)) {
+        tl_debug(UCC_TL_TEAM_LIB(tl_team),
+                 "onesided bcast does not support active sets");
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    if (UCC_TL_TEAM_SIZE(tl_team) > 1) {
+        if (!UCC_TL_UCP_TEAM_HAS_SYM(tl_team)) {
+            tl_debug(UCC_TL_TEAM_LIB(tl_team),
+                     "symmetric memory is not available on team");
+            return UCC_ERR_NOT_SUPPORTED;
+        }
+        if (coll_args->args.src.info.mem_type != UCC_MEMORY_TYPE_HOST) {
+            tl_debug(UCC_TL_TEAM_LIB(tl_team),
+                     "onesided bcast supports only host memory");
+            return UCC_ERR_NOT_SUPPORTED;
+        }
+        /* children read the buffer of the parent */
+        if (coll_args->args.mask & UCC_COLL_ARGS_FIELD_FLAGS) {
+            if (!(coll_args->args.flags &
+                  UCC_COLL_ARGS_FLAG_MEM_MAPPED_BUFFERS)) {
+                tl_debug(UCC_TL_TEAM_LIB(tl_team),
+                         "non memory mapped buffers are not supported");
+                return UCC_ERR_NOT_SUPPORTED;
+            }
+        }
+    }
+
+    task                        = ucc_tl_ucp_init_task(coll_args, team);
+    task->bcast_onesided.radix  =
+        ucc_min(UCC_TL_UCP_TEAM_LIB(tl_team)->cfg.bcast_kn_radix, size);
+    task->bcast_onesided.posted = NULL;
+    task->super.post            = ucc_tl_ucp_bcast_onesided_start;
+    task->super.progress        = ucc_tl_ucp_bcast_onesided_progress;
+    task->super.finalize        = ucc_tl_ucp_bcast_onesided_finalize;
+    if (size > 1) {
+        /* the root of the tree has the largest number of children */
+        ucc_tl_ucp_bcast_onesided_tree(0, size, task->bcast_onesided.radix,
+                                       &parent, &n_children);
+        task->bcast_onesided.posted =
+            ucc_malloc(n_children * sizeof(uint64_t), "bcast onesided posted");
+        if (ucc_unlikely(!task->bcast_onesided.posted)) {
+            tl_error(UCC_TL_TEAM_LIB(tl_team),
+                     "failed to allocate %zd bytes for posted words",
+                     n_children * sizeof(uint64_t));
+            ucc_tl_ucp_put_task(task);
+            return UCC_ERR_NO_MEMORY;
+        }
+    }
+    *task_h = &task->super;
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_bcast_onesided_finalize(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+
+    ucc_free(task->bcast_onesided.posted);
+    return ucc_tl_ucp_coll_finalize(coll_task);
+}
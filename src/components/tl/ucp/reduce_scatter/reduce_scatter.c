@@ -18,5 +18,9 @@ ucc_base_coll_alg_info_t
             {.id   = UCC_TL_UCP_REDUCE_SCATTER_ALG_KNOMIAL,
              .name = "knomial",
              .desc = "recursive k-ing with arbitrary radix"},
+        [UCC_TL_UCP_REDUCE_SCATTER_ALG_ONESIDED] =
+            {.id   = UCC_TL_UCP_REDUCE_SCATTER_ALG_ONESIDED,
+             .name = "onesided",
+             .desc = "O(N) ring with put and signal"},
         [UCC_TL_UCP_REDUCE_SCATTER_ALG_LAST] = {
             .id = 0, .name = NULL, .desc = NULL}};
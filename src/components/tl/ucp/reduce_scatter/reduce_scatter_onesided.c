@@ -0,0 +1,261 @@
+/**
+ * Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "tl_ucp.h"
+#include "reduce_scatter.h"
+#include "core/ucc_progress_queue.h"
+#include "tl_ucp_sendrecv.h"
+#include "utils/ucc_math.h"
+#include "utils/ucc_dt_reduce.h"
+#include "components/mc/ucc_mc.h"
+
+/* Put-based ring reduce_scatter. Partial results travel along the ring and
+   land in the symmetric scratch of the right neighbour at the offset of the
+   block in src, so every block lands at most once per collective and no
+   receive buffer has to be recycled. At step 0 rank r puts its src block
+   (r - 1), at step i > 0 it reduces the landed block (r - 1 - i) with its own
+   src contribution and forwards the partial result. The last reduction
+   (block r) is written straight into dst. The left neighbour is the only
+   writer into the scratch of a rank and completes after the "done" signal,
+   so the scratch is no longer read once the region is given to the next
+   one-sided collective. */
+
+#define REDUCE_SCATTER_ONESIDED_RING_SIGNAL(_team)                             \
+    UCC_TL_UCP_SYM_SIGNAL(_team,                                               \
+                          UCC_TL_UCP_SYM_SIGNAL_REDUCE_SCATTER_ONESIDED)
+#define REDUCE_SCATTER_ONESIDED_DONE_SIGNAL(_team)                             \
+    UCC_TL_UCP_SYM_SIGNAL(_team,                                               \
+                          UCC_TL_UCP_SYM_SIGNAL_REDUCE_SCATTER_ONESIDED + 1)
+
+ucc_status_t ucc_tl_ucp_reduce_scatter_onesided_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task  = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team  = TASK_TEAM(task);
+    ucc_coll_args_t   *args  = &TASK_ARGS(task);
+    ucc_rank_t         tsize = UCC_TL_TEAM_SIZE(team);
+    ucc_status_t       status;
+
+    status = ucc_tl_ucp_sym_acquire(task);
+    if (ucc_unlikely(UCC_OK != status)) {
+        /* UCC_INPROGRESS: started again once the region is free */
+        return (UCC_INPROGRESS == status) ? UCC_OK : status;
+    }
+    ucc_tl_ucp_task_reset(task, UCC_INPROGRESS);
+    task->onesided.put_posted    = 0;
+    task->onesided.put_completed = 0;
+
+    if (tsize == 1) {
+        status = ucc_mc_memcpy(args->dst.info.buffer, args->src.info.buffer,
+                               args->dst.info.count *
+                                   ucc_dt_size(args->dst.info.datatype),
+                               args->dst.info.mem_type,
+                               args->src.info.mem_type);
+        if (ucc_unlikely(UCC_OK != status)) {
+            return status;
+        }
+        task->super.status = UCC_OK;
+        return ucc_task_complete(&task->super);
+    }
+
+    status = ucc_coll_task_get_executor(&task->super,
+                                        &task->reduce_scatter_onesided.executor);
+    if (ucc_unlikely(UCC_OK != status)) {
+        return status;
+    }
+
+    task->reduce_scatter_onesided.ring_base =
+        team->sym.signal_seq[UCC_TL_UCP_SYM_SIGNAL_REDUCE_SCATTER_ONESIDED];
+    task->reduce_scatter_onesided.done_base =
+        team->sym.signal_seq[UCC_TL_UCP_SYM_SIGNAL_REDUCE_SCATTER_ONESIDED + 1];
+    team->sym.signal_seq[UCC_TL_UCP_SYM_SIGNAL_REDUCE_SCATTER_ONESIDED] +=
+        tsize - 1;
+    team->sym.signal_seq[UCC_TL_UCP_SYM_SIGNAL_REDUCE_SCATTER_ONESIDED + 1] +=
+        1;
+    task->reduce_scatter_onesided.etask     = NULL;
+    task->reduce_scatter_onesided.n_sent    = 0;
+    task->reduce_scatter_onesided.n_reduced = 0;
+    task->reduce_scatter_onesided.done_sent = 0;
+
+    return ucc_tl_ucp_sym_enqueue(task);
+}
+
+/* reduce the block landed at the given step, user defined reductions
+   complete synchronously and leave etask NULL */
+static ucc_status_t
+ucc_tl_ucp_reduce_scatter_onesided_reduce(ucc_tl_ucp_task_t *task,
+                                          ucc_rank_t         step)
+{
+    ucc_tl_ucp_team_t *team  = TASK_TEAM(task);
+    ucc_coll_args_t   *args  = &TASK_ARGS(task);
+    ucc_rank_t         trank = UCC_TL_TEAM_RANK(team);
+    ucc_rank_t         tsize = UCC_TL_TEAM_SIZE(team);
+    size_t             count = args->dst.info.count;
+    size_t             data_size =
+        count * ucc_dt_size(args->dst.info.datatype);
+    ucc_rank_t         block = (trank + 2 * tsize - 1 - step) % tsize;
+    int                last  = (step == tsize - 1);
+    void              *landing =
+        PTR_OFFSET(UCC_TL_UCP_SYM_SCRATCH(team), block * data_size);
+
+    return ucc_dt_reduce(
+        PTR_OFFSET(args->src.info.buffer, block * data_size), landing,
+        last ? args->dst.info.buffer : landing, count,
+        args->dst.info.datatype, args,
+        (last && args->op == UCC_OP_AVG) ? UCC_EEE_TASK_FLAG_REDUCE_WITH_ALPHA
+                                         : 0,
+        AVG_ALPHA(task), task->reduce_scatter_onesided.executor,
+        &task->reduce_scatter_onesided.etask);
+}
+
+void ucc_tl_ucp_reduce_scatter_onesided_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task  = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team  = TASK_TEAM(task);
+    ucc_coll_args_t   *args  = &TASK_ARGS(task);
+    ucc_rank_t         trank = UCC_TL_TEAM_RANK(team);
+    ucc_rank_t         tsize = UCC_TL_TEAM_SIZE(team);
+    ucc_rank_t         right = (trank + 1) % tsize;
+    ucc_rank_t         left  = (trank - 1 + tsize) % tsize;
+    size_t             data_size =
+        args->dst.info.count * ucc_dt_size(args->dst.info.datatype);
+    volatile uint64_t *ring_signal = REDUCE_SCATTER_ONESIDED_RING_SIGNAL(team);
+    volatile uint64_t *done_signal = REDUCE_SCATTER_ONESIDED_DONE_SIGNAL(team);
+    int                polls       = 0;
+    ucc_status_t       status;
+    ucc_rank_t         step, block;
+    void              *landing;
+    int                progressed;
+
+    while (1) {
+        progressed = 0;
+        if (task->reduce_scatter_onesided.etask != NULL) {
+            status = ucc_ee_executor_task_test(
+                task->reduce_scatter_onesided.etask);
+            if (status == UCC_INPROGRESS) {
+                goto put;
+            }
+            ucc_ee_executor_task_finalize(task->reduce_scatter_onesided.etask);
+            task->reduce_scatter_onesided.etask = NULL;
+            if (ucc_unlikely(status < 0)) {
+                tl_error(UCC_TASK_LIB(task), "failure in ee task");
+                task->super.status = status;
+                return;
+            }
+            task->reduce_scatter_onesided.n_reduced++;
+            progressed = 1;
+        }
+        /* partial result of step i is landed after i ring signals */
+        step = task->reduce_scatter_onesided.n_reduced + 1;
+        if (step < tsize &&
+            *ring_signal >= task->reduce_scatter_onesided.ring_base + step) {
+            status = ucc_tl_ucp_reduce_scatter_onesided_reduce(task, step);
+            if (ucc_unlikely(UCC_OK != status)) {
+                tl_error(UCC_TASK_LIB(task), "failed to perform dt reduction");
+                task->super.status = status;
+                return;
+            }
+            if (task->reduce_scatter_onesided.etask == NULL) {
+                task->reduce_scatter_onesided.n_reduced++;
+            }
+            progressed = 1;
+        }
+put:
+        step = task->reduce_scatter_onesided.n_sent;
+        if (step < tsize - 1 && step <= task->reduce_scatter_onesided.n_reduced) {
+            block   = (trank + 2 * tsize - 1 - step) % tsize;
+            landing = PTR_OFFSET(UCC_TL_UCP_SYM_SCRATCH(team),
+                                 block * data_size);
+            UCPCHECK_GOTO(
+                ucc_tl_ucp_put_signal_nb(
+                    step == 0 ? PTR_OFFSET(args->src.info.buffer,
+                                           block * data_size)
+                              : landing,
+                    landing, data_size, (void *)ring_signal, right, team, task),
+                task, out);
+            task->reduce_scatter_onesided.n_sent++;
+            progressed = 1;
+        }
+        if (!task->reduce_scatter_onesided.done_sent &&
+            task->reduce_scatter_onesided.n_sent == tsize - 1 &&
+            task->reduce_scatter_onesided.n_reduced == tsize - 1 &&
+            UCC_TL_UCP_TASK_ONESIDED_P2P_COMPLETE(task)) {
+            UCPCHECK_GOTO(ucc_tl_ucp_put_signal_nb(NULL, NULL, 0,
+                                                   (void *)done_signal, left,
+                                                   team, task),
+                          task, out);
+            task->reduce_scatter_onesided.done_sent = 1;
+        }
+        if (task->reduce_scatter_onesided.done_sent &&
+            UCC_TL_UCP_TASK_ONESIDED_P2P_COMPLETE(task) &&
+            *done_signal >= task->reduce_scatter_onesided.done_base + 1) {
+            task->super.status = UCC_OK;
+            return;
+        }
+        if (!progressed) {
+            if (polls++ >= task->n_polls) {
+                return;
+            }
+            ucp_worker_progress(UCC_TL_UCP_TEAM_CTX(team)->worker.ucp_worker);
+        }
+    }
+out:
+    if (task->reduce_scatter_onesided.etask != NULL) {
+        /* don't fail the task while workers still write scratch and dst */
+        ucc_ee_executor_task_finalize(task->reduce_scatter_onesided.etask);
+        task->reduce_scatter_onesided.etask = NULL;
+    }
+    return;
+}
+
+ucc_status_t
+ucc_tl_ucp_reduce_scatter_onesided_init(ucc_base_coll_args_t *coll_args,
+                                        ucc_base_team_t      *team,
+                                        ucc_coll_task_t     **task_h)
+{
+    ucc_tl_ucp_team_t *tl_team = ucc_derived_of(team, ucc_tl_ucp_team_t);
+    ucc_rank_t         tsize   = UCC_TL_TEAM_SIZE(tl_team);
+    size_t             src_size =
+        coll_args->args.dst.info.count * tsize *
+        ucc_dt_size(coll_args->args.dst.info.datatype);
+    ucc_tl_ucp_task_t *task;
+
+    if (UCC_TL_UCP_TEAM_LIB(tl_team)->cfg.reduce_avg_pre_op &&
+        coll_args->args.op == UCC_OP_AVG) {
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    if (UCC_IS_INPLACE(coll_args->args)) {
+        tl_debug(UCC_TL_TEAM_LIB(tl_team),
+                 "inplace onesided reduce_scatter is not supported");
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    if (tsize > 1) {
+        if (!UCC_TL_UCP_TEAM_HAS_SYM(tl_team)) {
+            tl_debug(UCC_TL_TEAM_LIB(tl_team),
+                     "symmetric memory is not available on team");
+            return UCC_ERR_NOT_SUPPORTED;
+        }
+        if (coll_args->args.src.info.mem_type != UCC_MEMORY_TYPE_HOST ||
+            coll_args->args.dst.info.mem_type != UCC_MEMORY_TYPE_HOST) {
+            tl_debug(UCC_TL_TEAM_LIB(tl_team),
+                     "onesided reduce_scatter supports only host memory");
+            return UCC_ERR_NOT_SUPPORTED;
+        }
+        if (src_size > UCC_TL_UCP_SYM_SCRATCH_SIZE(tl_team)) {
+            tl_debug(UCC_TL_TEAM_LIB(tl_team),
+                     "message size %zd exceeds symmetric scratch size %zd",
+                     src_size, UCC_TL_UCP_SYM_SCRATCH_SIZE(tl_team));
+            return UCC_ERR_NOT_SUPPORTED;
+        }
+    }
+
+    task                 = ucc_tl_ucp_init_task(coll_args, team);
+    task->super.post     = ucc_tl_ucp_reduce_scatter_onesided_start;
+    task->super.progress = ucc_tl_ucp_reduce_scatter_onesided_progress;
+    task->super.flags   |= UCC_COLL_TASK_FLAG_EXECUTOR;
+    *task_h              = &task->super;
+    return UCC_OK;
+}
@@ -32,6 +32,13 @@ ucc_status_t ucc_tl_ucp_get_lib_properties(ucc_base_lib_properties_t *prop);
 ucc_status_t ucc_tl_ucp_get_context_attr(const ucc_base_context_t *context,
                                          ucc_base_ctx_attr_t      *base_attr);
 
+static const char *ucc_tl_ucp_onesided_peer_orders[] = {
+    [UCC_TL_UCP_ONESIDED_PEER_ORDER_SHIFT]  = "shift",
+    [UCC_TL_UCP_ONESIDED_PEER_ORDER_XOR]    = "xor",
+    [UCC_TL_UCP_ONESIDED_PEER_ORDER_LINEAR] = "linear",
+    [UCC_TL_UCP_ONESIDED_PEER_ORDER_LAST]   = NULL
+};
+
 ucc_config_field_t ucc_tl_ucp_lib_config_table[] = {
     {"", "", NULL, ucc_offsetof(ucc_tl_ucp_lib_config_t, super),
      UCC_CONFIG_TYPE_TABLE(ucc_tl_lib_config_table)},
@@ -48,6 +55,30 @@ ucc_config_field_t ucc_tl_ucp_lib_config_table[] = {
      ucc_offsetof(ucc_tl_ucp_lib_config_t, alltoallv_pairwise_num_posts),
      UCC_CONFIG_TYPE_ULUNITS},
 
+    {"ALLTOALL_ONESIDED_NUM_POSTS", "auto",
+     "Maximum number of outstanding puts in alltoall onesided algorithm, "
+     "the rest of the peers are issued as the puts complete. "
+     "inf - issue all the puts at once",
+     ucc_offsetof(ucc_tl_ucp_lib_config_t, alltoall_onesided_num_posts),
+     UCC_CONFIG_TYPE_ULUNITS},
+
+    {"ALLTOALLV_ONESIDED_NUM_POSTS", "auto",
+     "Maximum number of outstanding puts in alltoallv onesided algorithm, "
+     "the rest of the peers are issued as the puts complete. "
+     "inf - issue all the puts at once",
+     ucc_offsetof(ucc_tl_ucp_lib_config_t, alltoallv_onesided_num_posts),
+     UCC_CONFIG_TYPE_ULUNITS},
+
+    {"ONESIDED_PEER_ORDER", "shift",
+     "Order in which alltoall and alltoallv onesided algorithms visit peers\n"
+     "shift  - start from the next rank, so that at every step each rank is "
+     "targeted by a single peer\n"
+     "xor    - pairwise exchange rank ^ step, for power of 2 teams, other "
+     "team sizes use shift\n"
+     "linear - all ranks start from rank 0",
+     ucc_offsetof(ucc_tl_ucp_lib_config_t, onesided_peer_order),
+     UCC_CONFIG_TYPE_ENUM(ucc_tl_ucp_onesided_peer_orders)},
+
 /* TODO: add radix to config once it's fully supported by the algorithm
     {"ALLTOALLV_HYBRID_RADIX", "2",
      "Radix of the Hybrid Alltoallv algorithm",
@@ -121,6 +152,29 @@ ucc_config_field_t ucc_tl_ucp_lib_config_table[] = {
                   allreduce_sliding_window_num_get_bufs),
      UCC_CONFIG_TYPE_UINT},
 
+    {"ALLREDUCE_CYX_CHUNK_SIZE", "256k",
+     "Size of the chunks each block of the cyx allreduce is split into. "
+     "Transfer of a chunk overlaps with reduction of the previous one",
+     ucc_offsetof(ucc_tl_ucp_lib_config_t, allreduce_cyx_chunk_size),
+     UCC_CONFIG_TYPE_MEMUNITS},
+
+    {"ALLREDUCE_CYX_BIDIRECTIONAL", "y",
+     "Launch 2 inverted rings concurrently during cyx Allreduce algorithm",
+     ucc_offsetof(ucc_tl_ucp_lib_config_t, allreduce_cyx_bidirectional),
+     UCC_CONFIG_TYPE_BOOL},
+
+    {"ALLREDUCE_CYX_HIERARCHICAL", "n",
+     "Use two-level cyx Allreduce on multi-node teams: reduce-scatter within "
+     "the node, a ring per local rank across nodes, allgather within the node",
+     ucc_offsetof(ucc_tl_ucp_lib_config_t, allreduce_cyx_hierarchical),
+     UCC_CONFIG_TYPE_BOOL},
+
+    {"ALLREDUCE_CYX_RING_ALLGATHER", "y",
+     "Forward the reduced blocks of cyx Allreduce along the ring instead of "
+     "putting them to every rank from their owner",
+     ucc_offsetof(ucc_tl_ucp_lib_config_t, allreduce_cyx_ring_allgather),
+     UCC_CONFIG_TYPE_BOOL},
+
     {"ALLREDUCE_SRA_KN_RADIX", "auto",
      "Radix of the scatter-reduce-allgather (SRA) knomial allreduce algorithm",
      ucc_offsetof(ucc_tl_ucp_lib_config_t, allreduce_sra_kn_radix),
@@ -206,6 +260,28 @@ ucc_config_field_t ucc_tl_ucp_lib_config_table[] = {
      ucc_offsetof(ucc_tl_ucp_lib_config_t, use_reordering),
      UCC_CONFIG_TYPE_BOOL},
 
+    {"ONESIDED_SCRATCH_SIZE", "0",
+     "Size of the symmetric scratch region allocated and registered by the "
+     "library for one-sided algorithms (cyx allreduce, one-sided allgather, "
+     "reduce_scatter and bcast) on every team. The region is only created "
+     "when the context is initialized with memory mapping params. "
+     "0 - disable, one-sided algorithms needing it are not available",
+     ucc_offsetof(ucc_tl_ucp_lib_config_t, onesided_scratch_size),
+     UCC_CONFIG_TYPE_MEMUNITS},
+
+    {"ONESIDED_HEAP_SIZE", "0",
+     "Size of the symmetric heap served by ucc_team_mem_alloc on every team. "
+     "It is registered and exchanged together with the symmetric scratch "
+     "region. 0 - disable",
+     ucc_offsetof(ucc_tl_ucp_lib_config_t, onesided_heap_size),
+     UCC_CONFIG_TYPE_MEMUNITS},
+
+    {"ONESIDED_EAGER_RKEY_UNPACK", "n",
+     "Unpack remote keys of all mapped memory segments of every team member "
+     "during team creation instead of on first one-sided access",
+     ucc_offsetof(ucc_tl_ucp_lib_config_t, onesided_eager_rkey_unpack),
+     UCC_CONFIG_TYPE_BOOL},
+
     {NULL}};
 
 static ucs_config_field_t ucc_tl_ucp_context_config_table[] = {
@@ -232,6 +308,14 @@ static ucs_config_field_t ucc_tl_ucp_context_config_table[] = {
      ucc_offsetof(ucc_tl_ucp_context_config_t, pre_reg_mem),
      UCC_CONFIG_TYPE_UINT},
 
+    {"RCACHE", "n",
+     "Register user buffers targeted by one-sided collectives on first use "
+     "and cache the registrations until the memory is released. Allows "
+     "one-sided algorithms on buffers that were not mapped with "
+     "ucc_mem_map, enables RMA on the ucp context",
+     ucc_offsetof(ucc_tl_ucp_context_config_t, rcache),
+     UCC_CONFIG_TYPE_BOOL},
+
     {"SERVICE_WORKER", "n",
      "If set to 0, uses the same worker for collectives and "
      "service. If not, creates a special worker for service collectives "
@@ -246,6 +330,26 @@ static ucs_config_field_t ucc_tl_ucp_context_config_table[] = {
      ucc_offsetof(ucc_tl_ucp_context_config_t, service_throttling_thresh),
      UCC_CONFIG_TYPE_UINT},
 
+    {"WAKEUP", "n",
+     "Create ucp workers with wakeup support, required by ucc_context_wait "
+     "to block on the worker event fd instead of busy polling. Transports "
+     "without event support may become unavailable when enabled",
+     ucc_offsetof(ucc_tl_ucp_context_config_t, wakeup),
+     UCC_CONFIG_TYPE_BOOL},
+
+    {"NPOLLS_ADAPTIVE", "n",
+     "Adapt the number of polling cycles of p2p requests testing at runtime: "
+     "NPOLLS is split among the outstanding collectives of the context, a "
+     "single outstanding collective polls up to NPOLLS_MAX cycles and the "
+     "budget is halved on every test that observed no completion",
+     ucc_offsetof(ucc_tl_ucp_context_config_t, npolls_adaptive),
+     UCC_CONFIG_TYPE_BOOL},
+
+    {"NPOLLS_MAX", "100",
+     "Max number of polling cycles used by adaptive polling",
+     ucc_offsetof(ucc_tl_ucp_context_config_t, npolls_max),
+     UCC_CONFIG_TYPE_UINT},
+
     {NULL}};
 
 UCC_CLASS_DEFINE_NEW_FUNC(ucc_tl_ucp_lib_t, ucc_base_lib_t,
@@ -349,6 +453,10 @@ __attribute__((constructor)) static void tl_ucp_iface_init(void)
     ucc_tl_ucp.super.scoll.allreduce = ucc_tl_ucp_service_allreduce;
     ucc_tl_ucp.super.scoll.bcast     = ucc_tl_ucp_service_bcast;
     ucc_tl_ucp.super.scoll.update_id = ucc_tl_ucp_service_update_id;
+    ucc_tl_ucp.super.team.mem_alloc  = ucc_tl_ucp_team_mem_alloc;
+    ucc_tl_ucp.super.team.mem_free   = ucc_tl_ucp_team_mem_free;
+    ucc_tl_ucp.super.context.get_event_fd = ucc_tl_ucp_context_get_event_fd;
+    ucc_tl_ucp.super.context.arm          = ucc_tl_ucp_context_arm;
 
     ucc_tl_ucp.super.alg_info[ucc_ilog2(UCC_COLL_TYPE_ALLGATHER)] =
         ucc_tl_ucp_allgather_algs;
@@ -10,11 +10,13 @@
 #include "components/tl/ucc_tl_log.h"
 #include "core/ucc_ee.h"
 #include "utils/ucc_mpool.h"
+#include "utils/ucc_rcache.h"
 #include "tl_ucp_ep_hash.h"
 #include "schedule/ucc_schedule_pipelined.h"
 #include <ucp/api/ucp.h>
 #include <ucs/memory/memory_type.h>
 #include "core/ucc_service_coll.h"
+#include "utils/arch/cpu.h"
 
 #ifndef UCC_TL_UCP_DEFAULT_SCORE
 #define UCC_TL_UCP_DEFAULT_SCORE 10
@@ -33,12 +35,27 @@
 #define UCC_TL_UCP_PROFILE_REQUEST_FREE UCC_PROFILE_REQUEST_FREE
 
 #define MAX_NR_SEGMENTS 32
-#define ONESIDED_SYNC_SIZE 1
-#define ONESIDED_REDUCE_SIZE 4
+/* sync words of the global work buffer: signal counters of even and odd
+   calls and the number of completed calls, see UCC_TL_UCP_TASK_ONESIDED_SYNC */
+#define ONESIDED_SYNC_SIZE 3
+#define ONESIDED_REDUCE_SIZE 2
+
+#define UCC_TL_UCP_SYM_PACKED_KEY_MAX_LEN 1024
+#define UCC_TL_UCP_SYM_SIGNALS_SIZE       4096
+#define UCC_TL_UCP_SYM_N_SIGNALS                                               \
+    (UCC_TL_UCP_SYM_SIGNALS_SIZE / UCC_CACHE_LINE_SIZE)
 
 typedef struct ucc_tl_ucp_iface {
     ucc_tl_iface_t super;
 } ucc_tl_ucp_iface_t;
+
+/* Order in which one-sided alltoall(v) visits the peers */
+typedef enum ucc_tl_ucp_onesided_peer_order {
+    UCC_TL_UCP_ONESIDED_PEER_ORDER_SHIFT, /* rank + 1, rank + 2, ... */
+    UCC_TL_UCP_ONESIDED_PEER_ORDER_XOR,   /* rank ^ 1, rank ^ 2, ... */
+    UCC_TL_UCP_ONESIDED_PEER_ORDER_LINEAR,/* 0, 1, ... */
+    UCC_TL_UCP_ONESIDED_PEER_ORDER_LAST
+} ucc_tl_ucp_onesided_peer_order_t;
 /* Extern iface should follow the pattern: ucc_tl_<tl_name> */
 extern ucc_tl_ucp_iface_t ucc_tl_ucp;
 
@@ -51,6 +68,10 @@ typedef struct ucc_tl_ucp_lib_config {
     size_t                   allreduce_sliding_window_buf_size;
     uint32_t                 allreduce_sliding_window_put_window_size;
     uint32_t                 allreduce_sliding_window_num_get_bufs;
+    size_t                   allreduce_cyx_chunk_size;
+    int                      allreduce_cyx_bidirectional;
+    int                      allreduce_cyx_hierarchical;
+    int                      allreduce_cyx_ring_allgather;
     ucc_mrange_uint_t        allreduce_kn_radix;
     ucc_mrange_uint_t        allreduce_sra_kn_radix;
     uint32_t                 reduce_scatter_kn_radix;
@@ -65,6 +86,9 @@ typedef struct ucc_tl_ucp_lib_config {
     uint32_t                 scatterv_linear_num_posts;
     unsigned long            alltoall_pairwise_num_posts;
     unsigned long            alltoallv_pairwise_num_posts;
+    unsigned long            alltoall_onesided_num_posts;
+    unsigned long            alltoallv_onesided_num_posts;
+    ucc_tl_ucp_onesided_peer_order_t onesided_peer_order;
     ucc_pipeline_params_t    allreduce_sra_kn_pipeline;
     int                      reduce_avg_pre_op;
     int                      reduce_scatter_ring_bidirectional;
@@ -77,6 +101,9 @@ typedef struct ucc_tl_ucp_lib_config {
     uint32_t                 alltoallv_hybrid_pairwise_num_posts;
     ucc_ternary_auto_value_t use_topo;
     int                      use_reordering;
+    size_t                   onesided_scratch_size;
+    size_t                   onesided_heap_size;
+    int                      onesided_eager_rkey_unpack;
 } ucc_tl_ucp_lib_config_t;
 
 typedef struct ucc_tl_ucp_context_config {
@@ -85,8 +112,12 @@ typedef struct ucc_tl_ucp_context_config {
     uint32_t                n_polls;
     uint32_t                oob_npolls;
     uint32_t                pre_reg_mem;
+    int                     rcache;
     uint32_t                service_worker;
     uint32_t                service_throttling_thresh;
+    int                     wakeup;
+    int                     npolls_adaptive;
+    uint32_t                npolls_max;
 } ucc_tl_ucp_context_config_t;
 
 typedef ucc_tl_ucp_lib_config_t ucc_tl_ucp_team_config_t;
@@ -107,6 +138,55 @@ typedef struct ucc_tl_ucp_remote_info {
     size_t packed_key_len;
 } ucc_tl_ucp_remote_info_t;
 
+/* Registration of a user buffer accessed by one-sided collectives without
+   being mapped by ucc_mem_map. Cached by the context until the memory is
+   released, rkey is packed once together with the registration */
+typedef struct ucc_tl_ucp_rcache_region {
+    ucc_rcache_region_t super;
+    ucp_mem_h           memh;
+    void               *packed_key;
+    size_t              packed_key_len;
+} ucc_tl_ucp_rcache_region_t;
+
+typedef struct ucc_tl_ucp_sym_info {
+    uint64_t va_base;
+    uint64_t packed_key_len;
+    char     packed_key[UCC_TL_UCP_SYM_PACKED_KEY_MAX_LEN];
+} ucc_tl_ucp_sym_info_t;
+
+typedef struct ucc_tl_ucp_sym_heap_block {
+    size_t offset; /* from the heap start */
+    size_t size;
+    int    used;
+} ucc_tl_ucp_sym_heap_block_t;
+
+/* Team-wide symmetric memory region owned by the library. It starts with
+   UCC_TL_UCP_SYM_N_SIGNALS cache line aligned signal words followed by
+   scratch space and the symmetric heap served by ucc_team_mem_alloc.
+   Packed rkeys of all team members are exchanged during team creation,
+   remote rkeys are unpacked on first use.
+   Signal words are never reset: peers only add to them and signal_seq keeps
+   the number of arrivals already consumed locally per signal, so a collective
+   waits for signal_seq + expected arrivals. */
+typedef struct ucc_tl_ucp_sym_mem {
+    void                   *va_base;
+    size_t                  len;
+    ucp_mem_h               memh;
+    ucc_tl_ucp_sym_info_t  *info; /* team_size + 1 entries, last is local */
+    ucp_rkey_h             *rkeys;
+    ucc_service_coll_req_t *req;
+    uint64_t                signal_seq[UCC_TL_UCP_SYM_N_SIGNALS];
+    /* one-sided collective currently using the signals and scratch */
+    ucc_coll_task_t        *owner;
+    /* collectives waiting for the owner to complete, in post order */
+    ucc_list_link_t         waiters;
+    size_t                  heap_offset;
+    /* heap blocks sorted by offset, allocated on first use */
+    ucc_tl_ucp_sym_heap_block_t *heap;
+    unsigned                     n_heap_blocks;
+    unsigned                     max_heap_blocks;
+} ucc_tl_ucp_sym_mem_t;
+
 typedef struct ucc_tl_ucp_worker {
     ucp_context_h     ucp_context;
     ucp_worker_h      ucp_worker;
@@ -116,6 +196,15 @@ typedef struct ucc_tl_ucp_worker {
     ucp_ep_h *        eps;
 } ucc_tl_ucp_worker_t;
 
+/* polling budgets chosen by adaptive polling, updated atomically in
+   multithreaded mode */
+typedef struct ucc_tl_ucp_npolls_stats {
+    uint64_t n_updates;
+    uint64_t total;
+    uint32_t min;
+    uint32_t max;
+} ucc_tl_ucp_npolls_stats_t;
+
 typedef struct ucc_tl_ucp_context {
     ucc_tl_context_t            super;
     ucc_tl_ucp_context_config_t cfg;
@@ -123,11 +212,14 @@ typedef struct ucc_tl_ucp_context {
     ucc_tl_ucp_worker_t         service_worker;
     uint32_t                    service_worker_throttling_count;
     ucc_mpool_t                 req_mp;
+    ucc_mpool_t                 put_signal_mp;
     ucc_tl_ucp_remote_info_t *  remote_info;
     ucp_rkey_h *                rkeys;
     uint64_t                    n_rinfo_segs;
+    ucc_rcache_t               *rcache;
     uint64_t                    ucp_memory_types;
     int                         topo_required;
+    ucc_tl_ucp_npolls_stats_t   npolls_stats;
 } ucc_tl_ucp_context_t;
 UCC_CLASS_DECLARE(ucc_tl_ucp_context_t, const ucc_base_context_params_t *,
                   const ucc_base_config_t *);
@@ -140,12 +232,17 @@ typedef struct ucc_tl_ucp_team {
     ucc_tl_ucp_task_t         *preconnect_task;
     void *                     va_base[MAX_NR_SEGMENTS];
     size_t                     base_length[MAX_NR_SEGMENTS];
+    uint64_t *                 seg_rvas;  /* remote segment base per peer */
+    ucp_rkey_h *               seg_rkeys; /* per peer, owned by context */
     ucc_tl_ucp_worker_t *      worker;
     ucc_tl_ucp_team_config_t   cfg;
     const char *               tuning_str;
     ucc_topo_t                *topo;
     ucc_ep_map_t               ctx_map;
     ucc_rank_t                 opt_radix;
+    ucc_tl_ucp_sym_mem_t       sym;
+    /* protects sym heap blocks, taken only in UCC_THREAD_MULTIPLE */
+    ucc_spinlock_t             sym_heap_lock;
 } ucc_tl_ucp_team_t;
 UCC_CLASS_DECLARE(ucc_tl_ucp_team_t, ucc_base_context_t *,
                   const ucc_base_team_params_t *);
@@ -193,6 +290,37 @@ extern ucc_config_field_t ucc_tl_ucp_lib_config_table[];
 #define UCC_TL_UCP_REMOTE_RKEY(_ctx, _rank, _seg)                              \
     ((_ctx)->rkeys[_rank * _ctx->n_rinfo_segs + _seg])
 
+/* Index of team peer memory segment in team seg_rvas/seg_rkeys */
+#define UCC_TL_UCP_TEAM_SEG_IDX(_team, _peer, _seg)                            \
+    ((_peer) * UCC_TL_UCP_TEAM_CTX(_team)->n_rinfo_segs + (_seg))
+
+#define UCC_TL_UCP_TEAM_HAS_SYM(_team) ((_team)->sym.rkeys != NULL)
+
+#define UCC_TL_UCP_SYM_SIGNAL(_team, _idx)                                     \
+    ((volatile uint64_t *)PTR_OFFSET((_team)->sym.va_base,                     \
+                                     (_idx) * UCC_CACHE_LINE_SIZE))
+
+/* Signal words owned by the one-sided algorithms, each one uses the words
+   from the given index up to the next one: bcast three, the others two.
+   Words 0 .. 9 are used by allreduce cyx rings. */
+#define UCC_TL_UCP_SYM_SIGNAL_ALLGATHER_ONESIDED      10
+#define UCC_TL_UCP_SYM_SIGNAL_REDUCE_SCATTER_ONESIDED 12
+#define UCC_TL_UCP_SYM_SIGNAL_BCAST_ONESIDED          14
+#define UCC_TL_UCP_SYM_SIGNAL_ALLTOALL_ONESIDED       17
+#define UCC_TL_UCP_SYM_SIGNAL_ALLTOALLV_ONESIDED      19
+
+#define UCC_TL_UCP_SYM_SCRATCH(_team)                                          \
+    PTR_OFFSET((_team)->sym.va_base, UCC_TL_UCP_SYM_SIGNALS_SIZE)
+
+#define UCC_TL_UCP_SYM_SCRATCH_SIZE(_team)                                     \
+    ((_team)->sym.heap_offset - UCC_TL_UCP_SYM_SIGNALS_SIZE)
+
+#define UCC_TL_UCP_SYM_HEAP(_team)                                             \
+    PTR_OFFSET((_team)->sym.va_base, (_team)->sym.heap_offset)
+
+#define UCC_TL_UCP_SYM_HEAP_SIZE(_team)                                        \
+    ((_team)->sym.len - (_team)->sym.heap_offset)
+
 extern ucs_memory_type_t ucc_memtype_to_ucs[UCC_MEMORY_TYPE_LAST+1];
 
 void ucc_tl_ucp_pre_register_mem(ucc_tl_ucp_team_t *team, void *addr,
@@ -201,4 +329,31 @@ void ucc_tl_ucp_pre_register_mem(ucc_tl_ucp_team_t *team, void *addr,
 ucc_status_t ucc_tl_ucp_ctx_remote_populate(ucc_tl_ucp_context_t *ctx,
                                             ucc_mem_map_params_t  map,
                                             ucc_team_oob_coll_t   oob);
+
+ucc_status_t ucc_tl_ucp_rinfo_destroy(ucc_tl_ucp_context_t *ctx);
+
+ucc_status_t ucc_tl_ucp_rcache_create(ucc_tl_ucp_context_t *ctx);
+
+void ucc_tl_ucp_rcache_destroy(ucc_tl_ucp_context_t *ctx);
+
+ucc_status_t ucc_tl_ucp_rcache_get(ucc_tl_ucp_context_t *ctx, void *addr,
+                                   size_t length, ucc_memory_type_t mem_type,
+                                   ucc_tl_ucp_rcache_region_t **region);
+
+void ucc_tl_ucp_rcache_put(ucc_tl_ucp_context_t       *ctx,
+                           ucc_tl_ucp_rcache_region_t *region);
+
+ucc_status_t ucc_tl_ucp_sym_mem_exchange(ucc_tl_ucp_team_t *team);
+
+void ucc_tl_ucp_sym_mem_cleanup(ucc_tl_ucp_team_t *team);
+
+ucc_status_t ucc_tl_ucp_team_mem_alloc(ucc_base_team_t *tl_team, size_t size,
+                                       void **buffer);
+
+ucc_status_t ucc_tl_ucp_team_mem_free(ucc_base_team_t *tl_team, void *buffer);
+
+ucc_status_t ucc_tl_ucp_context_get_event_fd(ucc_base_context_t *context,
+                                             int                *fd);
+
+ucc_status_t ucc_tl_ucp_context_arm(ucc_base_context_t *context);
 #endif
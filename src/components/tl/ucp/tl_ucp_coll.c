@@ -6,6 +6,7 @@
 
 #include "tl_ucp.h"
 #include "tl_ucp_coll.h"
+#include "tl_ucp_sendrecv.h"
 #include "components/mc/ucc_mc.h"
 #include "core/ucc_team.h"
 #include "barrier/barrier.h"
@@ -119,6 +120,74 @@ void ucc_tl_ucp_put_completion_cb(void *request, ucs_status_t status,
     ucp_request_free(request);
 }
 
+ucc_status_t ucc_tl_ucp_put_signal_post(ucc_tl_ucp_put_signal_t *sig)
+{
+    ucc_tl_ucp_task_t  *task      = sig->task;
+    ucp_request_param_t req_param = {0};
+    uint64_t            one       = 1;
+    ucs_status_ptr_t    ucp_status;
+
+    req_param.op_attr_mask = UCP_OP_ATTR_FIELD_CALLBACK |
+                             UCP_OP_ATTR_FIELD_USER_DATA |
+                             UCP_OP_ATTR_FIELD_DATATYPE;
+    req_param.cb.send      = ucc_tl_ucp_put_completion_cb;
+    req_param.user_data    = (void *)task;
+    req_param.datatype     = ucp_dt_make_contig(sizeof(uint64_t));
+
+    ucp_status = ucp_atomic_op_nbx(sig->ep, UCP_ATOMIC_OP_ADD, &one, 1,
+                                   sig->rva, sig->rkey, &req_param);
+    ucc_mpool_put(sig);
+    if (UCS_OK != ucp_status) {
+        if (UCS_PTR_IS_ERR(ucp_status)) {
+            return ucs_status_to_ucc_status(UCS_PTR_STATUS(ucp_status));
+        }
+    } else {
+        task->onesided.put_completed++;
+    }
+    return UCC_OK;
+}
+
+void ucc_tl_ucp_put_signal_put_cb(void *request, ucs_status_t status,
+                                  void *user_data)
+{
+    ucc_tl_ucp_task_t *task = (ucc_tl_ucp_task_t *)user_data;
+
+    if (ucc_unlikely(UCS_OK != status)) {
+        tl_error(UCC_TASK_LIB(task), "failure in put with signal %s",
+                 ucs_status_string(status));
+        task->super.status = ucs_status_to_ucc_status(status);
+    }
+    ucp_request_free(request);
+}
+
+void ucc_tl_ucp_put_signal_flush_cb(void *request, ucs_status_t status,
+                                    void *user_data)
+{
+    ucc_tl_ucp_put_signal_t *sig  = (ucc_tl_ucp_put_signal_t *)user_data;
+    ucc_tl_ucp_task_t       *task = sig->task;
+    ucc_status_t             st;
+
+    if (ucc_unlikely(UCS_OK != status)) {
+        tl_error(UCC_TASK_LIB(task), "failure in put with signal flush %s",
+                 ucs_status_string(status));
+        task->super.status = ucs_status_to_ucc_status(status);
+    }
+    if (ucc_unlikely(task->super.status < 0)) {
+        /* flush or a put of the task failed, don't signal partial data */
+        task->onesided.put_completed++;
+        ucc_mpool_put(sig);
+    } else {
+        st = ucc_tl_ucp_put_signal_post(sig);
+        if (ucc_unlikely(UCC_OK != st)) {
+            tl_error(UCC_TASK_LIB(task), "failed to post signal of put: %s",
+                     ucc_status_string(st));
+            task->super.status = st;
+            task->onesided.put_completed++;
+        }
+    }
+    ucp_request_free(request);
+}
+
 void ucc_tl_ucp_get_completion_cb(void *request, ucs_status_t status,
                                   void *user_data)
 {
@@ -132,6 +201,53 @@ void ucc_tl_ucp_get_completion_cb(void *request, ucs_status_t status,
     ucp_request_free(request);
 }
 
+static void ucc_tl_ucp_sym_wait_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team = TASK_TEAM(task);
+    ucc_status_t       status;
+
+    if (ucc_list_head(&team->sym.waiters, ucc_tl_ucp_task_t, sym_wait_elem) !=
+            task ||
+        !ucc_tl_ucp_sym_is_free(task)) {
+        return;
+    }
+    ucc_list_del(&task->sym_wait_elem);
+    team->sym.owner      = UCC_TL_UCP_SYM_OWNER(task);
+    task->flags          = (task->flags & ~UCC_TL_UCP_TASK_FLAG_SYM_WAIT) |
+                           UCC_TL_UCP_TASK_FLAG_SYM_RESTART;
+    task->super.progress = task->sym_progress;
+    status               = task->super.post(&task->super);
+    task->flags &= ~UCC_TL_UCP_TASK_FLAG_SYM_RESTART;
+    if (ucc_unlikely(UCC_OK != status)) {
+        task->super.status = status;
+    }
+}
+
+ucc_status_t ucc_tl_ucp_sym_defer(ucc_tl_ucp_task_t *task)
+{
+    ucc_tl_ucp_team_t *team = TASK_TEAM(task);
+    ucc_status_t       status;
+
+    tl_debug(UCC_TASK_LIB(task),
+             "one-sided collective %p is in progress on team %p, task %p "
+             "waits for it", team->sym.owner, team, task);
+    ucc_tl_ucp_task_reset(task, UCC_INPROGRESS);
+    ucc_list_add_tail(&team->sym.waiters, &task->sym_wait_elem);
+    task->flags         |= UCC_TL_UCP_TASK_FLAG_SYM_WAIT;
+    task->sym_progress   = task->super.progress;
+    task->super.progress = ucc_tl_ucp_sym_wait_progress;
+    status = ucc_progress_queue_enqueue(UCC_TL_CORE_CTX(team)->pq,
+                                        &task->super);
+    if (ucc_unlikely(UCC_OK != status)) {
+        ucc_list_del(&task->sym_wait_elem);
+        task->flags         &= ~UCC_TL_UCP_TASK_FLAG_SYM_WAIT;
+        task->super.progress = task->sym_progress;
+        return status;
+    }
+    return UCC_INPROGRESS;
+}
+
 void ucc_tl_ucp_recv_completion_cb(void *request, ucs_status_t status,
                                    const ucp_tag_recv_info_t *info, /* NOLINT */
                                    void *user_data)
@@ -268,6 +384,9 @@ ucc_status_t ucc_tl_ucp_alg_id_to_init(int alg_id, const char *alg_id_str,
         case UCC_TL_UCP_ALLGATHER_ALG_SPARBIT:
             *init = ucc_tl_ucp_allgather_sparbit_init;
             break;
+        case UCC_TL_UCP_ALLGATHER_ALG_ONESIDED:
+            *init = ucc_tl_ucp_allgather_onesided_init;
+            break;
         default:
             status = UCC_ERR_INVALID_PARAM;
             break;
@@ -306,6 +425,9 @@ ucc_status_t ucc_tl_ucp_alg_id_to_init(int alg_id, const char *alg_id_str,
         case UCC_TL_UCP_BCAST_ALG_DBT:
             *init = ucc_tl_ucp_bcast_dbt_init;
             break;
+        case UCC_TL_UCP_BCAST_ALG_ONESIDED:
+            *init = ucc_tl_ucp_bcast_onesided_init;
+            break;
         default:
            status = UCC_ERR_INVALID_PARAM;
            break;
@@ -364,6 +486,9 @@ ucc_status_t ucc_tl_ucp_alg_id_to_init(int alg_id, const char *alg_id_str,
         case UCC_TL_UCP_REDUCE_SCATTER_ALG_KNOMIAL:
             *init = ucc_tl_ucp_reduce_scatter_knomial_init;
             break;
+        case UCC_TL_UCP_REDUCE_SCATTER_ALG_ONESIDED:
+            *init = ucc_tl_ucp_reduce_scatter_onesided_init;
+            break;
         default:
             status = UCC_ERR_INVALID_PARAM;
             break;
@@ -15,6 +15,7 @@
 #include "components/mc/base/ucc_mc_base.h"
 #include "components/ec/ucc_ec.h"
 #include "tl_ucp_tag.h"
+#include "utils/ucc_atomic.h"
 
 #define UCC_UUNITS_AUTO_RADIX 4
 #define UCC_TL_UCP_N_DEFAULT_ALG_SELECT_STR 8
@@ -86,6 +87,12 @@ typedef struct ucc_tl_ucp_default_alg_desc {
 enum ucc_tl_ucp_task_flags {
     /*indicates whether subset field of tl_ucp_task is set*/
     UCC_TL_UCP_TASK_FLAG_SUBSET = UCC_BIT(0),
+    /*n_polls is adapted at runtime*/
+    UCC_TL_UCP_TASK_FLAG_ADAPTIVE_POLLS = UCC_BIT(1),
+    /*task waits in team sym waiters for the symmetric region*/
+    UCC_TL_UCP_TASK_FLAG_SYM_WAIT = UCC_BIT(2),
+    /*task is started again by the progress queue once it got the region*/
+    UCC_TL_UCP_TASK_FLAG_SYM_RESTART = UCC_BIT(3),
 };
 
 typedef struct ucc_tl_ucp_allreduce_sw_pipeline
@@ -95,6 +102,22 @@ typedef struct ucc_tl_ucp_allreduce_sw_host_allgather
 typedef struct ucc_tl_ucp_dpu_offload_buf_info
     ucc_tl_ucp_dpu_offload_buf_info_t;
 
+#define UCC_TL_UCP_DYN_MEM_MAX_BUFS 2
+
+/* Target buffers of one-sided operations that are neither mapped with
+   ucc_mem_map nor part of the team symmetric region. They are registered
+   through the context registration cache, addresses and packed rkeys are
+   exchanged by an allgather that runs before the collective and peer rkeys
+   are unpacked on first use */
+typedef struct ucc_tl_ucp_dyn_mem {
+    unsigned                    n_bufs;
+    void                       *va_base[UCC_TL_UCP_DYN_MEM_MAX_BUFS];
+    size_t                      len[UCC_TL_UCP_DYN_MEM_MAX_BUFS];
+    ucc_tl_ucp_rcache_region_t *region[UCC_TL_UCP_DYN_MEM_MAX_BUFS];
+    ucc_tl_ucp_sym_info_t      *info;  /* n_bufs per rank, local ones last */
+    ucp_rkey_h                 *rkeys; /* n_bufs per rank */
+} ucc_tl_ucp_dyn_mem_t;
+
 typedef struct ucc_tl_ucp_task {
     ucc_coll_task_t super;
     uint32_t        flags;
@@ -111,10 +134,18 @@ typedef struct ucc_tl_ucp_task {
             uint32_t        put_completed;
             uint32_t        get_posted;
             uint32_t        get_completed;
+            volatile long  *sync;     /* signal word of the call, see
+                                         ucc_tl_ucp_onesided_sync_start */
+            long            sync_end; /* its value once all peers signaled */
         } onesided;
     };
     uint32_t        n_polls;
+    uint32_t        n_idle_tests;
     ucc_subset_t    subset;
+    ucc_tl_ucp_dyn_mem_t *dyn_mem;
+    int             last_seg; /* last mapped segment hit by va lookup */
+    ucc_list_link_t sym_wait_elem;
+    ucc_coll_progress_fn_t sym_progress; /* of a task waiting for sym */
     union {
         struct {
             int                     phase;
@@ -137,11 +168,25 @@ typedef struct ucc_tl_ucp_task {
             ucc_tl_ucp_dpu_offload_buf_info_t         *bufs;
         } allreduce_sliding_window;
         struct {
-            long last_pSync; // 上次 progress 完检查到的 pSync
+            uint64_t                ring_base;  // 本次操作 ring 信号的起始值
+            uint64_t                final_base; // 本次操作 final 信号的起始值
             ucc_ee_executor_t      *executor; // 用来执行 reduce 计算的 executor
-            int phase;
             ucc_ee_executor_task_t *reduce_task;
-            int atomiced_cnt; // 已经进行了多少个原子操作
+            size_t                  chunk_size; // 每个 chunk 的字节数
+            uint64_t                n_reduced; // 已经完成了几个 chunk 的 reduce
+            ucc_rank_t              reduce_step;  // 下一个要 reduce 的 chunk
+            size_t                  reduce_chunk;
+            ucc_rank_t              out_step;     // 下一个要 PUT 出去的 chunk
+            size_t                  out_chunk;
+            int                     final_signaled;
+            int                     ring;        // 第几个环（双向时反向环为 1）
+            size_t                  frag_count;  // 本环负责的元素个数
+            size_t                  frag_offset; // 本环负责部分的字节偏移
+            int                     mode;    // ALLREDUCE / RS / AG，见 allreduce_cyx.c
+            void                   *sbuf;    // 参与 reduce 的本地数据
+            size_t                  landing_offset; // landing 在对称 scratch 里的偏移
+            void                   *landing; // 左邻居的 chunk 落在 scratch 里的位置
+            ucc_rank_t              n_steps; // 环一共走几步，allgather 走环时翻倍
         } allreduce_cyx;
         struct {
             int                     phase;
@@ -172,6 +217,15 @@ typedef struct ucc_tl_ucp_task {
             ucc_ee_executor_task_t *etask;
             ucc_ee_executor_t      *executor;
         } reduce_scatterv_ring;
+        struct {
+            uint64_t                ring_base;
+            uint64_t                done_base;
+            ucc_ee_executor_t      *executor;
+            ucc_ee_executor_task_t *etask;
+            ucc_rank_t              n_sent;
+            ucc_rank_t              n_reduced;
+            int                     done_sent;
+        } reduce_scatter_onesided;
         struct {
             int                     phase;
             ucc_knomial_pattern_t   p;
@@ -204,6 +258,11 @@ typedef struct ucc_tl_ucp_task {
                                          ucc_rank_t tsize,
                                          int step);
         } allgather_ring;
+        struct {
+            uint64_t                ring_base;
+            uint64_t                ready_base;
+            ucc_rank_t              n_sent;
+        } allgather_onesided;
         struct {
             ucc_mc_buffer_header_t *scratch_header;
             size_t                  scratch_size;
@@ -221,6 +280,17 @@ typedef struct ucc_tl_ucp_task {
             ucc_dbt_single_tree_t   t2;
             int                     state;
         } bcast_dbt;
+        struct {
+            uint64_t                ready_base;
+            uint64_t                done_base;
+            uint64_t                seq;
+            uint64_t               *posted; /* fetched posted words of children */
+            ucc_rank_t              parent;
+            ucc_rank_t              n_children;
+            ucc_rank_t              n_notified;
+            uint32_t                radix;
+            int                     phase;
+        } bcast_onesided;
         struct {
             ucc_rank_t              dist;
             ucc_rank_t              max_dist;
@@ -310,6 +380,8 @@ static inline ucc_tl_ucp_task_t *ucc_tl_ucp_get_task(ucc_tl_ucp_team_t *team)
     task->super.flags       = 0;
     task->flags             = 0;
     task->n_polls           = ctx->cfg.n_polls;
+    task->dyn_mem           = NULL;
+    task->last_seg          = 0;
     task->super.team        = &team->super.super;
     task->subset.map.type   = UCC_EP_MAP_FULL;
     task->subset.map.ep_num = UCC_TL_TEAM_SIZE(team);
@@ -318,8 +390,19 @@ static inline ucc_tl_ucp_task_t *ucc_tl_ucp_get_task(ucc_tl_ucp_team_t *team)
     return task;
 }
 
+#define UCC_TL_UCP_SYM_OWNER(_task)                                            \
+    ((_task)->super.schedule ? &(_task)->super.schedule->super                 \
+                             : &(_task)->super)
+
 static inline void ucc_tl_ucp_put_task(ucc_tl_ucp_task_t *task)
 {
+    if (TASK_TEAM(task)->sym.owner == UCC_TL_UCP_SYM_OWNER(task)) {
+        TASK_TEAM(task)->sym.owner = NULL;
+    }
+    if (task->flags & UCC_TL_UCP_TASK_FLAG_SYM_WAIT) {
+        /* released before it got the region, e.g. on timeout */
+        ucc_list_del(&task->sym_wait_elem);
+    }
     UCC_TL_UCP_PROFILE_REQUEST_FREE(task);
     ucc_mpool_put(task);
 }
@@ -343,6 +426,8 @@ ucc_tl_ucp_get_schedule(ucc_tl_ucp_team_t      *team,
 
 static inline void ucc_tl_ucp_put_schedule(ucc_schedule_t *schedule)
 {
+    /* init error paths may put a schedule that was never finalized */
+    ucc_schedule_free_tasks(schedule);
     UCC_TL_UCP_PROFILE_REQUEST_FREE(schedule);
     ucc_mpool_put(schedule);
 }
@@ -354,6 +439,15 @@ ucc_status_t ucc_tl_ucp_coll_init(ucc_base_coll_args_t *coll_args,
 
 ucc_status_t ucc_tl_ucp_coll_finalize(ucc_coll_task_t *coll_task);
 
+/* Registers target buffers of the one-sided task through the context
+   registration cache and wraps the task into a schedule that exchanges their
+   addresses and rkeys within the team first. On failure task is untouched */
+ucc_status_t ucc_tl_ucp_dyn_mem_schedule_init(ucc_tl_ucp_task_t *task,
+                                              unsigned n_bufs, void **bufs,
+                                              size_t            *lens,
+                                              ucc_memory_type_t *mem_types,
+                                              ucc_coll_task_t  **task_h);
+
 static inline ucc_tl_ucp_task_t *
 ucc_tl_ucp_init_task(ucc_base_coll_args_t *coll_args, ucc_base_team_t *team)
 {
@@ -366,6 +460,11 @@ ucc_tl_ucp_init_task(ucc_base_coll_args_t *coll_args, ucc_base_team_t *team)
 
     ucc_coll_task_init(&task->super, coll_args, team);
 
+    if (UCC_TL_UCP_TEAM_CTX(tl_team)->cfg.npolls_adaptive) {
+        task->flags        |= UCC_TL_UCP_TASK_FLAG_ADAPTIVE_POLLS;
+        task->n_idle_tests  = 0;
+    }
+
     if (UCC_COLL_ARGS_ACTIVE_SET(&coll_args->args)) {
         task->tagged.tag = (coll_args->args.mask & UCC_COLL_ARGS_FIELD_TAG)
             ? coll_args->args.tag : UCC_TL_UCP_ACTIVE_SET_TAG;
@@ -392,19 +491,82 @@ ucc_tl_ucp_init_task(ucc_base_coll_args_t *coll_args, ucc_base_team_t *team)
     (((_task)->tagged.send_posted == (_task)->tagged.send_completed) &&        \
      ((_task)->tagged.recv_posted == (_task)->tagged.recv_completed))
 
+/* Adaptive polling: the NPOLLS budget is shared by the tasks in flight in
+   the progress queue of the context, a single task in flight is assumed to
+   be latency critical and gets NPOLLS_MAX. The budget is halved on every
+   consecutive test that saw no p2p completion and restored on the first
+   completion. Takes effect on the next test of the task. */
+static inline void
+ucc_tl_ucp_npolls_stats_update(ucc_tl_ucp_npolls_stats_t *stats,
+                               uint32_t n_polls, int is_mt)
+{
+    uint32_t v;
+
+    if (!is_mt) {
+        stats->min = ucc_min(stats->min, n_polls);
+        stats->max = ucc_max(stats->max, n_polls);
+        stats->total += n_polls;
+        stats->n_updates++;
+        return;
+    }
+    v = stats->min;
+    while (n_polls < v &&
+           !ucc_atomic_bool_cswap32(&stats->min, v, n_polls)) {
+        v = stats->min;
+    }
+    v = stats->max;
+    while (n_polls > v &&
+           !ucc_atomic_bool_cswap32(&stats->max, v, n_polls)) {
+        v = stats->max;
+    }
+    ucc_atomic_add64(&stats->total, n_polls);
+    ucc_atomic_add64(&stats->n_updates, 1);
+}
+
+static inline void ucc_tl_ucp_task_adapt_polls(ucc_tl_ucp_task_t *task,
+                                               int                progressed)
+{
+    ucc_tl_ucp_context_t *ctx  = TASK_CTX(task);
+    ucc_context_t        *core = UCC_TL_CORE_CTX(TASK_TEAM(task));
+    uint32_t              n_tasks, n_polls;
+
+    if (!(task->flags & UCC_TL_UCP_TASK_FLAG_ADAPTIVE_POLLS)) {
+        return;
+    }
+    task->n_idle_tests = progressed ? 0 : ucc_min(task->n_idle_tests + 1, 31);
+    n_tasks            = core->pq->n_tasks;
+    n_polls            = (n_tasks <= 1) ? ctx->cfg.npolls_max
+                                        : ctx->cfg.n_polls / n_tasks;
+    n_polls          >>= task->n_idle_tests;
+    task->n_polls      = ucc_max(n_polls, 1);
+    ucc_tl_ucp_npolls_stats_update(
+        &ctx->npolls_stats, task->n_polls,
+        core->thread_mode == UCC_THREAD_MULTIPLE);
+}
+
+#define UCC_TL_UCP_TASK_TAGGED_COMPLETED(_task)                                \
+    ((_task)->tagged.send_completed + (_task)->tagged.recv_completed)
+
+#define UCC_TL_UCP_TASK_ONESIDED_COMPLETED(_task)                              \
+    ((_task)->onesided.put_completed + (_task)->onesided.get_completed)
+
 static inline ucc_status_t ucc_tl_ucp_test(ucc_tl_ucp_task_t *task)
 {
-    int polls = 0;
+    uint32_t completed = UCC_TL_UCP_TASK_TAGGED_COMPLETED(task);
+    int      polls     = 0;
 
     if (UCC_TL_UCP_TASK_P2P_COMPLETE(task)) {
         return UCC_OK;
     }
     while (polls++ < task->n_polls) {
         if (UCC_TL_UCP_TASK_P2P_COMPLETE(task)) {
+            ucc_tl_ucp_task_adapt_polls(task, 1);
             return UCC_OK;
         }
         ucp_worker_progress(UCC_TL_UCP_TASK_TEAM(task)->worker->ucp_worker);
     }
+    ucc_tl_ucp_task_adapt_polls(
+        task, completed != UCC_TL_UCP_TASK_TAGGED_COMPLETED(task));
     return UCC_INPROGRESS;
 }
 
@@ -416,33 +578,41 @@ static inline ucc_status_t ucc_tl_ucp_test(ucc_tl_ucp_task_t *task)
 
 static inline ucc_status_t ucc_tl_ucp_test_recv(ucc_tl_ucp_task_t *task)
 {
-    int polls = 0;
+    uint32_t completed = UCC_TL_UCP_TASK_TAGGED_COMPLETED(task);
+    int      polls     = 0;
 
     if (UCC_TL_UCP_TASK_RECV_COMPLETE(task)) {
         return UCC_OK;
     }
     while (polls++ < task->n_polls) {
         if (UCC_TL_UCP_TASK_RECV_COMPLETE(task)) {
+            ucc_tl_ucp_task_adapt_polls(task, 1);
             return UCC_OK;
         }
         ucp_worker_progress(UCC_TL_UCP_TASK_TEAM(task)->worker->ucp_worker);
     }
+    ucc_tl_ucp_task_adapt_polls(
+        task, completed != UCC_TL_UCP_TASK_TAGGED_COMPLETED(task));
     return UCC_INPROGRESS;
 }
 
 static inline ucc_status_t ucc_tl_ucp_test_send(ucc_tl_ucp_task_t *task)
 {
-    int polls = 0;
+    uint32_t completed = UCC_TL_UCP_TASK_TAGGED_COMPLETED(task);
+    int      polls     = 0;
 
     if (UCC_TL_UCP_TASK_SEND_COMPLETE(task)) {
         return UCC_OK;
     }
     while (polls++ < task->n_polls) {
         if (UCC_TL_UCP_TASK_SEND_COMPLETE(task)) {
+            ucc_tl_ucp_task_adapt_polls(task, 1);
             return UCC_OK;
         }
         ucp_worker_progress(UCC_TL_UCP_TASK_TEAM(task)->worker->ucp_worker);
     }
+    ucc_tl_ucp_task_adapt_polls(
+        task, completed != UCC_TL_UCP_TASK_TAGGED_COMPLETED(task));
     return UCC_INPROGRESS;
 }
 
@@ -452,17 +622,21 @@ static inline ucc_status_t ucc_tl_ucp_test_send(ucc_tl_ucp_task_t *task)
 
 static inline ucc_status_t ucc_tl_ucp_test_ring(ucc_tl_ucp_task_t *task)
 {
-    int polls = 0;
+    uint32_t completed = UCC_TL_UCP_TASK_TAGGED_COMPLETED(task);
+    int      polls     = 0;
 
     if (UCC_TL_UCP_TASK_RING_P2P_COMPLETE(task)) {
         return UCC_OK;
     }
     while (polls++ < task->n_polls) {
         if (UCC_TL_UCP_TASK_RING_P2P_COMPLETE(task)) {
+            ucc_tl_ucp_task_adapt_polls(task, 1);
             return UCC_OK;
         }
         ucp_worker_progress(TASK_CTX(task)->worker.ucp_worker);
     }
+    ucc_tl_ucp_task_adapt_polls(
+        task, completed != UCC_TL_UCP_TASK_TAGGED_COMPLETED(task));
     return UCC_INPROGRESS;
 }
 
@@ -470,28 +644,159 @@ static inline ucc_status_t ucc_tl_ucp_test_ring(ucc_tl_ucp_task_t *task)
     (((_task)->onesided.put_posted == (_task)->onesided.put_completed) &&      \
      ((_task)->onesided.get_posted == (_task)->onesided.get_completed))
 
-#define UCC_TL_UCP_TASK_ONESIDED_SYNC_COMPLETE(_task, _end)                    \
-    (*((long *)(TASK_ARGS(_task).global_work_buffer)) == _end)
+/* Peers may signal the next call on the global work buffer while this one
+   is in progress, but not the one after it: that needs the puts of this
+   rank in the next call. Signals of even and odd calls therefore go to
+   words 0 and 1, selected by the number of calls completed on the buffer
+   which is kept in word 2 and accessed locally only. The counter of a call
+   is cleared when it completes, before this rank posts the next call. */
+#define UCC_TL_UCP_TASK_ONESIDED_SYNC(_task)                                   \
+    ((volatile long *)(TASK_ARGS(_task).global_work_buffer))
+
+#define UCC_TL_UCP_ONESIDED_SYNC_CALLS 2
+
+#define UCC_TL_UCP_TASK_ONESIDED_SYNC_COMPLETE(_task)                          \
+    (*(_task)->onesided.sync >= (_task)->onesided.sync_end)
+
+/* Selects the signal word of the call expecting n_signals puts. Without a
+   global work buffer the pair of words of the team symmetric region at idx
+   is used the same way, except that the words are never reset: a call takes
+   the word which received fewer signals so far, i.e. even and odd calls
+   alternate, and waits for the signals consumed so far plus its own. */
+static inline void ucc_tl_ucp_onesided_sync_start(ucc_tl_ucp_task_t *task,
+                                                  int idx, long n_signals)
+{
+    ucc_tl_ucp_team_t *team = TASK_TEAM(task);
+    volatile long     *sync = UCC_TL_UCP_TASK_ONESIDED_SYNC(task);
+    int                slot;
+
+    if (TASK_ARGS(task).mask & UCC_COLL_ARGS_FIELD_GLOBAL_WORK_BUFFER) {
+        task->onesided.sync =
+            sync + (sync[UCC_TL_UCP_ONESIDED_SYNC_CALLS] & 1);
+        task->onesided.sync_end = n_signals;
+        return;
+    }
+    slot = team->sym.signal_seq[idx] > team->sym.signal_seq[idx + 1];
+    task->onesided.sync =
+        (volatile long *)UCC_TL_UCP_SYM_SIGNAL(team, idx + slot);
+    task->onesided.sync_end = team->sym.signal_seq[idx + slot] + n_signals;
+    team->sym.signal_seq[idx + slot] += n_signals;
+}
 
-static inline ucc_status_t ucc_tl_ucp_test_onesided(ucc_tl_ucp_task_t *task,
-                                                    int                sync_end)
+static inline void ucc_tl_ucp_onesided_sync_consume(ucc_tl_ucp_task_t *task)
 {
-    int polls = 0;
+    if (TASK_ARGS(task).mask & UCC_COLL_ARGS_FIELD_GLOBAL_WORK_BUFFER) {
+        *task->onesided.sync = 0;
+        UCC_TL_UCP_TASK_ONESIDED_SYNC(task)[UCC_TL_UCP_ONESIDED_SYNC_CALLS]++;
+    }
+}
+
+static inline ucc_status_t ucc_tl_ucp_test_onesided(ucc_tl_ucp_task_t *task)
+{
+    uint32_t completed = UCC_TL_UCP_TASK_ONESIDED_COMPLETED(task);
+    int      polls     = 0;
 
     if (UCC_TL_UCP_TASK_ONESIDED_P2P_COMPLETE(task) &&
-        UCC_TL_UCP_TASK_ONESIDED_SYNC_COMPLETE(task, sync_end)) {
+        UCC_TL_UCP_TASK_ONESIDED_SYNC_COMPLETE(task)) {
         return UCC_OK;
     }
     while (polls++ < task->n_polls) {
         if (UCC_TL_UCP_TASK_ONESIDED_P2P_COMPLETE(task) &&
-            UCC_TL_UCP_TASK_ONESIDED_SYNC_COMPLETE(task, sync_end)) {
+            UCC_TL_UCP_TASK_ONESIDED_SYNC_COMPLETE(task)) {
+            ucc_tl_ucp_task_adapt_polls(task, 1);
             return UCC_OK;
         }
         ucp_worker_progress(UCC_TL_UCP_TASK_TEAM(task)->worker->ucp_worker);
     }
+    ucc_tl_ucp_task_adapt_polls(
+        task, completed != UCC_TL_UCP_TASK_ONESIDED_COMPLETED(task));
     return UCC_INPROGRESS;
 }
 
+/* All one-sided algorithms using the team symmetric region share its signal
+   words and scratch: an operation can satisfy signal waits of another one
+   and overwrite its data, so only one collective may use them at a time on
+   a team. Tasks of the same schedule (e.g. the two rings of cyx) split the
+   signals and scratch among themselves and share the ownership. Single
+   rank collectives do not use the region. */
+static inline int ucc_tl_ucp_sym_is_free(ucc_tl_ucp_task_t *task)
+{
+    ucc_coll_task_t *owner = TASK_TEAM(task)->sym.owner;
+
+    return !owner || owner == UCC_TL_UCP_SYM_OWNER(task) ||
+           owner->status != UCC_INPROGRESS;
+}
+
+ucc_status_t ucc_tl_ucp_sym_defer(ucc_tl_ucp_task_t *task);
+
+/* Called on start. Returns UCC_INPROGRESS if the region is in use or other
+   collectives wait for it: the task is then queued in the progress queue
+   and started again in the order of posting once the region is free, the
+   start routine must return UCC_OK and finish with ucc_tl_ucp_sym_enqueue */
+static inline ucc_status_t ucc_tl_ucp_sym_acquire(ucc_tl_ucp_task_t *task)
+{
+    ucc_tl_ucp_team_t *team  = TASK_TEAM(task);
+    ucc_coll_task_t   *owner = team->sym.owner;
+
+    if (task->subset.map.ep_num == 1 ||
+        (owner == UCC_TL_UCP_SYM_OWNER(task) &&
+         owner->status == UCC_INPROGRESS)) {
+        return UCC_OK;
+    }
+    if (ucc_list_is_empty(&team->sym.waiters) &&
+        ucc_tl_ucp_sym_is_free(task)) {
+        team->sym.owner = UCC_TL_UCP_SYM_OWNER(task);
+        return UCC_OK;
+    }
+    return ucc_tl_ucp_sym_defer(task);
+}
+
+static inline ucc_status_t ucc_tl_ucp_sym_enqueue(ucc_tl_ucp_task_t *task)
+{
+    if (task->flags & UCC_TL_UCP_TASK_FLAG_SYM_RESTART) {
+        /* already in the progress queue */
+        return UCC_OK;
+    }
+    return ucc_progress_queue_enqueue(UCC_TL_CORE_CTX(TASK_TEAM(task))->pq,
+                                      &task->super);
+}
+
+#define UCC_TL_UCP_ONESIDED_AUTO_NUM_POSTS 32
+
+/* Window of outstanding puts of one-sided alltoall(v): bounds the number of
+   RDMA operations in flight per rank and the incast on every target */
+static inline ucc_rank_t
+ucc_tl_ucp_onesided_num_posts(ucc_tl_ucp_team_t *team, unsigned long posts)
+{
+    ucc_rank_t tsize = UCC_TL_TEAM_SIZE(team);
+
+    if (posts == UCC_ULUNITS_AUTO) {
+        posts = UCC_TL_UCP_ONESIDED_AUTO_NUM_POSTS;
+    }
+    return (posts > tsize || posts == 0) ? tsize : posts;
+}
+
+/* Peer visited at step i of one-sided alltoall(v), every rank is visited
+   exactly once over steps 0 .. tsize - 1 */
+static inline ucc_rank_t ucc_tl_ucp_onesided_peer(ucc_tl_ucp_team_t *team,
+                                                  ucc_rank_t         i)
+{
+    ucc_rank_t rank  = UCC_TL_TEAM_RANK(team);
+    ucc_rank_t tsize = UCC_TL_TEAM_SIZE(team);
+
+    switch (UCC_TL_UCP_TEAM_LIB(team)->cfg.onesided_peer_order) {
+    case UCC_TL_UCP_ONESIDED_PEER_ORDER_LINEAR:
+        return i;
+    case UCC_TL_UCP_ONESIDED_PEER_ORDER_XOR:
+        if (!(tsize & (tsize - 1))) {
+            return rank ^ ((i + 1) % tsize);
+        }
+        /* fall through */
+    default:
+        return (rank + 1 + i) % tsize;
+    }
+}
+
 ucc_status_t ucc_tl_ucp_alg_id_to_init(int alg_id, const char *alg_id_str,
                                        ucc_coll_type_t          coll_type,
                                        ucc_memory_type_t        mem_type,
@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2020-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2020-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  *
  * See file LICENSE for terms.
  */
@@ -8,11 +8,13 @@
 #include "tl_ucp_tag.h"
 #include "tl_ucp_coll.h"
 #include "tl_ucp_ep.h"
+#include "tl_ucp_sendrecv.h"
 #include "utils/ucc_math.h"
 #include "utils/ucc_string.h"
 #include "utils/arch/cpu.h"
 #include "schedule/ucc_schedule_pipelined.h"
 #include <limits.h>
+#include <inttypes.h>
 
 #define UCP_CHECK(function, msg, go, ctx)                                      \
     status = function;                                                         \
@@ -154,6 +156,8 @@ UCC_CLASS_INIT_FUNC(ucc_tl_ucp_context_t,
     UCC_CLASS_CALL_SUPER_INIT(ucc_tl_context_t, &tl_ucp_config->super,
                               params->context);
     memcpy(&self->cfg, tl_ucp_config, sizeof(*tl_ucp_config));
+    memset(&self->npolls_stats, 0, sizeof(self->npolls_stats));
+    self->npolls_stats.min = UINT32_MAX;
     lib = ucc_derived_of(self->super.super.lib, ucc_tl_ucp_lib_t);
     prefix = strdup(params->prefix);
     if (!prefix) {
@@ -167,9 +171,13 @@ UCC_CLASS_INIT_FUNC(ucc_tl_ucp_context_t,
     ucp_params.field_mask =
         UCP_PARAM_FIELD_FEATURES | UCP_PARAM_FIELD_TAG_SENDER_MASK | UCP_PARAM_FIELD_NAME;
     ucp_params.features = UCP_FEATURE_TAG | UCP_FEATURE_AM;
-    if (params->params.mask & UCC_CONTEXT_PARAM_FIELD_MEM_PARAMS) {
+    if ((params->params.mask & UCC_CONTEXT_PARAM_FIELD_MEM_PARAMS) ||
+        self->cfg.rcache) {
         ucp_params.features |= UCP_FEATURE_RMA | UCP_FEATURE_AMO64;
     }
+    if (self->cfg.wakeup) {
+        ucp_params.features |= UCP_FEATURE_WAKEUP;
+    }
     ucp_params.tag_sender_mask = UCC_TL_UCP_TAG_SENDER_MASK;
     ucp_params.name = "UCC_UCP_CONTEXT";
 
@@ -208,6 +216,10 @@ UCC_CLASS_INIT_FUNC(ucc_tl_ucp_context_t,
         ucc_assert(0);
         break;
     }
+    if (self->cfg.wakeup) {
+        worker_params.field_mask |= UCP_WORKER_PARAM_FIELD_EVENTS;
+        worker_params.events      = UCP_WAKEUP_TX | UCP_WAKEUP_RX;
+    }
 
     UCP_CHECK(ucp_worker_create(ucp_context, &worker_params, &ucp_worker),
               "failed to create ucp worker", err_worker_create, self);
@@ -244,36 +256,55 @@ UCC_CLASS_INIT_FUNC(ucc_tl_ucp_context_t,
         goto err_thread_mode;
     }
 
+    ucc_status = ucc_mpool_init(&self->put_signal_mp, 0,
+                                sizeof(ucc_tl_ucp_put_signal_t), 0,
+                                UCC_CACHE_LINE_SIZE, 32, UINT_MAX, NULL,
+                                params->thread_mode, "tl_ucp_put_signal_mp");
+    if (UCC_OK != ucc_status) {
+        tl_error(self->super.super.lib,
+                 "failed to initialize tl_ucp_put_signal mpool");
+        goto err_put_signal_mp;
+    }
+
     CHECK(UCC_OK != ucc_context_progress_register(
                         params->context,
                         (ucc_context_progress_fn_t)ucp_worker_progress,
                         self->worker.ucp_worker),
-          "failed to register progress function", err_thread_mode,
+          "failed to register progress function", err_progress,
           UCC_ERR_NO_MESSAGE, self);
 
     self->remote_info  = NULL;
     self->n_rinfo_segs = 0;
     self->rkeys        = NULL;
+    self->rcache       = NULL;
+    if (self->cfg.rcache) {
+        ucc_status = ucc_tl_ucp_rcache_create(self);
+        if (UCC_OK != ucc_status) {
+            tl_error(self->super.super.lib,
+                     "failed to create registration cache");
+            goto err_rcache;
+        }
+    }
     if (params->params.mask & UCC_CONTEXT_PARAM_FIELD_MEM_PARAMS &&
         params->params.mask & UCC_CONTEXT_PARAM_FIELD_OOB) {
         ucc_status = ucc_tl_ucp_ctx_remote_populate(
             self, params->params.mem_params, params->params.oob);
         if (UCC_OK != ucc_status) {
             tl_error(self->super.super.lib, "failed to gather RMA information");
-            goto err_thread_mode;
+            goto err_rinfo;
         }
     }
 
     CHECK(UCC_OK != ucc_tl_ucp_eps_ephash_init(
                         params, self, &self->worker.ep_hash, &self->worker.eps),
-          "failed to allocate memory for endpoint storage", err_thread_mode,
+          "failed to allocate memory for endpoint storage", err_eps,
           UCC_ERR_NO_MESSAGE, self);
 
     if (self->cfg.service_worker) {
         CHECK(UCC_OK != ucc_tl_ucp_context_service_init(
                             prefix, ucp_params, worker_params, params, self),
-              "failed to init service worker", err_cfg, UCC_ERR_NO_MESSAGE,
-              self);
+              "failed to init service worker", err_service,
+              UCC_ERR_NO_MESSAGE, self);
     }
     ucc_free(prefix);
     prefix = NULL;
@@ -281,6 +312,26 @@ UCC_CLASS_INIT_FUNC(ucc_tl_ucp_context_t,
     tl_debug(self->super.super.lib, "initialized tl context: %p", self);
     return UCC_OK;
 
+err_service:
+    if (self->worker.eps) {
+        ucc_free(self->worker.eps);
+    } else {
+        kh_destroy(tl_ucp_ep_hash, self->worker.ep_hash);
+    }
+err_eps:
+    if (self->remote_info) {
+        ucc_tl_ucp_rinfo_destroy(self);
+    }
+err_rinfo:
+    ucc_tl_ucp_rcache_destroy(self);
+err_rcache:
+    ucc_context_progress_deregister(
+        params->context, (ucc_context_progress_fn_t)ucp_worker_progress,
+        self->worker.ucp_worker);
+err_progress:
+    ucc_mpool_cleanup(&self->put_signal_mp, 1);
+err_put_signal_mp:
+    ucc_mpool_cleanup(&self->req_mp, 1);
 err_thread_mode:
     ucp_worker_destroy(ucp_worker);
 err_worker_create:
@@ -384,6 +435,15 @@ static inline void ucc_tl_ucp_worker_cleanup(ucc_tl_ucp_worker_t worker)
 UCC_CLASS_CLEANUP_FUNC(ucc_tl_ucp_context_t)
 {
     tl_debug(self->super.super.lib, "finalizing tl context: %p", self);
+    if (self->cfg.npolls_adaptive && self->npolls_stats.n_updates) {
+        tl_info(self->super.super.lib,
+                "adaptive npolls: %" PRIu64 " updates, budget avg %.1f "
+                "min %u max %u",
+                self->npolls_stats.n_updates,
+                (double)self->npolls_stats.total /
+                    self->npolls_stats.n_updates,
+                self->npolls_stats.min, self->npolls_stats.max);
+    }
     if (self->remote_info) {
         ucc_tl_ucp_rinfo_destroy(self);
     }
@@ -398,6 +458,8 @@ UCC_CLASS_CLEANUP_FUNC(ucc_tl_ucp_context_t)
             self);
     }
     ucc_mpool_cleanup(&self->req_mp, 1);
+    ucc_mpool_cleanup(&self->put_signal_mp, 1);
+    ucc_tl_ucp_rcache_destroy(self);
     ucc_tl_ucp_eps_cleanup(&self->worker, self);
     if (self->cfg.service_worker != 0) {
         ucc_tl_ucp_eps_cleanup(&self->service_worker, self);
@@ -555,6 +617,39 @@ static void ucc_tl_ucp_ctx_remote_pack_data(ucc_tl_ucp_context_t *ctx,
     }
 }
 
+ucc_status_t ucc_tl_ucp_context_get_event_fd(ucc_base_context_t *context,
+                                             int                *fd)
+{
+    ucc_tl_ucp_context_t *ctx = ucc_derived_of(context, ucc_tl_ucp_context_t);
+    ucs_status_t          status;
+
+    if (!ctx->cfg.wakeup) {
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    status = ucp_worker_get_efd(ctx->worker.ucp_worker, fd);
+    if (UCS_OK != status) {
+        tl_debug(ctx->super.super.lib, "failed to get ucp worker efd, %s",
+                 ucs_status_string(status));
+        return ucs_status_to_ucc_status(status);
+    }
+    return UCC_OK;
+}
+
+/* Only the collective worker is armed: the service worker is progressed
+   from a throttled progress callback and is not needed to wake up ranks
+   waiting for collective traffic */
+ucc_status_t ucc_tl_ucp_context_arm(ucc_base_context_t *context)
+{
+    ucc_tl_ucp_context_t *ctx = ucc_derived_of(context, ucc_tl_ucp_context_t);
+    ucs_status_t          status;
+
+    status = ucp_worker_arm(ctx->worker.ucp_worker);
+    if (UCS_ERR_BUSY == status) {
+        return UCC_INPROGRESS;
+    }
+    return ucs_status_to_ucc_status(status);
+}
+
 ucc_status_t ucc_tl_ucp_get_context_attr(const ucc_base_context_t *context,
                                          ucc_base_ctx_attr_t      *attr)
 {
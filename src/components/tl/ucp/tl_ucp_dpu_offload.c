@@ -41,3 +41,29 @@ ucc_status_t ucc_tl_ucp_allreduce_sliding_window_register(
 
     return UCC_OK;
 }
+
+ucc_status_t ucc_tl_ucp_allreduce_sliding_window_register_cached(
+    ucc_tl_ucp_team_t *tl_team, struct ucc_tl_ucp_allreduce_sw_export_buf *ebuf,
+    void *addr, size_t length, ucc_memory_type_t mem_type)
+{
+    ucc_tl_ucp_context_t *ctx = UCC_TL_UCP_TEAM_CTX(tl_team);
+    ucc_status_t          status;
+
+    if (ebuf->region) {
+        /* restart of a persistent collective, keep the registration */
+        return UCC_OK;
+    }
+    status = ucc_tl_ucp_rcache_get(ctx, addr, length, mem_type, &ebuf->region);
+    if (UCC_OK != status) {
+        tl_error(UCC_TL_TEAM_LIB(tl_team),
+                 "failed to register buffer %p through rcache: %s", addr,
+                 ucc_status_string(status));
+        ebuf->region = NULL;
+        return status;
+    }
+    ebuf->ucp_context    = ctx->worker.ucp_context;
+    ebuf->memh           = NULL;
+    ebuf->packed_key     = ebuf->region->packed_key;
+    ebuf->packed_key_len = ebuf->region->packed_key_len;
+    return UCC_OK;
+}
@@ -22,11 +22,14 @@ typedef struct ucc_tl_ucp_allreduce_sw_global_work_buf_info {
 } ucc_tl_ucp_allreduce_sw_global_work_buf_info_t;
 
 struct ucc_tl_ucp_allreduce_sw_export_buf {
-    ucp_context_h ucp_context;
-    ucp_mem_h     memh;
-    void         *packed_memh;
-    void         *packed_key;
-    size_t        packed_key_len;
+    ucp_context_h               ucp_context;
+    ucp_mem_h                   memh;
+    void                       *packed_memh;
+    void                       *packed_key;
+    size_t                      packed_key_len;
+    /* set if the buffer was registered through the context rcache
+       instead of importing an exported memh */
+    ucc_tl_ucp_rcache_region_t *region;
 };
 
 typedef struct ucc_tl_ucp_allreduce_sw_host_allgather {
@@ -49,5 +52,9 @@ ucc_status_t ucc_tl_ucp_allreduce_sliding_window_register(
     ucp_context_h ucp_context, ucc_tl_ucp_team_t *tl_team,
     struct ucc_tl_ucp_allreduce_sw_export_buf *ebuf, void *packed_memh);
 
+ucc_status_t ucc_tl_ucp_allreduce_sliding_window_register_cached(
+    ucc_tl_ucp_team_t *tl_team, struct ucc_tl_ucp_allreduce_sw_export_buf *ebuf,
+    void *addr, size_t length, ucc_memory_type_t mem_type);
+
 
 #endif
@@ -0,0 +1,293 @@
+/**
+ * Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "tl_ucp.h"
+#include "tl_ucp_coll.h"
+#include "allgather/allgather.h"
+#include "utils/ucc_malloc.h"
+#include "utils/ucc_math.h"
+
+static ucs_status_t
+ucc_tl_ucp_rcache_mem_reg(void *context,
+                          ucc_rcache_t *rcache, //NOLINT: rcache is unused
+                          void *arg, ucc_rcache_region_t *rregion,
+                          uint16_t flags) //NOLINT: flags is unused
+{
+    ucc_tl_ucp_context_t       *ctx      = context;
+    ucs_memory_type_t           mem_type = *(ucs_memory_type_t *)arg;
+    ucc_tl_ucp_rcache_region_t *region   =
+        ucc_derived_of(rregion, ucc_tl_ucp_rcache_region_t);
+    ucp_mem_map_params_t        mmap_params;
+    ucs_status_t                status;
+
+    mmap_params.field_mask = UCP_MEM_MAP_PARAM_FIELD_ADDRESS |
+                             UCP_MEM_MAP_PARAM_FIELD_LENGTH;
+    mmap_params.address    = (void *)rregion->super.start;
+    mmap_params.length     = rregion->super.end - rregion->super.start;
+    if (mem_type != UCS_MEMORY_TYPE_UNKNOWN) {
+        mmap_params.field_mask |= UCP_MEM_MAP_PARAM_FIELD_MEMORY_TYPE;
+        mmap_params.memory_type = mem_type;
+    }
+    status = ucp_mem_map(ctx->worker.ucp_context, &mmap_params, &region->memh);
+    if (UCS_OK != status) {
+        tl_error(ctx->super.super.lib, "ucp_mem_map failed: %s",
+                 ucs_status_string(status));
+        return status;
+    }
+    status = ucp_rkey_pack(ctx->worker.ucp_context, region->memh,
+                           &region->packed_key, &region->packed_key_len);
+    if (UCS_OK != status) {
+        tl_error(ctx->super.super.lib, "ucp_rkey_pack failed: %s",
+                 ucs_status_string(status));
+        ucp_mem_unmap(ctx->worker.ucp_context, region->memh);
+        return status;
+    }
+    return UCS_OK;
+}
+
+static void
+ucc_tl_ucp_rcache_mem_dereg(void *context,
+                            ucc_rcache_t *rcache, //NOLINT: rcache is unused
+                            ucc_rcache_region_t *rregion)
+{
+    ucc_tl_ucp_context_t       *ctx    = context;
+    ucc_tl_ucp_rcache_region_t *region =
+        ucc_derived_of(rregion, ucc_tl_ucp_rcache_region_t);
+
+    ucp_rkey_buffer_release(region->packed_key);
+    ucp_mem_unmap(ctx->worker.ucp_context, region->memh);
+}
+
+static void
+ucc_tl_ucp_rcache_dump_region(void *context, //NOLINT: context is unused
+                              ucc_rcache_t *rcache, //NOLINT: rcache is unused
+                              ucc_rcache_region_t *rregion, char *buf,
+                              size_t max)
+{
+    ucc_tl_ucp_rcache_region_t *region =
+        ucc_derived_of(rregion, ucc_tl_ucp_rcache_region_t);
+
+    snprintf(buf, max, "memh:%p packed_key_len:%zd", region->memh,
+             region->packed_key_len);
+}
+
+static ucc_rcache_ops_t ucc_tl_ucp_rcache_ops = {
+    .mem_reg     = ucc_tl_ucp_rcache_mem_reg,
+    .mem_dereg   = ucc_tl_ucp_rcache_mem_dereg,
+    .dump_region = ucc_tl_ucp_rcache_dump_region
+};
+
+ucc_status_t ucc_tl_ucp_rcache_create(ucc_tl_ucp_context_t *ctx)
+{
+    ucc_rcache_params_t rcache_params;
+
+    ucc_rcache_set_default_params(&rcache_params);
+    rcache_params.region_struct_size = sizeof(ucc_tl_ucp_rcache_region_t);
+    rcache_params.context            = ctx;
+    rcache_params.ops                = &ucc_tl_ucp_rcache_ops;
+    /* registrations are dropped once the user releases the memory, so a
+       new buffer allocated at the same address is registered again */
+    rcache_params.ucm_events         = UCM_EVENT_VM_UNMAPPED |
+                                       UCM_EVENT_MEM_TYPE_FREE;
+
+    return ucc_rcache_create(&rcache_params, "TL_UCP", &ctx->rcache);
+}
+
+void ucc_tl_ucp_rcache_destroy(ucc_tl_ucp_context_t *ctx)
+{
+    if (ctx->rcache) {
+        ucc_rcache_destroy(ctx->rcache);
+        ctx->rcache = NULL;
+    }
+}
+
+ucc_status_t ucc_tl_ucp_rcache_get(ucc_tl_ucp_context_t *ctx, void *addr,
+                                   size_t length, ucc_memory_type_t mem_type,
+                                   ucc_tl_ucp_rcache_region_t **region)
+{
+    ucs_memory_type_t ucs_mem_type = ucc_memtype_to_ucs[mem_type];
+
+    return ucc_rcache_get(ctx->rcache, addr, ucc_max(length, 1),
+                          &ucs_mem_type, (ucc_rcache_region_t **)region);
+}
+
+void ucc_tl_ucp_rcache_put(ucc_tl_ucp_context_t       *ctx,
+                           ucc_tl_ucp_rcache_region_t *region)
+{
+    ucc_rcache_region_put(ctx->rcache, &region->super);
+}
+
+static void ucc_tl_ucp_dyn_mem_cleanup(ucc_tl_ucp_task_t *task)
+{
+    ucc_tl_ucp_context_t *ctx = TASK_CTX(task);
+    ucc_tl_ucp_dyn_mem_t *dyn = task->dyn_mem;
+    ucc_rank_t            i;
+
+    for (i = 0; i < UCC_TL_TEAM_SIZE(TASK_TEAM(task)) * dyn->n_bufs; i++) {
+        if (dyn->rkeys[i]) {
+            ucp_rkey_destroy(dyn->rkeys[i]);
+        }
+    }
+    for (i = 0; i < dyn->n_bufs; i++) {
+        if (dyn->region[i]) {
+            ucc_tl_ucp_rcache_put(ctx, dyn->region[i]);
+        }
+    }
+    ucc_free(dyn);
+    task->dyn_mem = NULL;
+}
+
+static ucc_status_t ucc_tl_ucp_dyn_mem_task_finalize(ucc_coll_task_t *ctask)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(ctask, ucc_tl_ucp_task_t);
+
+    ucc_tl_ucp_dyn_mem_cleanup(task);
+    return ucc_tl_ucp_coll_finalize(ctask);
+}
+
+static ucc_status_t ucc_tl_ucp_dyn_mem_schedule_finalize(ucc_coll_task_t *ctask)
+{
+    ucc_schedule_t *schedule = ucc_derived_of(ctask, ucc_schedule_t);
+    ucc_status_t    status;
+
+    status = ucc_schedule_finalize(ctask);
+    ucc_tl_ucp_put_schedule(schedule);
+    return status;
+}
+
+static ucc_status_t ucc_tl_ucp_dyn_mem_init(ucc_tl_ucp_task_t *task,
+                                            unsigned n_bufs, void **bufs,
+                                            size_t            *lens,
+                                            ucc_memory_type_t *mem_types)
+{
+    ucc_tl_ucp_team_t     *team = TASK_TEAM(task);
+    ucc_tl_ucp_context_t  *ctx  = TASK_CTX(task);
+    ucc_rank_t             size = UCC_TL_TEAM_SIZE(team);
+    ucc_tl_ucp_sym_info_t *local;
+    ucc_tl_ucp_dyn_mem_t  *dyn;
+    ucc_status_t           status;
+    unsigned               i;
+
+    ucc_assert(n_bufs <= UCC_TL_UCP_DYN_MEM_MAX_BUFS);
+    /* single allocation: descriptor, exchanged info and peer rkeys */
+    dyn = ucc_calloc(1, sizeof(*dyn) +
+                     (size + 1) * n_bufs * sizeof(ucc_tl_ucp_sym_info_t) +
+                     size * n_bufs * sizeof(ucp_rkey_h), "dyn_mem");
+    if (!dyn) {
+        tl_error(UCC_TASK_LIB(task), "failed to allocate dyn mem descriptor");
+        return UCC_ERR_NO_MEMORY;
+    }
+    dyn->n_bufs   = n_bufs;
+    dyn->info     = PTR_OFFSET(dyn, sizeof(*dyn));
+    dyn->rkeys    = PTR_OFFSET(dyn->info, (size + 1) * n_bufs *
+                                          sizeof(ucc_tl_ucp_sym_info_t));
+    task->dyn_mem = dyn;
+
+    local = &dyn->info[size * n_bufs];
+    for (i = 0; i < n_bufs; i++) {
+        dyn->va_base[i] = bufs[i];
+        dyn->len[i]     = lens[i];
+        status = ucc_tl_ucp_rcache_get(ctx, bufs[i], lens[i], mem_types[i],
+                                       &dyn->region[i]);
+        if (UCC_OK != status) {
+            tl_error(UCC_TASK_LIB(task), "failed to register buffer %p: %s",
+                     bufs[i], ucc_status_string(status));
+            goto err;
+        }
+        if (dyn->region[i]->packed_key_len >
+            UCC_TL_UCP_SYM_PACKED_KEY_MAX_LEN) {
+            tl_error(UCC_TASK_LIB(task),
+                     "packed key length %zd exceeds max supported %d",
+                     dyn->region[i]->packed_key_len,
+                     UCC_TL_UCP_SYM_PACKED_KEY_MAX_LEN);
+            status = UCC_ERR_NOT_SUPPORTED;
+            goto err;
+        }
+        local[i].va_base        = (uint64_t)bufs[i];
+        local[i].packed_key_len = dyn->region[i]->packed_key_len;
+        memcpy(local[i].packed_key, dyn->region[i]->packed_key,
+               dyn->region[i]->packed_key_len);
+    }
+    return UCC_OK;
+
+err:
+    ucc_tl_ucp_dyn_mem_cleanup(task);
+    return status;
+}
+
+ucc_status_t ucc_tl_ucp_dyn_mem_schedule_init(ucc_tl_ucp_task_t *task,
+                                              unsigned n_bufs, void **bufs,
+                                              size_t            *lens,
+                                              ucc_memory_type_t *mem_types,
+                                              ucc_coll_task_t  **task_h)
+{
+    ucc_tl_ucp_team_t   *team      = TASK_TEAM(task);
+    ucc_rank_t           size      = UCC_TL_TEAM_SIZE(team);
+    size_t               info_size = n_bufs * sizeof(ucc_tl_ucp_sym_info_t);
+    ucc_base_coll_args_t bargs     = {
+        .mask = 0,
+        .args = {.coll_type = UCC_COLL_TYPE_ALLGATHER,
+                 .mask      = 0,
+                 .src.info  = {.buffer   = NULL,
+                               .count    = info_size,
+                               .datatype = UCC_DT_UINT8,
+                               .mem_type = UCC_MEMORY_TYPE_HOST},
+                 .dst.info  = {.buffer   = NULL,
+                               .count    = info_size * size,
+                               .datatype = UCC_DT_UINT8,
+                               .mem_type = UCC_MEMORY_TYPE_HOST}}};
+    ucc_schedule_t      *schedule;
+    ucc_coll_task_t     *exchange_task;
+    ucc_status_t         status;
+
+    if (!TASK_CTX(task)->rcache) {
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    status = ucc_tl_ucp_dyn_mem_init(task, n_bufs, bufs, lens, mem_types);
+    if (UCC_OK != status) {
+        return status;
+    }
+    status = ucc_tl_ucp_get_schedule(team, &task->super.bargs,
+                                     (ucc_tl_ucp_schedule_t **)&schedule);
+    if (ucc_unlikely(UCC_OK != status)) {
+        goto err_schedule;
+    }
+
+    bargs.args.src.info.buffer = &task->dyn_mem->info[size * n_bufs];
+    bargs.args.dst.info.buffer = task->dyn_mem->info;
+    UCC_CHECK_GOTO(ucc_tl_ucp_allgather_ring_init(&bargs, &team->super.super,
+                                                  &exchange_task),
+                   err_exchange, status);
+    UCC_CHECK_GOTO(ucc_schedule_add_task(schedule, exchange_task),
+                   err_add, status);
+    UCC_CHECK_GOTO(ucc_event_manager_subscribe(&schedule->super,
+                                               UCC_EVENT_SCHEDULE_STARTED,
+                                               exchange_task,
+                                               ucc_task_start_handler),
+                   err_add, status);
+    UCC_CHECK_GOTO(ucc_schedule_add_task(schedule, &task->super),
+                   err_add, status);
+    UCC_CHECK_GOTO(ucc_event_manager_subscribe(exchange_task,
+                                               UCC_EVENT_COMPLETED,
+                                               &task->super,
+                                               ucc_task_start_handler),
+                   err_add, status);
+
+    task->super.finalize     = ucc_tl_ucp_dyn_mem_task_finalize;
+    schedule->super.post     = ucc_schedule_start;
+    schedule->super.progress = NULL;
+    schedule->super.finalize = ucc_tl_ucp_dyn_mem_schedule_finalize;
+    *task_h                  = &schedule->super;
+    return UCC_OK;
+
+err_add:
+    ucc_tl_ucp_coll_finalize(exchange_task);
+err_exchange:
+    ucc_tl_ucp_put_schedule(schedule);
+err_schedule:
+    ucc_tl_ucp_dyn_mem_cleanup(task);
+    return status;
+}
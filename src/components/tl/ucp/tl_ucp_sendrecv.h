@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * Copyright (c) Meta Platforms, Inc. and affiliates. 2022.
  *
  * See file LICENSE for terms.
@@ -25,6 +25,22 @@ void ucc_tl_ucp_put_completion_cb(void *request, ucs_status_t status,
 void ucc_tl_ucp_get_completion_cb(void *request, ucs_status_t status,
                                   void *user_data);
 
+/* signal of ucc_tl_ucp_put_signal_nb waiting for the preceding put */
+typedef struct ucc_tl_ucp_put_signal {
+    ucc_tl_ucp_task_t *task;
+    ucp_ep_h           ep;
+    ucp_rkey_h         rkey;
+    uint64_t           rva;
+} ucc_tl_ucp_put_signal_t;
+
+void ucc_tl_ucp_put_signal_put_cb(void *request, ucs_status_t status,
+                                  void *user_data);
+
+void ucc_tl_ucp_put_signal_flush_cb(void *request, ucs_status_t status,
+                                    void *user_data);
+
+ucc_status_t ucc_tl_ucp_put_signal_post(ucc_tl_ucp_put_signal_t *sig);
+
 void ucc_tl_ucp_recv_completion_cb(void *request, ucs_status_t status,
                                    const ucp_tag_recv_info_t *info,
                                    void                      *user_data);
@@ -230,25 +246,80 @@ static inline ucc_status_t ucc_tl_ucp_send_nz(void *buffer, size_t msglen,
                               task);
 }
 
+/* Address within team symmetric region: same offset on every rank, rkeys
+   were exchanged at team creation and are unpacked on first use */
 static inline ucc_status_t
-ucc_tl_ucp_resolve_p2p_by_va(ucc_tl_ucp_team_t *team, void *va, ucp_ep_h *ep,
-                             ucc_rank_t peer, uint64_t *rva, ucp_rkey_h *rkey,
-                             int *segment)
+ucc_tl_ucp_resolve_sym_by_va(ucc_tl_ucp_team_t *team, void *va, ucp_ep_h *ep,
+                             ucc_rank_t peer, uint64_t *rva, ucp_rkey_h *rkey)
+{
+    ucc_tl_ucp_sym_mem_t *sym = &team->sym;
+    ucs_status_t          ucs_status;
+
+    if (ucc_unlikely(NULL == sym->rkeys[peer])) {
+        ucs_status = ucp_ep_rkey_unpack(*ep, sym->info[peer].packed_key,
+                                        &sym->rkeys[peer]);
+        if (UCS_OK != ucs_status) {
+            return ucs_status_to_ucc_status(ucs_status);
+        }
+    }
+    *rkey = sym->rkeys[peer];
+    *rva  = sym->info[peer].va_base +
+            ((uint64_t)va - (uint64_t)sym->va_base);
+    return UCC_OK;
+}
+
+/* Returns index of the mapped segment containing va or -1. Consecutive
+   one-sided operations of a task mostly target the same segment, so the last
+   hit of the task is checked before the scan. The hint is kept per task
+   rather than per team so that tasks progressed by different threads do not
+   share it */
+static inline int ucc_tl_ucp_va_to_segment(ucc_tl_ucp_team_t *team,
+                                           ucc_tl_ucp_task_t *task, void *va)
+{
+    ucc_tl_ucp_context_t *ctx = UCC_TL_UCP_TEAM_CTX(team);
+    int                   seg = task ? task->last_seg : 0;
+    int                   i;
+
+    if (ucc_likely(seg < ctx->n_rinfo_segs &&
+                   (uint64_t)va >= (uint64_t)team->va_base[seg] &&
+                   (uint64_t)va < (uint64_t)team->va_base[seg] +
+                                      team->base_length[seg])) {
+        return seg;
+    }
+    for (i = 0; i < ctx->n_rinfo_segs; i++) {
+        if ((uint64_t)va >= (uint64_t)team->va_base[i] &&
+            (uint64_t)va < (uint64_t)team->va_base[i] + team->base_length[i]) {
+            if (task) {
+                task->last_seg = i;
+            }
+            return i;
+        }
+    }
+    return -1;
+}
+
+/* Fills team cache entry of peer segment: remote base address and rkey,
+   unpacking the rkey from the peer address if nobody did it yet */
+static inline ucc_status_t
+ucc_tl_ucp_resolve_segment(ucc_tl_ucp_team_t *team, ucp_ep_h ep,
+                           ucc_rank_t peer, int segment)
 {
     ucc_tl_ucp_context_t *ctx            = UCC_TL_UCP_TEAM_CTX(team);
     ptrdiff_t             key_offset     = 0;
     const size_t          section_offset = sizeof(uint64_t) * ctx->n_rinfo_segs;
-    ucc_rank_t            core_rank;
+    int                   idx = UCC_TL_UCP_TEAM_SEG_IDX(team, peer, segment);
+    ucc_rank_t            core_rank, ctx_rank;
     uint64_t             *rvas;
     uint64_t             *key_sizes;
     void                 *keys;
     void                 *offset;
     ptrdiff_t             base_offset;
+    ucs_status_t          ucs_status;
+    int                   i;
 
-    *segment  = -1;
     core_rank = ucc_ep_map_eval(UCC_TL_TEAM_MAP(team), peer);
     ucc_assert(UCC_TL_CORE_TEAM(team) != NULL);
-    peer = ucc_get_ctx_rank(UCC_TL_CORE_TEAM(team), core_rank);
+    ctx_rank = ucc_get_ctx_rank(UCC_TL_CORE_TEAM(team), core_rank);
 
     offset = ucc_get_team_ep_addr(UCC_TL_CORE_CTX(team), UCC_TL_CORE_TEAM(team),
                                   core_rank, ucc_tl_ucp.super.super.id);
@@ -258,16 +329,94 @@ ucc_tl_ucp_resolve_p2p_by_va(ucc_tl_ucp_team_t *team, void *va, ucp_ep_h *ep,
     key_sizes   = PTR_OFFSET(base_offset, (section_offset * 2));
     keys        = PTR_OFFSET(base_offset, (section_offset * 3));
 
-    for (int i = 0; i < ctx->n_rinfo_segs; i++) {
-        uint64_t base = (uint64_t)team->va_base[i];
-        uint64_t end  = base + team->base_length[i];
+    if (NULL == UCC_TL_UCP_REMOTE_RKEY(ctx, ctx_rank, segment)) {
+        for (i = 0; i < segment; i++) {
+            key_offset += key_sizes[i];
+        }
+        ucs_status =
+            ucp_ep_rkey_unpack(ep, PTR_OFFSET(keys, key_offset),
+                               &UCC_TL_UCP_REMOTE_RKEY(ctx, ctx_rank, segment));
+        if (UCS_OK != ucs_status) {
+            return ucs_status_to_ucc_status(ucs_status);
+        }
+    }
+    team->seg_rvas[idx]  = rvas[segment];
+    team->seg_rkeys[idx] = UCC_TL_UCP_REMOTE_RKEY(ctx, ctx_rank, segment);
+    return UCC_OK;
+}
+
+/* Returns index of the task target buffer registered on first use that
+   contains va or -1 */
+static inline int ucc_tl_ucp_dyn_mem_buf(ucc_tl_ucp_dyn_mem_t *dyn, void *va)
+{
+    unsigned i;
 
-        if ((uint64_t)va >= base && (uint64_t)va < end) {
-            *segment = i;
-            break;
+    for (i = 0; i < dyn->n_bufs; i++) {
+        if ((uint64_t)va >= (uint64_t)dyn->va_base[i] &&
+            (uint64_t)va < (uint64_t)dyn->va_base[i] + dyn->len[i]) {
+            return i;
         }
-        key_offset += key_sizes[i];
     }
+    return -1;
+}
+
+/* Address within task target buffer: peer buffer address and rkey were
+   exchanged before the task started, rkey is unpacked on first use */
+static inline ucc_status_t
+ucc_tl_ucp_resolve_dyn_by_va(ucc_tl_ucp_dyn_mem_t *dyn, int buf, void *va,
+                             ucp_ep_h *ep, ucc_rank_t peer, uint64_t *rva,
+                             ucp_rkey_h *rkey)
+{
+    int          idx = peer * dyn->n_bufs + buf;
+    ucs_status_t ucs_status;
+
+    if (ucc_unlikely(NULL == dyn->rkeys[idx])) {
+        ucs_status = ucp_ep_rkey_unpack(*ep, dyn->info[idx].packed_key,
+                                        &dyn->rkeys[idx]);
+        if (UCS_OK != ucs_status) {
+            return ucs_status_to_ucc_status(ucs_status);
+        }
+    }
+    *rkey = dyn->rkeys[idx];
+    *rva  = dyn->info[idx].va_base +
+            ((uint64_t)va - (uint64_t)dyn->va_base[buf]);
+    return UCC_OK;
+}
+
+/* Buffer can be targeted by one-sided operations without registering it on
+   first use */
+static inline int ucc_tl_ucp_is_mapped(ucc_tl_ucp_team_t *team, void *va)
+{
+    if (UCC_TL_UCP_TEAM_HAS_SYM(team) &&
+        (uint64_t)va >= (uint64_t)team->sym.va_base &&
+        (uint64_t)va < (uint64_t)team->sym.va_base + team->sym.len) {
+        return 1;
+    }
+    return ucc_tl_ucp_va_to_segment(team, NULL, va) >= 0;
+}
+
+static inline ucc_status_t
+ucc_tl_ucp_resolve_p2p_by_va(ucc_tl_ucp_team_t *team, ucc_tl_ucp_task_t *task,
+                             void *va, ucp_ep_h *ep, ucc_rank_t peer,
+                             uint64_t *rva, ucp_rkey_h *rkey, int *segment)
+{
+    ucc_status_t status;
+    int          idx;
+
+    *segment  = -1;
+    if (task && task->dyn_mem) {
+        idx = ucc_tl_ucp_dyn_mem_buf(task->dyn_mem, va);
+        if (idx >= 0) {
+            return ucc_tl_ucp_resolve_dyn_by_va(task->dyn_mem, idx, va, ep,
+                                                peer, rva, rkey);
+        }
+    }
+    if (UCC_TL_UCP_TEAM_HAS_SYM(team) &&
+        (uint64_t)va >= (uint64_t)team->sym.va_base &&
+        (uint64_t)va < (uint64_t)team->sym.va_base + team->sym.len) {
+        return ucc_tl_ucp_resolve_sym_by_va(team, va, ep, peer, rva, rkey);
+    }
+    *segment = ucc_tl_ucp_va_to_segment(team, task, va);
     if (ucc_unlikely(0 > *segment)) {
         tl_error(UCC_TL_TEAM_LIB(team),
                  "attempt to perform one-sided operation on non-registered "
@@ -275,16 +424,16 @@ ucc_tl_ucp_resolve_p2p_by_va(ucc_tl_ucp_team_t *team, void *va, ucp_ep_h *ep,
                  va);
         return UCC_ERR_NOT_FOUND;
     }
-    if (ucc_unlikely(NULL == UCC_TL_UCP_REMOTE_RKEY(ctx, peer, *segment))) {
-        ucs_status_t ucs_status =
-            ucp_ep_rkey_unpack(*ep, PTR_OFFSET(keys, key_offset),
-                               &UCC_TL_UCP_REMOTE_RKEY(ctx, peer, *segment));
-        if (UCS_OK != ucs_status) {
-            return ucs_status_to_ucc_status(ucs_status);
+    idx = UCC_TL_UCP_TEAM_SEG_IDX(team, peer, *segment);
+    if (ucc_unlikely(NULL == team->seg_rkeys[idx])) {
+        status = ucc_tl_ucp_resolve_segment(team, *ep, peer, *segment);
+        if (ucc_unlikely(UCC_OK != status)) {
+            return status;
         }
     }
-    *rkey = UCC_TL_UCP_REMOTE_RKEY(ctx, peer, *segment);
-    *rva  = rvas[*segment] + ((uint64_t)va - (uint64_t)team->va_base[*segment]);
+    *rkey = team->seg_rkeys[idx];
+    *rva  = team->seg_rvas[idx] +
+            ((uint64_t)va - (uint64_t)team->va_base[*segment]);
     return UCC_OK;
 }
 
@@ -345,8 +494,9 @@ static inline ucc_status_t ucc_tl_ucp_put_nb(void *buffer, void *target,
         return status;
     }
 
-    status = ucc_tl_ucp_resolve_p2p_by_va(team, target, &ep, dest_group_rank,
-                                          &rva, &rkey, &segment);
+    status = ucc_tl_ucp_resolve_p2p_by_va(team, task, target, &ep,
+                                          dest_group_rank, &rva, &rkey,
+                                          &segment);
     if (ucc_unlikely(UCC_OK != status)) {
         return status;
     }
@@ -388,8 +538,9 @@ static inline ucc_status_t ucc_tl_ucp_get_nb(void *buffer, void *target,
         return status;
     }
 
-    status = ucc_tl_ucp_resolve_p2p_by_va(team, target, &ep, dest_group_rank,
-                                          &rva, &rkey, &segment);
+    status = ucc_tl_ucp_resolve_p2p_by_va(team, task, target, &ep,
+                                          dest_group_rank, &rva, &rkey,
+                                          &segment);
     if (ucc_unlikely(UCC_OK != status)) {
         return status;
     }
@@ -413,48 +564,89 @@ static inline ucc_status_t ucc_tl_ucp_get_nb(void *buffer, void *target,
     return UCC_OK;
 }
 
-static inline ucc_status_t ucc_tl_ucp_atomic_inc(void      *target,
-                                                 ucc_rank_t dest_group_rank,
-                                                 ucc_tl_ucp_team_t *team)
+/* Puts msglen bytes from local buffer to target on dest and then increments
+ * the 64 bit remote signal by one. The increment is issued from the
+ * completion of an endpoint flush following the put, so the data is visible
+ * on dest once the signal is observed there. Only operations to dest are
+ * ordered, other traffic of the worker is not affected. Put is skipped when
+ * msglen is 0 and only the signal is delivered, still ordered after all
+ * previous operations to dest. The pair is accounted as a single put in
+ * task->onesided: the increment is only posted once the flush completed,
+ * so its completion implies the put has completed and buffer can be
+ * reused. A failed put is reported to the task and its signal is not
+ * delivered. */
+static inline ucc_status_t
+ucc_tl_ucp_put_signal_nb(void *buffer, void *target, size_t msglen,
+                         void *signal, ucc_rank_t dest_group_rank,
+                         ucc_tl_ucp_team_t *team, ucc_tl_ucp_task_t *task)
 {
-    ucp_request_param_t req_param = {0};
-    int                 segment   = 0;
-    uint64_t            one       = 1;
-    ucp_rkey_h          rkey      = NULL;
-    uint64_t            rva       = 0;
-    ucs_status_ptr_t    ucp_status;
-    ucc_status_t        status;
-    ucp_ep_h            ep;
+    ucp_request_param_t      req_param = {0};
+    int                      segment   = 0;
+    ucp_rkey_h               rkey      = NULL;
+    uint64_t                 rva       = 0;
+    ucc_tl_ucp_put_signal_t *sig;
+    ucs_status_ptr_t         ucp_status;
+    ucc_status_t             status;
+    ucp_ep_h                 ep;
 
     status = ucc_tl_ucp_get_ep(team, dest_group_rank, &ep);
     if (ucc_unlikely(UCC_OK != status)) {
         return status;
     }
 
-    status = ucc_tl_ucp_resolve_p2p_by_va(team, target, &ep, dest_group_rank,
-                                          &rva, &rkey, &segment);
+    if (msglen > 0) {
+        status = ucc_tl_ucp_resolve_p2p_by_va(team, task, target, &ep,
+                                              dest_group_rank, &rva, &rkey,
+                                              &segment);
+        if (ucc_unlikely(UCC_OK != status)) {
+            return status;
+        }
+        /* completion is tracked by the signal below, the callback only
+           reports errors */
+        req_param.op_attr_mask = UCP_OP_ATTR_FIELD_CALLBACK |
+                                 UCP_OP_ATTR_FIELD_USER_DATA;
+        req_param.cb.send      = ucc_tl_ucp_put_signal_put_cb;
+        req_param.user_data    = (void *)task;
+        ucp_status = ucp_put_nbx(ep, buffer, msglen, rva, rkey, &req_param);
+        if (UCS_PTR_IS_ERR(ucp_status)) {
+            return ucs_status_to_ucc_status(UCS_PTR_STATUS(ucp_status));
+        }
+    }
+
+    sig = ucc_mpool_get(&UCC_TL_UCP_TEAM_CTX(team)->put_signal_mp);
+    if (ucc_unlikely(!sig)) {
+        return UCC_ERR_NO_MEMORY;
+    }
+    status = ucc_tl_ucp_resolve_p2p_by_va(team, task, signal, &ep,
+                                          dest_group_rank, &sig->rva,
+                                          &sig->rkey, &segment);
     if (ucc_unlikely(UCC_OK != status)) {
+        ucc_mpool_put(sig);
         return status;
     }
+    sig->task = task;
+    sig->ep   = ep;
 
-    req_param.op_attr_mask = UCP_OP_ATTR_FIELD_DATATYPE;
-    req_param.datatype     = ucp_dt_make_contig(sizeof(uint64_t));
-
-    ucp_status = ucp_atomic_op_nbx(ep, UCP_ATOMIC_OP_ADD, &one, 1, rva, rkey,
-                                   &req_param);
+    req_param.op_attr_mask = UCP_OP_ATTR_FIELD_CALLBACK |
+                             UCP_OP_ATTR_FIELD_USER_DATA;
+    req_param.cb.send      = ucc_tl_ucp_put_signal_flush_cb;
+    req_param.user_data    = (void *)sig;
 
-    if (UCS_OK != ucp_status) {
-        if (UCS_PTR_IS_ERR(ucp_status)) {
-            return ucs_status_to_ucc_status(UCS_PTR_STATUS(ucp_status));
-        }
-        ucp_request_free(ucp_status);
+    task->onesided.put_posted++;
+    ucp_status = ucp_ep_flush_nbx(ep, &req_param);
+    if (UCS_OK == ucp_status) {
+        return ucc_tl_ucp_put_signal_post(sig);
+    }
+    if (UCS_PTR_IS_ERR(ucp_status)) {
+        ucc_mpool_put(sig);
+        return ucs_status_to_ucc_status(UCS_PTR_STATUS(ucp_status));
     }
     return UCC_OK;
 }
 
-static inline ucc_status_t
-ucc_tl_ucp_atomic_inc_block(void *target, ucc_rank_t dest_group_rank,
-                            ucc_tl_ucp_team_t *team)
+static inline ucc_status_t ucc_tl_ucp_atomic_inc(void      *target,
+                                                 ucc_rank_t dest_group_rank,
+                                                 ucc_tl_ucp_team_t *team)
 {
     ucp_request_param_t req_param = {0};
     int                 segment   = 0;
@@ -470,8 +662,9 @@ ucc_tl_ucp_atomic_inc_block(void *target, ucc_rank_t dest_group_rank,
         return status;
     }
 
-    status = ucc_tl_ucp_resolve_p2p_by_va(team, target, &ep, dest_group_rank,
-                                          &rva, &rkey, &segment);
+    status = ucc_tl_ucp_resolve_p2p_by_va(team, NULL, target, &ep,
+                                          dest_group_rank, &rva, &rkey,
+                                          &segment);
     if (ucc_unlikely(UCC_OK != status)) {
         return status;
     }
@@ -486,11 +679,6 @@ ucc_tl_ucp_atomic_inc_block(void *target, ucc_rank_t dest_group_rank,
         if (UCS_PTR_IS_ERR(ucp_status)) {
             return ucs_status_to_ucc_status(UCS_PTR_STATUS(ucp_status));
         }
-        ucs_status_t st;
-        do {
-            ucp_worker_progress(team->worker->ucp_worker);
-            st = ucp_request_check_status(ucp_status);
-        } while (st == UCS_INPROGRESS);
         ucp_request_free(ucp_status);
     }
     return UCC_OK;
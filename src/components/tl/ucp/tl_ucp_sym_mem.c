@@ -0,0 +1,376 @@
+/**
+ * Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "tl_ucp.h"
+#include "tl_ucp_ep.h"
+#include "tl_ucp_sendrecv.h"
+#include "utils/ucc_malloc.h"
+#include "utils/ucc_math.h"
+
+#define UCC_TL_UCP_SYM_HEAP_ALIGN UCC_CACHE_LINE_SIZE
+
+#define UCC_TL_UCP_SYM_HEAP_LOCK(_team)                                        \
+    do {                                                                       \
+        if (UCC_TL_CORE_CTX(_team)->thread_mode == UCC_THREAD_MULTIPLE) {      \
+            ucc_spin_lock(&(_team)->sym_heap_lock);                            \
+        }                                                                      \
+    } while (0)
+
+#define UCC_TL_UCP_SYM_HEAP_UNLOCK(_team)                                      \
+    do {                                                                       \
+        if (UCC_TL_CORE_CTX(_team)->thread_mode == UCC_THREAD_MULTIPLE) {      \
+            ucc_spin_unlock(&(_team)->sym_heap_lock);                          \
+        }                                                                      \
+    } while (0)
+
+static int ucc_tl_ucp_sym_mem_enabled(ucc_tl_ucp_team_t *team)
+{
+    ucc_tl_ucp_context_t *ctx = UCC_TL_UCP_TEAM_CTX(team);
+
+    /* RMA features are enabled on ucp context only when context was
+       created with mem params */
+    return ctx->remote_info && !IS_SERVICE_TEAM(team) &&
+           team->super.super.params.scope == UCC_CL_BASIC &&
+           UCC_TL_TEAM_SIZE(team) > 1 &&
+           (team->cfg.onesided_scratch_size > 0 ||
+            team->cfg.onesided_heap_size > 0);
+}
+
+static void ucc_tl_ucp_sym_mem_local_init(ucc_tl_ucp_team_t     *team,
+                                          ucc_tl_ucp_sym_info_t *local)
+{
+    ucc_tl_ucp_context_t *ctx  = UCC_TL_UCP_TEAM_CTX(team);
+    ucc_tl_ucp_sym_mem_t *sym  = &team->sym;
+    size_t                heap_offset =
+        UCC_TL_UCP_SYM_SIGNALS_SIZE +
+        ucc_align_up(team->cfg.onesided_scratch_size,
+                     UCC_TL_UCP_SYM_SIGNALS_SIZE);
+    size_t                len  = heap_offset +
+                                 ucc_align_up(team->cfg.onesided_heap_size,
+                                              UCC_TL_UCP_SYM_SIGNALS_SIZE);
+    ucp_mem_map_params_t  mmap_params;
+    void                 *packed_key;
+    size_t                packed_key_len;
+    ucs_status_t          status;
+
+    local->va_base        = 0;
+    local->packed_key_len = 0;
+
+    if (ucc_posix_memalign(&sym->va_base, UCC_TL_UCP_SYM_SIGNALS_SIZE, len,
+                           "sym_mem")) {
+        tl_warn(UCC_TL_TEAM_LIB(team),
+                "failed to allocate %zd bytes for symmetric scratch", len);
+        sym->va_base = NULL;
+        return;
+    }
+    memset(sym->va_base, 0, UCC_TL_UCP_SYM_SIGNALS_SIZE);
+
+    mmap_params.field_mask =
+        UCP_MEM_MAP_PARAM_FIELD_ADDRESS | UCP_MEM_MAP_PARAM_FIELD_LENGTH;
+    mmap_params.address = sym->va_base;
+    mmap_params.length  = len;
+    status = ucp_mem_map(ctx->worker.ucp_context, &mmap_params, &sym->memh);
+    if (UCS_OK != status) {
+        tl_warn(UCC_TL_TEAM_LIB(team), "ucp_mem_map failed: %s",
+                ucs_status_string(status));
+        goto err_map;
+    }
+    status = ucp_rkey_pack(ctx->worker.ucp_context, sym->memh, &packed_key,
+                           &packed_key_len);
+    if (UCS_OK != status) {
+        tl_warn(UCC_TL_TEAM_LIB(team), "ucp_rkey_pack failed: %s",
+                ucs_status_string(status));
+        goto err_pack;
+    }
+    if (packed_key_len > UCC_TL_UCP_SYM_PACKED_KEY_MAX_LEN) {
+        tl_warn(UCC_TL_TEAM_LIB(team),
+                "packed key length %zd exceeds max supported %d",
+                packed_key_len, UCC_TL_UCP_SYM_PACKED_KEY_MAX_LEN);
+        ucp_rkey_buffer_release(packed_key);
+        goto err_pack;
+    }
+    memcpy(local->packed_key, packed_key, packed_key_len);
+    ucp_rkey_buffer_release(packed_key);
+    local->va_base        = (uint64_t)sym->va_base;
+    local->packed_key_len = packed_key_len;
+    sym->len              = len;
+    sym->heap_offset      = heap_offset;
+    return;
+
+err_pack:
+    ucp_mem_unmap(ctx->worker.ucp_context, sym->memh);
+err_map:
+    ucc_free(sym->va_base);
+    sym->va_base = NULL;
+    sym->memh    = NULL;
+}
+
+ucc_status_t ucc_tl_ucp_sym_mem_exchange(ucc_tl_ucp_team_t *team)
+{
+    ucc_tl_ucp_sym_mem_t *sym    = &team->sym;
+    ucc_rank_t            size   = UCC_TL_TEAM_SIZE(team);
+    ucc_subset_t          subset = {.map    = UCC_TL_TEAM_MAP(team),
+                                    .myrank = UCC_TL_TEAM_RANK(team)};
+    ucc_status_t          status;
+    ucc_rank_t            i;
+
+    if (!sym->info) {
+        if (!ucc_tl_ucp_sym_mem_enabled(team)) {
+            return UCC_OK;
+        }
+        sym->info = ucc_calloc(size + 1, sizeof(ucc_tl_ucp_sym_info_t),
+                               "sym_mem_info");
+        if (!sym->info) {
+            tl_error(UCC_TL_TEAM_LIB(team), "failed to allocate %zd bytes",
+                     (size + 1) * sizeof(ucc_tl_ucp_sym_info_t));
+            return UCC_ERR_NO_MEMORY;
+        }
+        /* local registration failure is not fatal: zero key length is
+           still exchanged so that all ranks disable the region together */
+        ucc_tl_ucp_sym_mem_local_init(team, &sym->info[size]);
+        status = ucc_service_allgather(
+            UCC_TL_CORE_TEAM(team), &sym->info[size], sym->info,
+            sizeof(ucc_tl_ucp_sym_info_t), subset, &sym->req);
+        if (UCC_OK != status) {
+            tl_error(UCC_TL_TEAM_LIB(team),
+                     "failed to post symmetric memory info exchange");
+            return status;
+        }
+    }
+    if (!sym->req) {
+        return UCC_OK;
+    }
+    status = ucc_service_coll_test(sym->req);
+    if (UCC_INPROGRESS == status) {
+        return status;
+    }
+    ucc_service_coll_finalize(sym->req);
+    sym->req = NULL;
+    if (status < 0) {
+        tl_error(UCC_TL_TEAM_LIB(team),
+                 "failure during symmetric memory info exchange: %s",
+                 ucc_status_string(status));
+        return status;
+    }
+
+    for (i = 0; i < size; i++) {
+        if (0 == sym->info[i].packed_key_len) {
+            tl_debug(UCC_TL_TEAM_LIB(team),
+                     "symmetric scratch is not available on rank %d, "
+                     "disabling", i);
+            ucc_tl_ucp_sym_mem_cleanup(team);
+            return UCC_OK;
+        }
+    }
+    sym->rkeys = ucc_calloc(size, sizeof(ucp_rkey_h), "sym_mem_rkeys");
+    if (!sym->rkeys) {
+        tl_error(UCC_TL_TEAM_LIB(team), "failed to allocate %zd bytes",
+                 size * sizeof(ucp_rkey_h));
+        ucc_tl_ucp_sym_mem_cleanup(team);
+        return UCC_ERR_NO_MEMORY;
+    }
+    tl_debug(UCC_TL_TEAM_LIB(team),
+             "symmetric scratch %p len %zd is ready on team %p", sym->va_base,
+             sym->len, team);
+    return UCC_OK;
+}
+
+void ucc_tl_ucp_sym_mem_cleanup(ucc_tl_ucp_team_t *team)
+{
+    ucc_tl_ucp_context_t *ctx = UCC_TL_UCP_TEAM_CTX(team);
+    ucc_tl_ucp_sym_mem_t *sym = &team->sym;
+    ucc_rank_t            i;
+
+    if (sym->req) {
+        ucc_service_coll_finalize(sym->req);
+    }
+    if (sym->rkeys) {
+        for (i = 0; i < UCC_TL_TEAM_SIZE(team); i++) {
+            if (sym->rkeys[i]) {
+                ucp_rkey_destroy(sym->rkeys[i]);
+            }
+        }
+        ucc_free(sym->rkeys);
+    }
+    if (sym->memh) {
+        ucp_mem_unmap(ctx->worker.ucp_context, sym->memh);
+    }
+    for (i = 0; i < sym->n_heap_blocks; i++) {
+        if (sym->heap[i].used) {
+            tl_warn(UCC_TL_TEAM_LIB(team),
+                    "symmetric heap buffer %p of size %zd was not released",
+                    PTR_OFFSET(UCC_TL_UCP_SYM_HEAP(team), sym->heap[i].offset),
+                    sym->heap[i].size);
+        }
+    }
+    ucc_free(sym->heap);
+    ucc_free(sym->va_base);
+    ucc_free(sym->info);
+    memset(sym, 0, sizeof(*sym));
+}
+
+/* The heap is symmetric as long as all ranks allocate and free the same
+   sizes in the same order: first fit over the blocks sorted by offset is
+   deterministic, so every rank ends up with the same offset */
+static ucc_status_t ucc_tl_ucp_sym_heap_init(ucc_tl_ucp_team_t *team)
+{
+    ucc_tl_ucp_sym_mem_t *sym = &team->sym;
+    ucc_status_t          status;
+    ucp_rkey_h            rkey;
+    uint64_t              rva;
+    ucc_rank_t            peer;
+    ucp_ep_h              ep;
+
+    /* buffers are handed out for immediate use by one-sided collectives,
+       so remote keys are unpacked upfront rather than on the first put */
+    for (peer = 0; peer < UCC_TL_TEAM_SIZE(team); peer++) {
+        status = ucc_tl_ucp_get_ep(team, peer, &ep);
+        if (UCC_OK != status) {
+            return status;
+        }
+        status = ucc_tl_ucp_resolve_sym_by_va(team, sym->va_base, &ep, peer,
+                                              &rva, &rkey);
+        if (UCC_OK != status) {
+            tl_error(UCC_TL_TEAM_LIB(team),
+                     "failed to unpack symmetric heap rkey of rank %d", peer);
+            return status;
+        }
+    }
+    sym->max_heap_blocks = 16;
+    sym->heap = ucc_malloc(sym->max_heap_blocks * sizeof(*sym->heap),
+                           "sym_heap_blocks");
+    if (!sym->heap) {
+        tl_error(UCC_TL_TEAM_LIB(team), "failed to allocate %zd bytes",
+                 sym->max_heap_blocks * sizeof(*sym->heap));
+        return UCC_ERR_NO_MEMORY;
+    }
+    sym->heap[0].offset = 0;
+    sym->heap[0].size   = UCC_TL_UCP_SYM_HEAP_SIZE(team);
+    sym->heap[0].used   = 0;
+    sym->n_heap_blocks  = 1;
+    return UCC_OK;
+}
+
+static ucc_status_t ucc_tl_ucp_sym_heap_alloc(ucc_tl_ucp_team_t *team,
+                                              size_t size, void **buffer)
+{
+    ucc_tl_ucp_sym_mem_t        *sym  = &team->sym;
+    ucc_tl_ucp_sym_heap_block_t *heap;
+    ucc_status_t                 status;
+    unsigned                     i;
+
+    if (!UCC_TL_UCP_TEAM_HAS_SYM(team) ||
+        0 == UCC_TL_UCP_SYM_HEAP_SIZE(team)) {
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    if (!sym->heap) {
+        status = ucc_tl_ucp_sym_heap_init(team);
+        if (UCC_OK != status) {
+            return status;
+        }
+    }
+    size = ucc_align_up(ucc_max(size, 1), UCC_TL_UCP_SYM_HEAP_ALIGN);
+    for (i = 0; i < sym->n_heap_blocks; i++) {
+        if (!sym->heap[i].used && sym->heap[i].size >= size) {
+            break;
+        }
+    }
+    if (i == sym->n_heap_blocks) {
+        tl_error(UCC_TL_TEAM_LIB(team),
+                 "symmetric heap of size %zd can not fit %zd bytes, "
+                 "consider increasing UCC_TL_UCP_ONESIDED_HEAP_SIZE",
+                 UCC_TL_UCP_SYM_HEAP_SIZE(team), size);
+        return UCC_ERR_NO_RESOURCE;
+    }
+    if (sym->heap[i].size > size) {
+        /* split, the remainder stays free right after the new buffer */
+        if (sym->n_heap_blocks == sym->max_heap_blocks) {
+            heap = ucc_realloc(sym->heap,
+                               2 * sym->max_heap_blocks * sizeof(*heap),
+                               "sym_heap_blocks");
+            if (!heap) {
+                tl_error(UCC_TL_TEAM_LIB(team), "failed to allocate %zd bytes",
+                         2 * sym->max_heap_blocks * sizeof(*heap));
+                return UCC_ERR_NO_MEMORY;
+            }
+            sym->heap             = heap;
+            sym->max_heap_blocks *= 2;
+        }
+        memmove(&sym->heap[i + 2], &sym->heap[i + 1],
+                (sym->n_heap_blocks - i - 1) * sizeof(*sym->heap));
+        sym->heap[i + 1].offset = sym->heap[i].offset + size;
+        sym->heap[i + 1].size   = sym->heap[i].size - size;
+        sym->heap[i + 1].used   = 0;
+        sym->heap[i].size       = size;
+        sym->n_heap_blocks++;
+    }
+    sym->heap[i].used = 1;
+    *buffer = PTR_OFFSET(UCC_TL_UCP_SYM_HEAP(team), sym->heap[i].offset);
+    return UCC_OK;
+}
+
+static ucc_status_t ucc_tl_ucp_sym_heap_free(ucc_tl_ucp_team_t *team,
+                                             void              *buffer)
+{
+    ucc_tl_ucp_sym_mem_t *sym  = &team->sym;
+    unsigned              i, first, n_merged;
+    size_t                offset;
+
+    if (!sym->heap || (uint64_t)buffer < (uint64_t)UCC_TL_UCP_SYM_HEAP(team) ||
+        (uint64_t)buffer >= (uint64_t)sym->va_base + sym->len) {
+        return UCC_ERR_NOT_FOUND;
+    }
+    offset = (uint64_t)buffer - (uint64_t)UCC_TL_UCP_SYM_HEAP(team);
+    for (i = 0; i < sym->n_heap_blocks; i++) {
+        if (sym->heap[i].offset == offset) {
+            break;
+        }
+    }
+    if (i == sym->n_heap_blocks || !sym->heap[i].used) {
+        tl_error(UCC_TL_TEAM_LIB(team),
+                 "buffer %p is not an allocated symmetric heap buffer", buffer);
+        return UCC_ERR_INVALID_PARAM;
+    }
+    sym->heap[i].used = 0;
+    /* coalesce with free neighbours */
+    first = (i > 0 && !sym->heap[i - 1].used) ? i - 1 : i;
+    n_merged = 0;
+    while (first + n_merged + 1 < sym->n_heap_blocks &&
+           !sym->heap[first + n_merged + 1].used) {
+        sym->heap[first].size += sym->heap[first + n_merged + 1].size;
+        n_merged++;
+    }
+    if (n_merged) {
+        memmove(&sym->heap[first + 1], &sym->heap[first + n_merged + 1],
+                (sym->n_heap_blocks - first - n_merged - 1) *
+                    sizeof(*sym->heap));
+        sym->n_heap_blocks -= n_merged;
+    }
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_team_mem_alloc(ucc_base_team_t *tl_team, size_t size,
+                                       void **buffer)
+{
+    ucc_tl_ucp_team_t *team = ucc_derived_of(tl_team, ucc_tl_ucp_team_t);
+    ucc_status_t       status;
+
+    UCC_TL_UCP_SYM_HEAP_LOCK(team);
+    status = ucc_tl_ucp_sym_heap_alloc(team, size, buffer);
+    UCC_TL_UCP_SYM_HEAP_UNLOCK(team);
+    return status;
+}
+
+ucc_status_t ucc_tl_ucp_team_mem_free(ucc_base_team_t *tl_team, void *buffer)
+{
+    ucc_tl_ucp_team_t *team = ucc_derived_of(tl_team, ucc_tl_ucp_team_t);
+    ucc_status_t       status;
+
+    UCC_TL_UCP_SYM_HEAP_LOCK(team);
+    status = ucc_tl_ucp_sym_heap_free(team, buffer);
+    UCC_TL_UCP_SYM_HEAP_UNLOCK(team);
+    return status;
+}
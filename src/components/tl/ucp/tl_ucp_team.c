@@ -59,6 +59,11 @@ UCC_CLASS_INIT_FUNC(ucc_tl_ucp_team_t, ucc_base_context_t *tl_context,
     self->tuning_str      = "";
     self->topo            = NULL;
     self->opt_radix       = UCC_UUNITS_AUTO_RADIX;
+    self->seg_rvas        = NULL;
+    self->seg_rkeys       = NULL;
+    memset(&self->sym, 0, sizeof(self->sym));
+    ucc_list_head_init(&self->sym.waiters);
+    ucc_spinlock_init(&self->sym_heap_lock, 0);
 
     status = ucc_config_clone_table(&UCC_TL_UCP_TEAM_LIB(self)->cfg, &self->cfg,
                                     ucc_tl_ucp_lib_config_table);
@@ -106,6 +111,7 @@ UCC_CLASS_INIT_FUNC(ucc_tl_ucp_team_t, ucc_base_context_t *tl_context,
 
 UCC_CLASS_CLEANUP_FUNC(ucc_tl_ucp_team_t)
 {
+    ucc_spinlock_destroy(&self->sym_heap_lock);
     ucc_config_parser_release_opts(&self->cfg, ucc_tl_ucp_lib_config_table);
     tl_debug(self->super.super.context->lib, "finalizing tl team: %p", self);
 }
@@ -117,6 +123,9 @@ ucc_status_t ucc_tl_ucp_team_destroy(ucc_base_team_t *tl_team)
 {
     ucc_tl_ucp_team_t *team = ucc_derived_of(tl_team, ucc_tl_ucp_team_t);
 
+    ucc_tl_ucp_sym_mem_cleanup(team);
+    ucc_free(team->seg_rvas);
+    ucc_free(team->seg_rkeys);
     if (team->topo) {
         ucc_ep_map_destroy_nested(&team->ctx_map);
         ucc_topo_cleanup(team->topo);
@@ -166,6 +175,67 @@ static ucc_status_t ucc_tl_ucp_team_preconnect(ucc_tl_ucp_team_t *team)
     return UCC_OK;
 }
 
+static ucc_status_t ucc_tl_ucp_team_seg_cache_init(ucc_tl_ucp_team_t *team)
+{
+    size_t n = UCC_TL_TEAM_SIZE(team) * UCC_TL_UCP_TEAM_CTX(team)->n_rinfo_segs;
+
+    team->seg_rvas  = ucc_calloc(n, sizeof(uint64_t), "seg_rvas");
+    team->seg_rkeys = ucc_calloc(n, sizeof(ucp_rkey_h), "seg_rkeys");
+    if (!team->seg_rvas || !team->seg_rkeys) {
+        tl_error(UCC_TL_TEAM_LIB(team), "failed to allocate %zd bytes",
+                 n * (sizeof(uint64_t) + sizeof(ucp_rkey_h)));
+        ucc_free(team->seg_rvas);
+        ucc_free(team->seg_rkeys);
+        team->seg_rvas  = NULL;
+        team->seg_rkeys = NULL;
+        return UCC_ERR_NO_MEMORY;
+    }
+    return UCC_OK;
+}
+
+/* Connects all team eps and unpacks rkeys of every mapped segment and of
+   the symmetric region, so that the first collective does not pay for it */
+static ucc_status_t ucc_tl_ucp_team_unpack_rkeys(ucc_tl_ucp_team_t *team)
+{
+    ucc_tl_ucp_context_t *ctx = UCC_TL_UCP_TEAM_CTX(team);
+    ucc_status_t          status;
+    ucp_rkey_h            rkey;
+    uint64_t              rva;
+    ucc_rank_t            peer;
+    ucp_ep_h              ep;
+    int                   i;
+
+    if (!team->seg_rkeys && !UCC_TL_UCP_TEAM_HAS_SYM(team)) {
+        return UCC_OK;
+    }
+    for (peer = 0; peer < UCC_TL_TEAM_SIZE(team); peer++) {
+        status = ucc_tl_ucp_get_ep(team, peer, &ep);
+        if (UCC_OK != status) {
+            return status;
+        }
+        for (i = 0; team->seg_rkeys && i < ctx->n_rinfo_segs; i++) {
+            status = ucc_tl_ucp_resolve_segment(team, ep, peer, i);
+            if (UCC_OK != status) {
+                tl_error(UCC_TL_TEAM_LIB(team),
+                         "failed to unpack rkey of segment %d of rank %d", i,
+                         peer);
+                return status;
+            }
+        }
+        if (UCC_TL_UCP_TEAM_HAS_SYM(team)) {
+            status = ucc_tl_ucp_resolve_sym_by_va(team, team->sym.va_base, &ep,
+                                                  peer, &rva, &rkey);
+            if (UCC_OK != status) {
+                tl_error(UCC_TL_TEAM_LIB(team),
+                         "failed to unpack symmetric scratch rkey of rank %d",
+                         peer);
+                return status;
+            }
+        }
+    }
+    return UCC_OK;
+}
+
 ucc_status_t ucc_tl_ucp_team_create_test(ucc_base_team_t *tl_team)
 {
     ucc_tl_ucp_team_t *   team = ucc_derived_of(tl_team, ucc_tl_ucp_team_t);
@@ -192,11 +262,29 @@ ucc_status_t ucc_tl_ucp_team_create_test(ucc_base_team_t *tl_team)
         }
     }
 
-    if (ctx->remote_info) {
+    if (ctx->remote_info && !team->seg_rkeys) {
         for (i = 0; i < ctx->n_rinfo_segs; i++) {
             team->va_base[i]     = ctx->remote_info[i].va_base;
             team->base_length[i] = ctx->remote_info[i].len;
         }
+        status = ucc_tl_ucp_team_seg_cache_init(team);
+        if (UCC_OK != status) {
+            return status;
+        }
+    }
+
+    status = ucc_tl_ucp_sym_mem_exchange(team);
+    if (UCC_INPROGRESS == status) {
+        return UCC_INPROGRESS;
+    } else if (UCC_OK != status) {
+        return status;
+    }
+
+    if (team->cfg.onesided_eager_rkey_unpack && !IS_SERVICE_TEAM(team)) {
+        status = ucc_tl_ucp_team_unpack_rkeys(team);
+        if (UCC_OK != status) {
+            return status;
+        }
     }
 
     tl_debug(tl_team->context->lib, "initialized tl team: %p", team);
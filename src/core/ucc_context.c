@@ -12,7 +12,12 @@
 #include "utils/ucc_log.h"
 #include "utils/ucc_list.h"
 #include "utils/ucc_string.h"
+#include "utils/ucc_atomic.h"
 #include "ucc_progress_queue.h"
+#include <poll.h>
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
 
 static uint32_t ucc_context_seq_num = 0;
 static ucc_config_field_t ucc_context_config_table[] = {
@@ -27,6 +32,18 @@ static ucc_config_field_t ucc_context_config_table[] = {
      ucc_offsetof(ucc_context_config_t, lock_free_progress_q),
      UCC_CONFIG_TYPE_UINT},
 
+    {"WS_PROGRESS_Q_NUM_QUEUES", "0",
+     "Number of per thread queues of the work stealing progress queue used "
+     "in UCC_THREAD_MULTIPLE mode. 0 - disable work stealing queue",
+     ucc_offsetof(ucc_context_config_t, ws_progress_q_num_queues),
+     UCC_CONFIG_TYPE_UINT},
+
+    {"WS_PROGRESS_Q_BATCH", "8",
+     "Max number of tasks the work stealing progress queue drains or steals "
+     "per progress call",
+     ucc_offsetof(ucc_context_config_t, ws_progress_q_batch),
+     UCC_CONFIG_TYPE_UINT},
+
     {"ESTIMATED_NUM_PPN", "0",
      "An optimization hint of how many endpoints created on this context reside"
      " on the same node",
@@ -50,6 +67,13 @@ static ucc_config_field_t ucc_context_config_table[] = {
      ucc_offsetof(ucc_context_config_t, throttle_progress),
      UCC_CONFIG_TYPE_UINT},
 
+    {"PROGRESS_THREAD", "n",
+     "Start an internal thread that progresses the context, so that "
+     "nonblocking collectives advance while the application does not call "
+     "ucc_context_progress. Requires UCC_THREAD_MULTIPLE",
+     ucc_offsetof(ucc_context_config_t, progress_thread),
+     UCC_CONFIG_TYPE_BOOL},
+
     {NULL}};
 UCC_CONFIG_REGISTER_TABLE(ucc_context_config_table, "UCC context", NULL,
                           ucc_context_config_t, &ucc_config_global_list);
@@ -591,6 +615,76 @@ static void remove_tl_ctx_from_array(ucc_tl_context_t **array, unsigned *size,
     }
 }
 
+/* upper bound of the idle sleep of the progress thread, also the worst
+   case delay before the thread picks up a newly posted collective */
+#define UCC_CONTEXT_PROGRESS_THREAD_MAX_SLEEP_US 128
+
+static inline void ucc_context_progress_list(ucc_context_t *ctx)
+{
+    ucc_context_progress_entry_t *entry;
+
+    ucc_list_for_each(entry, &ctx->progress_list, list_elem) {
+        entry->fn(entry->arg);
+    }
+}
+
+static void *ucc_context_progress_thread(void *arg)
+{
+    ucc_context_t *ctx      = arg;
+    unsigned       sleep_us = 0;
+
+    while (!ctx->progress_thread_stop) {
+        if (!ucc_progress_queue_is_empty(ctx->pq)) {
+            ucc_progress_queue(ctx->pq);
+            sleep_us = 0;
+            continue;
+        }
+        /* nothing posted: run the registered progress functions on every
+           wake up rather than every THROTTLE_PROGRESS calls, and back off
+           exponentially so that an idle context does not burn a core */
+        ucc_context_progress_list(ctx);
+        if (sleep_us) {
+            usleep(sleep_us);
+        }
+        sleep_us = sleep_us ? 2 * sleep_us : 1;
+        if (sleep_us > UCC_CONTEXT_PROGRESS_THREAD_MAX_SLEEP_US) {
+            sleep_us = UCC_CONTEXT_PROGRESS_THREAD_MAX_SLEEP_US;
+        }
+    }
+    return NULL;
+}
+
+static void ucc_context_progress_thread_start(ucc_context_t *ctx)
+{
+    int ret;
+
+    if (ctx->thread_mode != UCC_THREAD_MULTIPLE) {
+        ucc_warn("progress thread requires UCC_THREAD_MULTIPLE, "
+                 "context %p is progressed by the application only", ctx);
+        return;
+    }
+    ctx->progress_thread_stop = 0;
+    ret = pthread_create(&ctx->progress_thread, NULL,
+                         ucc_context_progress_thread, ctx);
+    if (ret != 0) {
+        ucc_warn("failed to start progress thread for context %p, "
+                 "error: %d(%s)", ctx, ret, strerror(ret));
+        return;
+    }
+    ctx->progress_thread_running = 1;
+    ucc_debug("started progress thread for context %p", ctx);
+}
+
+static void ucc_context_progress_thread_stop(ucc_context_t *ctx)
+{
+    if (!ctx->progress_thread_running) {
+        return;
+    }
+    ctx->progress_thread_stop = 1;
+    pthread_join(ctx->progress_thread, NULL);
+    ctx->progress_thread_running = 0;
+}
+
 ucc_status_t ucc_context_create_proc_info(ucc_lib_h                   lib,
                                           const ucc_context_params_t *params,
                                           const ucc_context_config_h  config,
@@ -708,11 +802,21 @@ ucc_status_t ucc_context_create_proc_info(ucc_lib_h                   lib,
                            ? UCC_THREAD_SINGLE
                            : lib->attr.thread_mode;
     status           = ucc_progress_queue_init(&ctx->pq, ctx->thread_mode,
-                                               config->lock_free_progress_q);
+                                               config->lock_free_progress_q,
+                                               config->ws_progress_q_num_queues,
+                                               config->ws_progress_q_batch);
     if (UCC_OK != status) {
         ucc_error("failed to init progress queue for context %p", ctx);
         goto error_ctx_create;
     }
+    status = ucc_mpool_init(&ctx->schedule_lists_mp, 0,
+                            UCC_SCHEDULE_POOL_TASKS * sizeof(void *), 0,
+                            UCC_CACHE_LINE_SIZE, 8, UINT_MAX, NULL,
+                            ctx->thread_mode, "schedule_lists_mp");
+    if (UCC_OK != status) {
+        ucc_error("failed to init schedule lists mpool for context %p", ctx);
+        goto error_ctx_pq;
+    }
     ctx->id.pi      = *proc_info;
     ctx->id.seq_num = ucc_atomic_fadd32(&ucc_context_seq_num, 1);
     if (params->mask & UCC_CONTEXT_PARAM_FIELD_OOB &&
@@ -724,7 +828,7 @@ ucc_status_t ucc_context_create_proc_info(ucc_lib_h                   lib,
                                             &ctx->addr_storage);
             if (status < 0) {
                 ucc_error("failed to exchange addresses during context creation");
-                goto error_ctx_create;
+                goto error_ctx_mp;
             }
         } while (status == UCC_INPROGRESS);
 
@@ -734,7 +838,7 @@ ucc_status_t ucc_context_create_proc_info(ucc_lib_h                   lib,
             if (UCC_OK != status) {
                 ucc_free(ctx->addr_storage.storage);
                 ucc_error("failed to init ctx topo");
-                goto error_ctx_create;
+                goto error_ctx_mp;
             }
         }
         ucc_assert(ctx->addr_storage.rank == params->oob.oob_ep);
@@ -750,7 +854,7 @@ ucc_status_t ucc_context_create_proc_info(ucc_lib_h                   lib,
                     ucc_error(
                         "TL UCP context is not available, service team can "
                         "not be created but was force requested");
-                    goto error_ctx_create;
+                    goto error_ctx_mp;
                 }
                 ucc_debug("TL UCP context is not available, "
                           "service team can not be created");
@@ -781,7 +885,7 @@ ucc_status_t ucc_context_create_proc_info(ucc_lib_h                   lib,
                                                 &t_params, &b_team);
                 if (UCC_OK != status) {
                     ucc_error("ctx service team create post failed");
-                    goto error_ctx_create;
+                    goto error_ctx_mp;
                 }
                 do {
                     status = UCC_TL_CTX_IFACE(ctx->service_ctx)
@@ -789,14 +893,14 @@ ucc_status_t ucc_context_create_proc_info(ucc_lib_h                   lib,
                 } while (UCC_INPROGRESS == status);
                 if (status < 0) {
                     ucc_error("failed to create ctx service team");
-                    goto error_ctx_create;
+                    goto error_ctx_mp;
                 }
                 ctx->service_team = ucc_derived_of(b_team, ucc_tl_team_t);
             }
         } else if (config->internal_oob == 2) {
             ucc_error("UCC_INTERNAL_OOB was force requested for context "
                       "without OOB");
-            goto error_ctx_create;
+            goto error_ctx_mp;
         }
     }
 
@@ -836,6 +940,9 @@ ucc_status_t ucc_context_create_proc_info(ucc_lib_h                   lib,
         goto error_ctx_create_epilog;
     }
 
+    if (config->progress_thread) {
+        ucc_context_progress_thread_start(ctx);
+    }
     ucc_debug("created ucc context %p for lib %s", ctx, lib->full_prefix);
     *context = ctx;
     return UCC_OK;
@@ -846,6 +953,10 @@ error_ctx_create_epilog:
         tl_lib = ucc_derived_of(tl_ctx->super.lib, ucc_tl_lib_t);
         tl_lib->iface->context.destroy(&tl_ctx->super);
     }
+error_ctx_mp:
+    ucc_mpool_cleanup(&ctx->schedule_lists_mp, 1);
+error_ctx_pq:
+    ucc_progress_queue_finalize(ctx->pq);
 error_ctx_create:
     for (i = 0; i < ctx->n_cl_ctx; i++) {
         config->cl_cfgs[i]->cl_lib->iface->context.destroy(
@@ -884,6 +995,7 @@ ucc_status_t ucc_context_destroy(ucc_context_t *context)
     int               i;
     ucc_status_t      status;
 
+    ucc_context_progress_thread_stop(context);
     if (context->service_team) {
         while (UCC_INPROGRESS ==
                (status = UCC_TL_CTX_IFACE(context->service_ctx)
@@ -914,6 +1026,7 @@ ucc_status_t ucc_context_destroy(ucc_context_t *context)
         tl_lib->iface->context.destroy(&tl_ctx->super);
     }
     ucc_context_topo_cleanup(context->topo);
+    ucc_mpool_cleanup(&context->schedule_lists_mp, 1);
     ucc_progress_queue_finalize(context->pq);
     ucc_free(context->addr_storage.storage);
     ucc_free(context->all_tls.names);
@@ -963,22 +1076,24 @@ ucc_status_t ucc_context_progress_deregister(ucc_context_t *ctx,
 
 ucc_status_t ucc_context_progress(ucc_context_h context)
 {
-    static int                    call_num = 0;
-    ucc_status_t                  status;
-    ucc_context_progress_entry_t *entry;
-    int                           is_empty;
+    ucc_status_t status;
+    uint32_t     call_num;
+    int          is_empty;
 
     is_empty = ucc_progress_queue_is_empty(context->pq);
     if (ucc_likely(is_empty)) {
-        call_num--;
-        if (ucc_likely(call_num >= 0)) {
+        /* per context counter, may be hit by several threads in
+           UCC_THREAD_MULTIPLE */
+        if (context->thread_mode == UCC_THREAD_MULTIPLE) {
+            call_num = ucc_atomic_fadd32(&context->progress_call_num, 1);
+        } else {
+            call_num = context->progress_call_num++;
+        }
+        if (ucc_likely(call_num % ((uint32_t)context->throttle_progress + 1))) {
             return UCC_OK;
         }
         /* progress registered progress fns */
-        ucc_list_for_each(entry, &context->progress_list, list_elem) {
-            entry->fn(entry->arg);
-        }
-        call_num = context->throttle_progress;
+        ucc_context_progress_list(context);
         return UCC_OK;
     }
 
@@ -989,6 +1104,65 @@ ucc_status_t ucc_context_progress(ucc_context_h context)
     return (status >= 0 ? UCC_OK : status);
 }
 
+ucc_status_t ucc_context_wait(ucc_context_h context, int timeout)
+{
+    ucc_base_context_iface_t *iface;
+    ucc_tl_context_t         *tl_ctx;
+    ucc_tl_lib_t             *tl_lib;
+    struct pollfd            *fds;
+    ucc_status_t              status;
+    int                       i, n_fds, ret;
+
+    fds = ucc_malloc(sizeof(*fds) * context->n_tl_ctx, "wait_fds");
+    if (!fds) {
+        ucc_error("failed to allocate %zd bytes for wait fds",
+                  sizeof(*fds) * context->n_tl_ctx);
+        return UCC_ERR_NO_MEMORY;
+    }
+    n_fds = 0;
+    for (i = 0; i < context->n_tl_ctx; i++) {
+        tl_ctx = context->tl_ctx[i];
+        tl_lib = ucc_derived_of(tl_ctx->super.lib, ucc_tl_lib_t);
+        iface  = &tl_lib->iface->context;
+        if (!iface->get_event_fd || !iface->arm) {
+            continue;
+        }
+        status = iface->get_event_fd(&tl_ctx->super, &fds[n_fds].fd);
+        if (UCC_ERR_NOT_SUPPORTED == status) {
+            continue;
+        } else if (UCC_OK != status) {
+            goto out;
+        }
+        status = iface->arm(&tl_ctx->super);
+        if (UCC_INPROGRESS == status) {
+            /* events are pending, caller has to progress the context */
+            status = UCC_OK;
+            goto out;
+        } else if (UCC_OK != status) {
+            ucc_error("failed to arm tl context %s: %s",
+                      tl_lib->iface->super.name, ucc_status_string(status));
+            goto out;
+        }
+        fds[n_fds].events = POLLIN;
+        n_fds++;
+    }
+    if (n_fds == 0) {
+        status = UCC_ERR_NOT_SUPPORTED;
+        goto out;
+    }
+
+    status = UCC_OK;
+    ret    = poll(fds, n_fds, timeout);
+    if (ret < 0 && errno != EINTR) {
+        ucc_error("poll on context event fds failed, errno: %d(%s)", errno,
+                  strerror(errno));
+        status = UCC_ERR_NO_MESSAGE;
+    }
+out:
+    ucc_free(fds);
+    return status;
+}
+
 static ucc_status_t ucc_context_pack_addr(ucc_context_t             *context,
                                           ucc_context_addr_len_t    *addr_len,
                                           int                       *n_packed,
@@ -10,8 +10,10 @@
 #include "ucc/api/ucc.h"
 #include "ucc_progress_queue.h"
 #include "utils/ucc_list.h"
+#include "utils/ucc_mpool.h"
 #include "utils/ucc_proc_info.h"
 #include "components/topo/ucc_topo.h"
+#include <pthread.h>
 
 typedef struct ucc_lib_info          ucc_lib_info_t;
 typedef struct ucc_cl_context        ucc_cl_context_t;
@@ -67,6 +69,8 @@ typedef struct ucc_context {
     ucc_config_names_array_t all_tls;
     ucc_list_link_t          progress_list;
     ucc_progress_queue_t    *pq;
+    /* task and frag lists of schedules that outgrow their inline ones */
+    ucc_mpool_t              schedule_lists_mp;
     ucc_team_id_pool_t       ids;
     ucc_context_id_t         id;
     ucc_addr_storage_t       addr_storage;
@@ -78,6 +82,10 @@ typedef struct ucc_context {
     uint64_t                 cl_flags;
     ucc_tl_team_t           *service_team;
     int32_t                  throttle_progress;
+    uint32_t                 progress_call_num; /* atomic in THREAD_MULTIPLE */
+    pthread_t                progress_thread;
+    int                      progress_thread_running;
+    volatile int             progress_thread_stop;
 } ucc_context_t;
 
 typedef struct ucc_context_config {
@@ -90,8 +98,11 @@ typedef struct ucc_context_config {
     uint32_t                  estimated_num_eps;
     uint32_t                  estimated_num_ppn;
     uint32_t                  lock_free_progress_q;
+    uint32_t                  ws_progress_q_num_queues;
+    uint32_t                  ws_progress_q_batch;
     uint32_t                  internal_oob;
     uint32_t                  throttle_progress;
+    int                       progress_thread;
 } ucc_context_config_t;
 
 /* Internal function for context creation that takes explicit
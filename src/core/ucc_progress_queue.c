@@ -8,16 +8,29 @@
 
 ucc_status_t ucc_pq_st_init(ucc_progress_queue_t **pq);
 ucc_status_t ucc_pq_mt_init(ucc_progress_queue_t **pq, uint32_t lock_free_progress_q);
+ucc_status_t ucc_pq_ws_init(ucc_progress_queue_t **pq, uint32_t n_queues,
+                            uint32_t batch);
 
 ucc_status_t ucc_progress_queue_init(ucc_progress_queue_t **pq,
                                      ucc_thread_mode_t      tm,
-                                     uint32_t lock_free_progress_q)
+                                     uint32_t lock_free_progress_q,
+                                     uint32_t ws_n_queues,
+                                     uint32_t ws_batch)
 {
+    ucc_status_t status;
+
     if (tm == UCC_THREAD_SINGLE) {
-        return ucc_pq_st_init(pq);
+        status = ucc_pq_st_init(pq);
+    } else if (ws_n_queues > 0) {
+        status = ucc_pq_ws_init(pq, ws_n_queues, ws_batch);
     } else { // TODO also for UCC_THREAD_FUNNELED?
-        return ucc_pq_mt_init(pq, lock_free_progress_q);
+        status = ucc_pq_mt_init(pq, lock_free_progress_q);
+    }
+    if (UCC_OK == status) {
+        (*pq)->n_tasks = 0;
+        (*pq)->is_mt   = (tm != UCC_THREAD_SINGLE);
     }
+    return status;
 }
 
 void ucc_progress_queue_finalize(ucc_progress_queue_t *pq)
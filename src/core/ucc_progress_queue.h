@@ -9,6 +9,7 @@
 
 #include "ucc/api/ucc.h"
 #include "schedule/ucc_schedule.h"
+#include "utils/ucc_atomic.h"
 
 typedef struct ucc_progress_queue ucc_progress_queue_t;
 struct ucc_progress_queue {
@@ -17,18 +18,43 @@ struct ucc_progress_queue {
     int  (*progress)(ucc_progress_queue_t *pq);
     int  (*is_empty)(ucc_progress_queue_t *pq);
     void (*finalize)(ucc_progress_queue_t *pq);
+    /* tasks in flight: enqueued and not completed yet, updated atomically
+       on multithreaded queues so it is exact but may be stale by the time
+       it is read */
+    uint32_t n_tasks;
+    int      is_mt;
 };
 
+/* ws_n_queues > 0 selects the work stealing queue in multithreaded mode,
+   lock_free_progress_q is ignored then */
 ucc_status_t ucc_progress_queue_init(ucc_progress_queue_t **pq,
                                      ucc_thread_mode_t tm,
-                                     uint32_t lock_free_progress_q);
+                                     uint32_t lock_free_progress_q,
+                                     uint32_t ws_n_queues,
+                                     uint32_t ws_batch);
 
 static inline void ucc_progress_enqueue(ucc_progress_queue_t *pq,
                                         ucc_coll_task_t *task)
 {
+    if (pq->is_mt) {
+        ucc_atomic_add32(&pq->n_tasks, 1);
+    } else {
+        pq->n_tasks++;
+    }
     pq->enqueue(pq, task);
 }
 
+/* to be called by the queue implementations when a task leaves the queue
+   for good, i.e. completes or times out */
+static inline void ucc_progress_queue_task_done(ucc_progress_queue_t *pq)
+{
+    if (pq->is_mt) {
+        ucc_atomic_sub32(&pq->n_tasks, 1);
+    } else {
+        pq->n_tasks--;
+    }
+}
+
 static inline ucc_status_t ucc_progress_queue_enqueue(ucc_progress_queue_t *pq,
                                                       ucc_coll_task_t *task)
 {
@@ -39,7 +65,7 @@ static inline ucc_status_t ucc_progress_queue_enqueue(ucc_progress_queue_t *pq,
     }
     /* set user visible status */
     task->super.status = UCC_INPROGRESS;
-    pq->enqueue(pq, task);
+    ucc_progress_enqueue(pq, task);
     return UCC_OK;
 }
 
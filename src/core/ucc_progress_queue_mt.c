@@ -85,6 +85,7 @@ static int ucc_pq_mt_progress(ucc_progress_queue_t *pq)
                 if (ucc_unlikely(timestamp - task->start_time >
                                  task->bargs.args.timeout)) {
                     task->status = UCC_ERR_TIMED_OUT;
+                    ucc_progress_queue_task_done(pq);
                     ucc_task_complete(task);
                     return UCC_ERR_TIMED_OUT;
                 }
@@ -93,6 +94,7 @@ static int ucc_pq_mt_progress(ucc_progress_queue_t *pq)
             pq->enqueue(pq, task);
             return n_progressed;
         }
+        ucc_progress_queue_task_done(pq);
         n_progressed++;
         if (ucc_unlikely(0 > (status = ucc_task_complete(task)))) {
             return status;
@@ -40,6 +40,7 @@ static int ucc_pq_st_progress(ucc_progress_queue_t *pq)
                                  task->bargs.args.timeout)) {
                     task->status = UCC_ERR_TIMED_OUT;
                     ucc_list_del(&task->list_elem);
+                    ucc_progress_queue_task_done(pq);
                     ucc_task_complete(task);
                     return UCC_ERR_TIMED_OUT;
                 }
@@ -47,6 +48,7 @@ static int ucc_pq_st_progress(ucc_progress_queue_t *pq)
             continue;
         }
         ucc_list_del(&task->list_elem);
+        ucc_progress_queue_task_done(pq);
         n_progressed++;
         if (0 > (status = ucc_task_complete(task))) {
             return status;
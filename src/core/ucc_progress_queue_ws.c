@@ -0,0 +1,229 @@
+/**
+ * Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "ucc_progress_queue.h"
+#include "utils/ucc_malloc.h"
+#include "utils/ucc_log.h"
+#include "utils/ucc_time.h"
+#include "utils/ucc_spinlock.h"
+#include "utils/ucc_list.h"
+#include "utils/ucc_atomic.h"
+#include "utils/ucc_math.h"
+#include "utils/ucc_coll_utils.h"
+
+/* Work stealing progress queue for UCC_THREAD_MULTIPLE mode. Tasks live in
+   several deques, every calling thread is bound to one of them (round robin
+   on the first use). A thread enqueues into and drains its own deque,
+   grabbing up to "batch" tasks under a single lock acquisition, so threads
+   working on their own collectives do not share cache lines. A thread whose
+   deque is empty steals half of the tasks (at most "batch") from the tail of
+   the first non empty deque it can lock without waiting. */
+
+typedef struct ucc_pq_ws_queue {
+    ucc_spinlock_t  lock;
+    ucc_list_link_t tasks;
+} __attribute__((aligned(UCC_CACHE_LINE_SIZE))) ucc_pq_ws_queue_t;
+
+typedef struct ucc_pq_ws {
+    ucc_progress_queue_t super;
+    uint32_t             n_queues;
+    uint32_t             batch;
+    ucc_pq_ws_queue_t   *queues;
+} ucc_pq_ws_t;
+
+static uint32_t            ucc_pq_ws_thread_counter = 0;
+static __thread int64_t    ucc_pq_ws_thread_id      = -1;
+
+static inline ucc_pq_ws_queue_t *ucc_pq_ws_my_queue(ucc_pq_ws_t *pq_ws)
+{
+    if (ucc_unlikely(ucc_pq_ws_thread_id < 0)) {
+        ucc_pq_ws_thread_id = ucc_atomic_fadd32(&ucc_pq_ws_thread_counter, 1);
+    }
+    return &pq_ws->queues[ucc_pq_ws_thread_id % pq_ws->n_queues];
+}
+
+static void ucc_pq_ws_enqueue(ucc_progress_queue_t *pq, ucc_coll_task_t *task)
+{
+    ucc_pq_ws_queue_t *q = ucc_pq_ws_my_queue(ucc_derived_of(pq, ucc_pq_ws_t));
+
+    ucc_spin_lock(&q->lock);
+    ucc_list_add_tail(&q->tasks, &task->list_elem);
+    ucc_spin_unlock(&q->lock);
+}
+
+/* moves up to n tasks from the head of own queue to the local batch */
+static int ucc_pq_ws_pop(ucc_pq_ws_queue_t *q, ucc_list_link_t *batch,
+                         uint32_t n)
+{
+    ucc_coll_task_t *task;
+    int              n_popped = 0;
+
+    if (ucc_list_is_empty(&q->tasks)) {
+        return 0;
+    }
+    ucc_spin_lock(&q->lock);
+    while (n_popped < n && !ucc_list_is_empty(&q->tasks)) {
+        task = ucc_list_extract_head(&q->tasks, ucc_coll_task_t, list_elem);
+        ucc_list_add_tail(batch, &task->list_elem);
+        n_popped++;
+    }
+    ucc_spin_unlock(&q->lock);
+    return n_popped;
+}
+
+/* moves up to half of the tasks of a victim queue, taken from its tail, to
+   the local batch. Busy victims are skipped rather than waited for */
+static int ucc_pq_ws_steal(ucc_pq_ws_t *pq_ws, ucc_pq_ws_queue_t *own,
+                           ucc_list_link_t *batch)
+{
+    uint32_t           start = (uint32_t)(own - pq_ws->queues);
+    ucc_pq_ws_queue_t *victim;
+    ucc_coll_task_t   *task;
+    uint32_t           i, n, n_stolen;
+
+    for (i = 1; i < pq_ws->n_queues; i++) {
+        victim = &pq_ws->queues[(start + i) % pq_ws->n_queues];
+        if (ucc_list_is_empty(&victim->tasks) ||
+            !ucc_spin_try_lock(&victim->lock)) {
+            continue;
+        }
+        n        = ucc_min((ucc_list_length(&victim->tasks) + 1) / 2,
+                           pq_ws->batch);
+        n_stolen = 0;
+        while (n_stolen < n) {
+            task = ucc_list_tail(&victim->tasks, ucc_coll_task_t, list_elem);
+            ucc_list_del(&task->list_elem);
+            ucc_list_add_tail(batch, &task->list_elem);
+            n_stolen++;
+        }
+        ucc_spin_unlock(&victim->lock);
+        if (n_stolen) {
+            return n_stolen;
+        }
+    }
+    return 0;
+}
+
+static int ucc_pq_ws_progress(ucc_progress_queue_t *pq)
+{
+    ucc_pq_ws_t       *pq_ws        = ucc_derived_of(pq, ucc_pq_ws_t);
+    ucc_pq_ws_queue_t *q            = ucc_pq_ws_my_queue(pq_ws);
+    int                n_progressed = 0;
+    double             timestamp    = -1;
+    ucc_status_t       status       = UCC_OK;
+    ucc_list_link_t    batch, pending;
+    ucc_coll_task_t   *task, *tmp;
+
+    ucc_list_head_init(&batch);
+    ucc_list_head_init(&pending);
+    if (!ucc_pq_ws_pop(q, &batch, pq_ws->batch) &&
+        !ucc_pq_ws_steal(pq_ws, q, &batch)) {
+        return 0;
+    }
+
+    ucc_list_for_each_safe(task, tmp, &batch, list_elem) {
+        ucc_list_del(&task->list_elem);
+        if (ucc_unlikely(status != UCC_OK)) {
+            /* error was hit earlier in this batch, return the rest as is */
+            ucc_list_add_tail(&pending, &task->list_elem);
+            continue;
+        }
+        if (task->progress) {
+            task->progress(task);
+        }
+        if (UCC_INPROGRESS == task->status) {
+            if (UCC_COLL_TIMEOUT_REQUIRED(task)) {
+                if (timestamp < 0) {
+                    timestamp = ucc_get_time();
+                }
+                if (ucc_unlikely(timestamp - task->start_time >
+                                 task->bargs.args.timeout)) {
+                    task->status = UCC_ERR_TIMED_OUT;
+                    ucc_progress_queue_task_done(pq);
+                    ucc_task_complete(task);
+                    status = UCC_ERR_TIMED_OUT;
+                    continue;
+                }
+            }
+            ucc_list_add_tail(&pending, &task->list_elem);
+            continue;
+        }
+        ucc_progress_queue_task_done(pq);
+        n_progressed++;
+        status = ucc_task_complete(task);
+        if (ucc_likely(status > 0)) {
+            status = UCC_OK;
+        }
+    }
+
+    if (!ucc_list_is_empty(&pending)) {
+        ucc_spin_lock(&q->lock);
+        ucc_list_splice_tail(&q->tasks, &pending);
+        ucc_spin_unlock(&q->lock);
+    }
+    return (status < 0) ? status : n_progressed;
+}
+
+static int ucc_pq_ws_is_empty(ucc_progress_queue_t *pq)
+{
+    ucc_pq_ws_t *pq_ws = ucc_derived_of(pq, ucc_pq_ws_t);
+    uint32_t     i;
+
+    /* not accurate, used for progress throttling only */
+    for (i = 0; i < pq_ws->n_queues; i++) {
+        if (!ucc_list_is_empty(&pq_ws->queues[i].tasks)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static void ucc_pq_ws_finalize(ucc_progress_queue_t *pq)
+{
+    ucc_pq_ws_t *pq_ws = ucc_derived_of(pq, ucc_pq_ws_t);
+    uint32_t     i;
+
+    for (i = 0; i < pq_ws->n_queues; i++) {
+        ucc_spinlock_destroy(&pq_ws->queues[i].lock);
+    }
+    ucc_free(pq_ws->queues);
+    ucc_free(pq_ws);
+}
+
+ucc_status_t ucc_pq_ws_init(ucc_progress_queue_t **pq, uint32_t n_queues,
+                            uint32_t batch)
+{
+    ucc_pq_ws_t *pq_ws;
+    uint32_t     i;
+
+    pq_ws = ucc_malloc(sizeof(*pq_ws), "pq_ws");
+    if (!pq_ws) {
+        ucc_error("failed to allocate %zd bytes for pq_ws", sizeof(*pq_ws));
+        return UCC_ERR_NO_MEMORY;
+    }
+    if (ucc_posix_memalign((void **)&pq_ws->queues, UCC_CACHE_LINE_SIZE,
+                           n_queues * sizeof(ucc_pq_ws_queue_t),
+                           "pq_ws_queues")) {
+        ucc_error("failed to allocate %zd bytes for pq_ws queues",
+                  n_queues * sizeof(ucc_pq_ws_queue_t));
+        ucc_free(pq_ws);
+        return UCC_ERR_NO_MEMORY;
+    }
+    for (i = 0; i < n_queues; i++) {
+        ucc_spinlock_init(&pq_ws->queues[i].lock, 0);
+        ucc_list_head_init(&pq_ws->queues[i].tasks);
+    }
+    pq_ws->n_queues       = n_queues;
+    pq_ws->batch          = ucc_max(batch, 1);
+    pq_ws->super.enqueue  = ucc_pq_ws_enqueue;
+    pq_ws->super.dequeue  = NULL;
+    pq_ws->super.progress = ucc_pq_ws_progress;
+    pq_ws->super.finalize = ucc_pq_ws_finalize;
+    pq_ws->super.is_empty = ucc_pq_ws_is_empty;
+    *pq                   = &pq_ws->super;
+    return UCC_OK;
+}
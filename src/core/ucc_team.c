@@ -555,6 +555,62 @@ ucc_status_t ucc_team_destroy(ucc_team_h team)
     return ucc_team_destroy_single(team);
 }
 
+ucc_status_t ucc_team_mem_alloc(ucc_team_h team, size_t size, void **buffer)
+{
+    ucc_base_team_iface_t *iface;
+    ucc_status_t           status;
+    int                    i;
+
+    if (NULL == team || NULL == buffer) {
+        ucc_error("ucc_team_mem_alloc: invalid params");
+        return UCC_ERR_INVALID_PARAM;
+    }
+    if (team->state != UCC_TEAM_ACTIVE) {
+        ucc_error("team %p is used before team_create is completed", team);
+        return UCC_ERR_INVALID_PARAM;
+    }
+    for (i = 0; i < team->n_cl_teams; i++) {
+        iface = &UCC_CL_TEAM_IFACE(team->cl_teams[i])->team;
+        if (!iface->mem_alloc) {
+            continue;
+        }
+        status = iface->mem_alloc(&team->cl_teams[i]->super, size, buffer);
+        if (UCC_ERR_NOT_SUPPORTED != status) {
+            return status;
+        }
+    }
+    ucc_debug("symmetric heap is not available on team %p", team);
+    return UCC_ERR_NOT_SUPPORTED;
+}
+
+ucc_status_t ucc_team_mem_free(ucc_team_h team, void *buffer)
+{
+    ucc_base_team_iface_t *iface;
+    ucc_status_t           status;
+    int                    i;
+
+    if (NULL == team) {
+        ucc_error("ucc_team_mem_free: invalid team handle: NULL");
+        return UCC_ERR_INVALID_PARAM;
+    }
+    if (NULL == buffer) {
+        return UCC_OK;
+    }
+    for (i = 0; i < team->n_cl_teams; i++) {
+        iface = &UCC_CL_TEAM_IFACE(team->cl_teams[i])->team;
+        if (!iface->mem_free) {
+            continue;
+        }
+        status = iface->mem_free(&team->cl_teams[i]->super, buffer);
+        if (UCC_ERR_NOT_FOUND != status) {
+            return status;
+        }
+    }
+    ucc_error("buffer %p was not allocated from symmetric heap of team %p",
+              buffer, team);
+    return UCC_ERR_INVALID_PARAM;
+}
+
 static inline int
 find_first_set_and_zero(uint64_t *value) {
     int i;
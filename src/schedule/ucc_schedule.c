@@ -1,10 +1,11 @@
 /**
- * Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * See file LICENSE for terms.
  */
 #include "ucc_schedule.h"
 #include "utils/ucc_compiler_def.h"
 #include "utils/ucc_mpool.h"
+#include "utils/ucc_math.h"
 #include "components/base/ucc_base_iface.h"
 #include "coll_score/ucc_coll_score.h"
 #include "core/ucc_context.h"
@@ -217,14 +218,74 @@ ucc_status_t ucc_schedule_init(ucc_schedule_t *schedule,
     schedule->super.flags |= UCC_COLL_TASK_FLAG_IS_SCHEDULE;
     schedule->ctx         = team->context->ucc_context;
     schedule->n_tasks     = 0;
+    schedule->max_tasks   = UCC_SCHEDULE_MAX_TASKS;
+    schedule->tasks       = schedule->tasks_inline;
     return status;
 }
 
+void **ucc_schedule_list_get(ucc_context_t *ctx, uint32_t n)
+{
+    void **list;
+
+    if (n <= UCC_SCHEDULE_POOL_TASKS) {
+        list = ucc_mpool_get(&ctx->schedule_lists_mp);
+    } else {
+        list = ucc_malloc(n * sizeof(*list), "schedule_list");
+    }
+    if (ucc_unlikely(!list)) {
+        ucc_error("failed to allocate %zd bytes for schedule list",
+                  ucc_max(n, UCC_SCHEDULE_POOL_TASKS) * sizeof(*list));
+    }
+    return list;
+}
+
+void ucc_schedule_list_put(void **list, uint32_t n)
+{
+    if (n <= UCC_SCHEDULE_POOL_TASKS) {
+        ucc_mpool_put(list);
+    } else {
+        ucc_free(list);
+    }
+}
+
+void ucc_schedule_free_tasks(ucc_schedule_t *schedule)
+{
+    if (schedule->tasks != schedule->tasks_inline) {
+        ucc_schedule_list_put((void **)schedule->tasks, schedule->max_tasks);
+        schedule->tasks     = schedule->tasks_inline;
+        schedule->max_tasks = UCC_SCHEDULE_MAX_TASKS;
+    }
+}
+
+static ucc_status_t ucc_schedule_grow_tasks(ucc_schedule_t *schedule)
+{
+    uint32_t          max_tasks = ucc_max(schedule->max_tasks * 2,
+                                          UCC_SCHEDULE_POOL_TASKS);
+    ucc_coll_task_t **tasks;
+
+    tasks = (ucc_coll_task_t **)ucc_schedule_list_get(schedule->ctx,
+                                                      max_tasks);
+    if (ucc_unlikely(!tasks)) {
+        return UCC_ERR_NO_MEMORY;
+    }
+    memcpy(tasks, schedule->tasks, schedule->n_tasks * sizeof(*tasks));
+    ucc_schedule_free_tasks(schedule);
+    schedule->tasks     = tasks;
+    schedule->max_tasks = max_tasks;
+    return UCC_OK;
+}
+
 ucc_status_t ucc_schedule_add_task(ucc_schedule_t *schedule,
                                    ucc_coll_task_t *task)
 {
     ucc_status_t status;
 
+    if (ucc_unlikely(schedule->n_tasks == schedule->max_tasks)) {
+        status = ucc_schedule_grow_tasks(schedule);
+        if (UCC_OK != status) {
+            return status;
+        }
+    }
     status = ucc_event_manager_subscribe(task, UCC_EVENT_COMPLETED_SCHEDULE,
                                          &schedule->super,
                                          ucc_schedule_completed_handler);
@@ -269,5 +330,6 @@ ucc_status_t ucc_schedule_finalize(ucc_coll_task_t *task)
             }
         }
     }
+    ucc_schedule_free_tasks(schedule);
     return status_overall;
 }
@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  *
  * See file LICENSE for terms.
  */
@@ -117,14 +117,21 @@ typedef struct ucc_coll_task {
 extern struct ucc_mpool_ops ucc_coll_task_mpool_ops;
 typedef struct ucc_context ucc_context_t;
 
-#define UCC_SCHEDULE_MAX_TASKS 8
+/* number of tasks stored inline in the schedule, schedules with more tasks
+   grow the task list in ucc_schedule_add_task: lists of up to
+   UCC_SCHEDULE_POOL_TASKS entries come from the context mpool, only longer
+   ones are allocated on the heap */
+#define UCC_SCHEDULE_MAX_TASKS  8
+#define UCC_SCHEDULE_POOL_TASKS 64
 
 typedef struct ucc_schedule {
-    ucc_coll_task_t  super;
-    uint32_t         n_completed_tasks;
-    uint32_t         n_tasks;
-    ucc_context_t   *ctx;
-    ucc_coll_task_t *tasks[UCC_SCHEDULE_MAX_TASKS];
+    ucc_coll_task_t   super;
+    uint32_t          n_completed_tasks;
+    uint32_t          n_tasks;
+    uint32_t          max_tasks;
+    ucc_context_t    *ctx;
+    ucc_coll_task_t **tasks;
+    ucc_coll_task_t  *tasks_inline[UCC_SCHEDULE_MAX_TASKS];
 } ucc_schedule_t;
 
 void ucc_coll_task_construct(ucc_coll_task_t *task);
@@ -153,6 +160,15 @@ ucc_status_t ucc_schedule_init(ucc_schedule_t *schedule,
 ucc_status_t ucc_schedule_add_task(ucc_schedule_t *schedule,
                                    ucc_coll_task_t *task);
 
+/* list of n pointers for task or frag lists of schedules of ctx */
+void **ucc_schedule_list_get(ucc_context_t *ctx, uint32_t n);
+
+void ucc_schedule_list_put(void **list, uint32_t n);
+
+/* releases the task list of a schedule that outgrew tasks_inline, to be
+   called when a schedule is released without ucc_schedule_finalize */
+void ucc_schedule_free_tasks(ucc_schedule_t *schedule);
+
 ucc_status_t ucc_schedule_start(ucc_coll_task_t *task);
 
 ucc_status_t ucc_task_start_handler(ucc_coll_task_t *parent,
@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  *
  * See file LICENSE for terms.
  */
@@ -109,6 +109,11 @@ ucc_status_t ucc_schedule_pipelined_finalize(ucc_coll_task_t *task)
         schedule_p->frags[i]->super.finalize(&frags[i]->super);
     }
 
+    if (frags != schedule_p->frags_inline) {
+        ucc_schedule_list_put((void **)frags, schedule_p->n_frags);
+        schedule_p->frags = schedule_p->frags_inline;
+    }
+
     if (UCC_TASK_THREAD_MODE(task) == UCC_THREAD_MULTIPLE) {
         ucc_recursive_spinlock_destroy(&schedule_p->lock);
     }
@@ -159,9 +164,8 @@ ucc_status_t ucc_schedule_pipelined_init(ucc_base_coll_args_t *coll_args,
     ucc_status_t     status;
     ucc_schedule_t **frags;
 
-    if (ucc_unlikely(n_frags > UCC_SCHEDULE_PIPELINED_MAX_FRAGS)) {
-        ucc_error("n_frags %d exceeds max limit of %d",
-                  n_frags, UCC_SCHEDULE_PIPELINED_MAX_FRAGS);
+    if (ucc_unlikely(n_frags < 1)) {
+        ucc_error("invalid pipeline depth %d", n_frags);
         return UCC_ERR_INVALID_PARAM;
     }
 
@@ -191,6 +195,16 @@ ucc_status_t ucc_schedule_pipelined_init(ucc_base_coll_args_t *coll_args,
         return status;
     }
 
+    schedule->frags = schedule->frags_inline;
+    if (n_frags > UCC_SCHEDULE_PIPELINED_MAX_FRAGS) {
+        schedule->frags = (ucc_schedule_t **)ucc_schedule_list_get(
+            schedule->super.ctx, n_frags);
+        if (ucc_unlikely(!schedule->frags)) {
+            schedule->frags = schedule->frags_inline;
+            return UCC_ERR_NO_MEMORY;
+        }
+    }
+
     if (UCC_TASK_THREAD_MODE(&schedule->super.super) == UCC_THREAD_MULTIPLE) {
         ucc_recursive_spinlock_init(&schedule->lock, 0);
     }
@@ -247,6 +261,10 @@ err:
     for (i = i - 1; i >= 0; i--) {
         frags[i]->super.finalize(&frags[i]->super);
     }
+    if (frags != schedule->frags_inline) {
+        ucc_schedule_list_put((void **)frags, n_frags);
+        schedule->frags = schedule->frags_inline;
+    }
     return status;
 }
 
@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  *
  * See file LICENSE for terms.
  */
@@ -9,7 +9,8 @@
 
 #include "components/base/ucc_base_iface.h"
 
-#define UCC_SCHEDULE_FRAG_MAX_TASKS 8
+/* number of frag schedules stored inline in the pipelined schedule, deeper
+   pipelines take the frags array from ucc_schedule_list_get */
 #define UCC_SCHEDULE_PIPELINED_MAX_FRAGS 4
 
 typedef struct ucc_schedule_pipelined ucc_schedule_pipelined_t;
@@ -51,27 +52,43 @@ typedef struct ucc_pipeline_params {
     unsigned             n_frags;
     unsigned             pdepth;
     ucc_pipeline_order_t order;
+    /* bandwidth-delay product of the link in bytes. If non-zero the pipeline
+       depth is the number of fragments needed to cover it, pdepth is
+       ignored */
+    size_t               bdp;
 } ucc_pipeline_params_t;
 
 static inline void ucc_pipeline_nfrags_pdepth(ucc_pipeline_params_t *p,
                                               size_t msgsize, int *n_frags,
                                               int *pipeline_depth)
 {
-    int min_num_frags;
+    int    min_num_frags;
+    size_t frag_len;
 
     *n_frags = 1;
     if (msgsize > p->threshold) {
         min_num_frags = ucc_div_round_up(msgsize, p->frag_size);
         *n_frags      = ucc_max(min_num_frags, p->n_frags);
     }
+    if (p->bdp) {
+        /* keep enough fragments in flight to fill the link plus the one
+           being processed locally */
+        frag_len        = ucc_max(ucc_div_round_up(msgsize, *n_frags), 1);
+        *pipeline_depth = ucc_min(*n_frags,
+                                  ucc_div_round_up(p->bdp, frag_len) + 1);
+        return;
+    }
     *pipeline_depth = ucc_min(*n_frags, p->pdepth);
 }
 
 extern const char* ucc_pipeline_order_names[];
 typedef struct ucc_schedule_pipelined {
     ucc_schedule_t               super;
-    /* Array of the frag schedules - 1 schedule per pipeline entry */
-    ucc_schedule_t *             frags[UCC_SCHEDULE_PIPELINED_MAX_FRAGS];
+    /* Array of the frag schedules - 1 schedule per pipeline entry. Points
+       to frags_inline unless the pipeline is deeper than
+       UCC_SCHEDULE_PIPELINED_MAX_FRAGS */
+    ucc_schedule_t **            frags;
+    ucc_schedule_t *             frags_inline[UCC_SCHEDULE_PIPELINED_MAX_FRAGS];
     /* n_frags - is the depth of the pipeline, ie how many fragments can
        be outstanding at a time */
     int                          n_frags;
@@ -1131,6 +1131,39 @@ ucc_status_t ucc_context_create(ucc_lib_h lib_handle,
 
 ucc_status_t ucc_context_progress(ucc_context_h context);
 
+/**
+ *  @ingroup UCC_CONTEXT
+ *
+ *  @brief The @ref ucc_context_wait routine blocks the calling thread until
+ *  there is communication activity on the context or the timeout expires.
+ *
+ *  @param [in]  context  Communication context handle to wait on
+ *  @param [in]  timeout  Timeout in milliseconds, -1 waits infinitely
+ *
+ *  @parblock
+ *
+ *  @b Description
+ *
+ *  The @ref ucc_context_wait routine lets a process that has nothing to do
+ *  but wait for its peers sleep instead of busy polling with
+ *  @ref ucc_context_progress. It should be called after
+ *  @ref ucc_context_progress stopped completing operations; it returns
+ *  immediately if events are already pending. The context has to be
+ *  progressed after the routine returns regardless of the reason.
+ *
+ *  Wakeup is driven by the event notification of the underlying transports
+ *  (e.g. UCC_TL_UCP_WAKEUP=y), components without event support are not
+ *  waited on. Remote writes to local memory, which one-sided algorithms
+ *  rely on, do not generate events, a finite timeout should be used when
+ *  such algorithms may be in progress.
+ *
+ *  @endparblock
+ *
+ *  @return Error code as defined by @ref ucc_status_t, UCC_ERR_NOT_SUPPORTED
+ *  if none of the components of the context supports waiting
+ */
+ucc_status_t ucc_context_wait(ucc_context_h context, int timeout);
+
 /**
  *  @ingroup UCC_CONTEXT
  *
@@ -1650,6 +1683,63 @@ ucc_status_t ucc_team_create_from_parent(uint64_t my_ep, uint32_t included,
                                          ucc_team_h parent_team,
                                          ucc_team_h *new_team);
 
+/**
+ *  @ingroup UCC_TEAM
+ *
+ *  @brief The routine allocates memory from the team symmetric heap.
+ *
+ *  @param [in]    team      Team handle
+ *  @param [in]    size      Size of the allocation in bytes
+ *  @param [out]   buffer    Pointer to the allocated buffer
+ *
+ *  @parblock
+ *
+ *  @b Description
+ *
+ *  @ref ucc_team_mem_alloc returns a buffer from a memory region that is
+ *  registered and exchanged among the team participants during the team
+ *  creation. The buffer can be used as a source, destination or work buffer
+ *  of the collectives on this team without any further memory registration
+ *  or @ref ucc_coll_args_t.global_work_buffer, including the one-sided
+ *  algorithms.
+ *
+ *  The routine is local, however the heap is symmetric only as long as all
+ *  the participants call @ref ucc_team_mem_alloc and @ref ucc_team_mem_free
+ *  with the same sizes in the same order. In this case the buffer is located
+ *  at the same offset of the region on every participant. If no component
+ *  of the team provides a symmetric heap, UCC_ERR_NOT_SUPPORTED is returned.
+ *  With UCC_THREAD_MULTIPLE the routine may be called concurrently from
+ *  several threads, however the allocation order, and therefore the
+ *  symmetry of the heap, is then up to the user.
+ *
+ *  @endparblock
+ *
+ *  @return Error code as defined by @ref ucc_status_t
+ */
+ucc_status_t ucc_team_mem_alloc(ucc_team_h team, size_t size, void **buffer);
+
+/**
+ *  @ingroup UCC_TEAM
+ *
+ *  @brief The routine releases memory allocated from the team symmetric heap.
+ *
+ *  @param [in]    team      Team handle
+ *  @param [in]    buffer    Buffer returned by @ref ucc_team_mem_alloc
+ *
+ *  @parblock
+ *
+ *  @b Description
+ *
+ *  @ref ucc_team_mem_free returns the buffer to the team symmetric heap. The
+ *  buffer must not be used by any outstanding collective. All the buffers
+ *  have to be released before the team is destroyed.
+ *
+ *  @endparblock
+ *
+ *  @return Error code as defined by @ref ucc_status_t
+ */
+ucc_status_t ucc_team_mem_free(ucc_team_h team, void *buffer);
+
 /*
  * *************************************************************
  *                   Collectives Section
@@ -1845,9 +1935,6 @@ typedef struct ucc_coll_args {
         ucc_coll_buffer_info_t      info;   /*!< Buffer info for the collective */
         ucc_coll_buffer_info_v_t    info_v; /*!< Buffer info for the collective */
     } dst;
-    union {
-        ucc_coll_buffer_info_t      info;   /*!< Buffer info for the collective */
-    } cyx_scratch; // cyx add for allreduce_cyx
     ucc_reduction_op_t              op; /*!< Predefined reduction operation, if
                                              reduce, allreduce, reduce_scatter
                                              operation is selected.
@@ -1868,7 +1955,12 @@ typedef struct ucc_coll_args {
                                                              the field mask -
                                                              UCC_CONTEXT_ATTR_FIELD_WORK_BUFFER_SIZE
                                                              set to 1. The buffer must be initialized
-                                                             to 0. */
+                                                             to 0 before its first use and must not
+                                                             be modified by the user afterwards, it
+                                                             is not reset between collectives.
+                                                             It is not needed on teams providing a
+                                                             symmetric heap, see @ref
+                                                             ucc_team_mem_alloc. */
     ucc_coll_callback_t             cb;
     double                          timeout; /*!< Timeout in seconds */
     struct {
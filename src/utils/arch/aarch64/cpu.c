@@ -13,6 +13,16 @@
 
 #include "utils/arch/cpu.h"
 #include <stdio.h>
+#include <sys/auxv.h>
+#include <string.h>
+#include <arm_neon.h>
+
+#ifndef HWCAP_ASIMD
+#define HWCAP_ASIMD (1 << 1)
+#endif
+#ifndef HWCAP_SVE
+#define HWCAP_SVE   (1 << 22)
+#endif
 
 static void ucc_aarch64_cpuid_from_proc(ucc_aarch64_cpuid_t *cpuid)
 {
@@ -68,4 +78,38 @@ void ucc_aarch64_cpuid(ucc_aarch64_cpuid_t *cpuid)
     *cpuid = cached_cpuid;
 }
 
+int ucc_arch_get_cpu_flag()
+{
+    unsigned long hwcap = getauxval(AT_HWCAP);
+    int           flags = 0;
+
+    if (hwcap & HWCAP_ASIMD) {
+        flags |= UCC_CPU_FLAG_NEON;
+    }
+    if (hwcap & HWCAP_SVE) {
+        flags |= UCC_CPU_FLAG_SVE;
+    }
+    return flags;
+}
+
+void ucc_arch_memcpy_nt(void *dst, const void *src, size_t len)
+{
+    char       *d = dst;
+    const char *s = src;
+    uint8x16_t  v0, v1, v2, v3;
+
+    for (; len >= 64; len -= 64, d += 64, s += 64) {
+        v0 = vld1q_u8((const uint8_t *)s);
+        v1 = vld1q_u8((const uint8_t *)(s + 16));
+        v2 = vld1q_u8((const uint8_t *)(s + 32));
+        v3 = vld1q_u8((const uint8_t *)(s + 48));
+        asm volatile ("stnp %q1, %q2, [%0]\n"
+                      "stnp %q3, %q4, [%0, #32]"
+                      :: "r"(d), "w"(v0), "w"(v1), "w"(v2), "w"(v3)
+                      : "memory");
+    }
+    ucc_memory_cpu_store_fence();
+    memcpy(d, s, len);
+}
+
 #endif
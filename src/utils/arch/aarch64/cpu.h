@@ -76,5 +76,15 @@ static inline ucc_cpu_model_t ucc_arch_get_cpu_model()
     return UCC_CPU_MODEL_ARM_AARCH64;
 }
 
+/**
+ * Get mask of ucc_cpu_flag_t reported by the kernel (AT_HWCAP)
+ */
+int ucc_arch_get_cpu_flag();
+
+/**
+ * memcpy with non-temporal stores (stnp) for dst
+ */
+void ucc_arch_memcpy_nt(void *dst, const void *src, size_t len);
+
 
 #endif
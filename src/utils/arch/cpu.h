@@ -53,6 +53,15 @@ typedef enum ucc_cpu_vendor {
     UCC_CPU_VENDOR_LAST
 } ucc_cpu_vendor_t;
 
+/* CPU features used for runtime dispatch of vectorized code */
+typedef enum ucc_cpu_flag {
+    UCC_CPU_FLAG_AVX2    = (1 << 0),
+    UCC_CPU_FLAG_AVX512F = (1 << 1),
+    UCC_CPU_FLAG_NEON    = (1 << 2),
+    UCC_CPU_FLAG_SVE     = (1 << 3),
+    UCC_CPU_FLAG_F16C    = (1 << 4)
+} ucc_cpu_flag_t;
+
 static inline ucc_cpu_vendor_t ucc_get_vendor_from_str(const char *v_name)
 {
     if (strcasecmp(v_name, "intel") == 0)
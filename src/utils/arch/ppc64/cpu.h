@@ -9,6 +9,8 @@
 #ifndef UCC_PPC64_CPU_H_
 #define UCC_PPC64_CPU_H_
 
+#include <string.h>
+
 #define UCC_ARCH_CACHE_LINE_SIZE 128
 
 /* Assume the worst - weak memory ordering */
@@ -33,4 +35,14 @@ static inline ucc_cpu_vendor_t ucc_arch_get_cpu_vendor()
     return UCC_CPU_VENDOR_GENERIC_PPC;
 }
 
+static inline int ucc_arch_get_cpu_flag()
+{
+    return 0;
+}
+
+static inline void ucc_arch_memcpy_nt(void *dst, const void *src, size_t len)
+{
+    memcpy(dst, src, len);
+}
+
 #endif
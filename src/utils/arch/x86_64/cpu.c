@@ -13,6 +13,8 @@
 #endif
 
 #include "utils/arch/cpu.h"
+#include <emmintrin.h>
+#include <string.h>
 
 #define X86_CPUID_GENUINEINTEL    "GenuntelineI" /* GenuineIntel in magic notation */
 #define X86_CPUID_AUTHENTICAMD    "AuthcAMDenti" /* AuthenticAMD in magic notation */
@@ -25,6 +27,13 @@
 #define X86_CPUID_INVARIANT_TSC   0x80000007u
 #define X86_CPUID_GET_CACHE_INFO  0x00000002u
 #define X86_CPUID_GET_LEAF4_INFO  0x00000004u
+#define X86_CPUID_ECX_OSXSAVE     (1u << 27)
+#define X86_CPUID_ECX_AVX         (1u << 28)
+#define X86_CPUID_ECX_F16C        (1u << 29)
+#define X86_CPUID_EBX_AVX2        (1u << 5)
+#define X86_CPUID_EBX_AVX512F     (1u << 16)
+#define X86_XCR0_AVX_STATE        0x06u /* XMM and YMM */
+#define X86_XCR0_AVX512_STATE     0xe0u /* opmask, ZMM_Hi256, Hi16_ZMM */
 
 typedef union ucc_x86_cpu_registers {
     struct {
@@ -70,6 +79,76 @@ static UCC_F_NOOPTIMIZE inline void ucc_x86_cpuid(uint32_t level,
                   : "0"(level));
 }
 
+static UCC_F_NOOPTIMIZE inline void ucc_x86_cpuid_subleaf(uint32_t level,
+                                                          uint32_t subleaf,
+                                                          uint32_t *a,
+                                                          uint32_t *b,
+                                                          uint32_t *c,
+                                                          uint32_t *d)
+{
+    asm volatile ("cpuid\n\t"
+                  : "=a"(*a), "=b"(*b), "=c"(*c), "=d"(*d)
+                  : "0"(level), "2"(subleaf));
+}
+
+static inline uint64_t ucc_x86_xgetbv(uint32_t index)
+{
+    uint32_t eax, edx;
+
+    asm volatile ("xgetbv\n\t" : "=a"(eax), "=d"(edx) : "c"(index));
+    return ((uint64_t)edx << 32) | eax;
+}
+
+static int ucc_x86_get_cpu_flag()
+{
+    uint32_t max_level, _eax, _ebx, _ecx, _edx;
+    uint64_t xcr0;
+    int      flags = 0;
+
+    ucc_x86_cpuid(X86_CPUID_GET_BASE_VALUE, &max_level, &_ebx, &_ecx, &_edx);
+    if (max_level < X86_CPUID_GET_EXTD_VALUE) {
+        return 0;
+    }
+
+    /* vector registers state has to be saved by the OS, otherwise the
+       instructions fault even if the cpu implements them */
+    ucc_x86_cpuid(X86_CPUID_GET_MODEL, &_eax, &_ebx, &_ecx, &_edx);
+    if (!(_ecx & X86_CPUID_ECX_OSXSAVE) || !(_ecx & X86_CPUID_ECX_AVX)) {
+        return 0;
+    }
+    xcr0 = ucc_x86_xgetbv(0);
+    if ((xcr0 & X86_XCR0_AVX_STATE) != X86_XCR0_AVX_STATE) {
+        return 0;
+    }
+    if (_ecx & X86_CPUID_ECX_F16C) {
+        flags |= UCC_CPU_FLAG_F16C;
+    }
+
+    ucc_x86_cpuid_subleaf(X86_CPUID_GET_EXTD_VALUE, 0, &_eax, &_ebx, &_ecx,
+                          &_edx);
+    if (_ebx & X86_CPUID_EBX_AVX2) {
+        flags |= UCC_CPU_FLAG_AVX2;
+    }
+    if ((_ebx & X86_CPUID_EBX_AVX512F) &&
+        ((xcr0 & X86_XCR0_AVX512_STATE) == X86_XCR0_AVX512_STATE)) {
+        flags |= UCC_CPU_FLAG_AVX512F;
+    }
+    return flags;
+}
+
+int ucc_arch_get_cpu_flag()
+{
+    static int cached_flags = -1;
+    int        flags;
+
+    if (cached_flags < 0) {
+        flags = ucc_x86_get_cpu_flag();
+        ucc_memory_cpu_store_fence();
+        cached_flags = flags;
+    }
+    return cached_flags;
+}
+
 ucc_cpu_vendor_t ucc_arch_get_cpu_vendor()
 {
     ucc_x86_cpu_registers reg = {}; /* Silence static checker */
@@ -186,4 +265,35 @@ ucc_cpu_model_t ucc_arch_get_cpu_model()
     return UCC_CPU_MODEL_UNKNOWN;
 }
 
+void ucc_arch_memcpy_nt(void *dst, const void *src, size_t len)
+{
+    char       *d = dst;
+    const char *s = src;
+    size_t      head;
+    __m128i     v0, v1, v2, v3;
+
+    /* streaming stores need aligned dst */
+    head = (16 - ((uintptr_t)d & 15)) & 15;
+    if (head > len) {
+        head = len;
+    }
+    memcpy(d, s, head);
+    d   += head;
+    s   += head;
+    len -= head;
+    for (; len >= 64; len -= 64, d += 64, s += 64) {
+        v0 = _mm_loadu_si128((const __m128i *)s);
+        v1 = _mm_loadu_si128((const __m128i *)(s + 16));
+        v2 = _mm_loadu_si128((const __m128i *)(s + 32));
+        v3 = _mm_loadu_si128((const __m128i *)(s + 48));
+        _mm_stream_si128((__m128i *)d, v0);
+        _mm_stream_si128((__m128i *)(d + 16), v1);
+        _mm_stream_si128((__m128i *)(d + 32), v2);
+        _mm_stream_si128((__m128i *)(d + 48), v3);
+    }
+    /* streaming stores are weakly ordered */
+    _mm_sfence();
+    memcpy(d, s, len);
+}
+
 #endif
@@ -26,4 +26,10 @@
 ucc_cpu_model_t  ucc_arch_get_cpu_model() UCC_F_NOOPTIMIZE;
 ucc_cpu_vendor_t ucc_arch_get_cpu_vendor();
 
+/* returns mask of ucc_cpu_flag_t supported by the cpu and enabled by the OS */
+int              ucc_arch_get_cpu_flag();
+
+/* memcpy with streaming stores bypassing the cache for dst */
+void             ucc_arch_memcpy_nt(void *dst, const void *src, size_t len);
+
 #endif
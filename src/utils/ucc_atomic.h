@@ -18,5 +18,6 @@
 #define ucc_atomic_cswap8         ucs_atomic_cswap8
 #define ucc_atomic_cswap64        ucs_atomic_cswap64
 #define ucc_atomic_bool_cswap8    ucs_atomic_bool_cswap8
+#define ucc_atomic_bool_cswap32   ucs_atomic_bool_cswap32
 #define ucc_atomic_bool_cswap64   ucs_atomic_bool_cswap64
 #endif
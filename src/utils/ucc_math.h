@@ -102,6 +102,76 @@ static inline void float32tobfloat16(float float_val, void *bfloat16_ptr)
 #endif
 }
 
+/* IEEE 754 binary16 conversions, same results as F16C/NEON instructions
+   with round to nearest even */
+static inline float float16tofloat32(const void *float16_ptr)
+{
+    uint16_t h    = *((const uint16_t *)float16_ptr);
+    uint32_t exp  = (h >> 10) & 0x1f;
+    uint32_t mant = h & 0x3ff;
+    union {
+        uint32_t u;
+        float    f;
+    } res;
+
+    res.u = ((uint32_t)h & 0x8000) << 16;
+    if (exp == 0x1f) {
+        res.u |= 0x7f800000 | (mant << 13);
+    } else if (exp != 0) {
+        res.u |= ((exp + 112) << 23) | (mant << 13);
+    } else if (mant != 0) {
+        /* subnormal, normalize the mantissa */
+        exp = 113;
+        while (!(mant & 0x400)) {
+            mant <<= 1;
+            exp--;
+        }
+        res.u |= (exp << 23) | ((mant & 0x3ff) << 13);
+    }
+    return res.f;
+}
+
+static inline void float32tofloat16(float float_val, void *float16_ptr)
+{
+    union {
+        uint32_t u;
+        float    f;
+    } val;
+    uint32_t mant, rem, half, shift;
+    int32_t  exp;
+    uint16_t h;
+
+    val.f = float_val;
+    h     = (val.u >> 16) & 0x8000;
+    exp   = (int32_t)((val.u >> 23) & 0xff) - 127 + 15;
+    mant  = val.u & 0x7fffff;
+
+    if (((val.u >> 23) & 0xff) == 0xff) {
+        /* inf or quiet nan */
+        h |= 0x7c00 | (mant ? 0x200 | (mant >> 13) : 0);
+    } else if (exp >= 0x1f) {
+        h |= 0x7c00;
+    } else if (exp > 0) {
+        h  |= (exp << 10) | (mant >> 13);
+        rem = mant & 0x1fff;
+        /* carry to exponent rounds up to the next binade or inf */
+        if (rem > 0x1000 || (rem == 0x1000 && (h & 1))) {
+            h++;
+        }
+    } else if (exp >= -10) {
+        /* subnormal */
+        mant |= 0x800000;
+        shift = 14 - exp;
+        half  = 1u << (shift - 1);
+        rem   = mant & ((1u << shift) - 1);
+        h    |= mant >> shift;
+        if (rem > half || (rem == half && (h & 1))) {
+            h++;
+        }
+    }
+    *((uint16_t *)float16_ptr) = h;
+}
+
 #define ucc_padding(_n, _alignment)                                            \
     ( ((_alignment) - (_n) % (_alignment)) % (_alignment) )
 
@@ -1,6 +1,12 @@
 #include "ucc_mpool.h"
 #include "ucc_malloc.h"
 #include "ucc_log.h"
+#include "ucc_atomic.h"
+
+/* pthread keys are a limited resource shared with the rest of the process */
+#define UCC_MPOOL_MAG_MAX_KEYS 128
+
+static uint32_t ucc_mpool_mag_n_keys = 0;
 
 static ucc_mpool_ops_t ucc_default_mpool_ops = {
     .chunk_alloc   = ucc_mpool_hugetlb_malloc,
@@ -37,6 +43,101 @@ static void ucc_mpool_obj_cleanup_wrapper(ucs_mpool_t *mp, void *obj)
     mpool->ucc_ops->obj_cleanup(mpool, obj);
 }
 
+/* returns n objects of the magazine to the shared pool, the caller
+   serializes access to the pool */
+static void ucc_mpool_mag_flush(ucc_mpool_mag_t *mag, unsigned n)
+{
+    while (n-- > 0) {
+        ucs_mpool_put(mag->objs[--mag->count]);
+    }
+}
+
+/* thread exit */
+static void ucc_mpool_mag_release(void *arg)
+{
+    ucc_mpool_mag_t *mag = arg;
+    ucc_mpool_t     *mp  = mag->mp;
+
+    ucc_spin_lock(&mp->lock);
+    ucc_mpool_mag_flush(mag, mag->count);
+    ucc_list_del(&mag->list_elem);
+    ucc_spin_unlock(&mp->lock);
+    ucc_free(mag);
+}
+
+static ucc_mpool_mag_t *ucc_mpool_mag_create(ucc_mpool_t *mp)
+{
+    ucc_mpool_mag_t *mag;
+
+    mag = ucc_malloc(sizeof(*mag), "mpool_mag");
+    if (!mag) {
+        return NULL;
+    }
+    mag->mp    = mp;
+    mag->count = 0;
+    if (pthread_setspecific(mp->mag_key, mag)) {
+        ucc_free(mag);
+        return NULL;
+    }
+    ucc_spin_lock(&mp->lock);
+    ucc_list_add_tail(&mp->mags, &mag->list_elem);
+    ucc_spin_unlock(&mp->lock);
+    return mag;
+}
+
+void *ucc_mpool_mag_get(ucc_mpool_t *mp, ucc_mpool_mag_t *mag)
+{
+    void *obj;
+
+    if (!mag) {
+        mag = ucc_mpool_mag_create(mp);
+    }
+    ucc_spin_lock(&mp->lock);
+    obj = ucs_mpool_get(&mp->super);
+    if (mag) {
+        while (obj && mag->count < UCC_MPOOL_MAG_SIZE / 2) {
+            mag->objs[mag->count++] = obj;
+            obj = ucs_mpool_get(&mp->super);
+        }
+        if (!obj && mag->count > 0) {
+            /* pool is exhausted, take what we have */
+            obj = mag->objs[--mag->count];
+        }
+    }
+    ucc_spin_unlock(&mp->lock);
+    return obj;
+}
+
+void ucc_mpool_mag_put(ucc_mpool_t *mp, ucc_mpool_mag_t *mag, void *obj)
+{
+    if (!mag) {
+        mag = ucc_mpool_mag_create(mp);
+        if (!mag) {
+            ucc_spin_lock(&mp->lock);
+            ucs_mpool_put(obj);
+            ucc_spin_unlock(&mp->lock);
+            return;
+        }
+    } else {
+        /* full */
+        ucc_spin_lock(&mp->lock);
+        ucc_mpool_mag_flush(mag, UCC_MPOOL_MAG_SIZE / 2);
+        ucc_spin_unlock(&mp->lock);
+    }
+    mag->objs[mag->count++] = obj;
+}
+
+static void ucc_mpool_mag_init(ucc_mpool_t *mp)
+{
+    /* running out of keys only disables the magazines */
+    if (ucc_atomic_fadd32(&ucc_mpool_mag_n_keys, 1) < UCC_MPOOL_MAG_MAX_KEYS &&
+        !pthread_key_create(&mp->mag_key, ucc_mpool_mag_release)) {
+        mp->mag_enabled = 1;
+        return;
+    }
+    ucc_atomic_sub32(&ucc_mpool_mag_n_keys, 1);
+}
+
 ucc_status_t ucc_mpool_init(ucc_mpool_t *mp, size_t priv_size, size_t elem_size,
                             size_t align_offset, size_t alignment,
                             unsigned elems_per_chunk, unsigned max_elems,
@@ -44,6 +145,7 @@ ucc_status_t ucc_mpool_init(ucc_mpool_t *mp, size_t priv_size, size_t elem_size,
                             const char *name)
 {
     ucs_mpool_ops_t *ucs_ops = ucc_calloc(1, sizeof(*ucs_ops), "mpool_ops");
+    ucs_status_t     status;
 #if UCS_HAVE_MPOOL_PARAMS
     ucs_mpool_params_t params;
 #endif
@@ -56,6 +158,8 @@ ucc_status_t ucc_mpool_init(ucc_mpool_t *mp, size_t priv_size, size_t elem_size,
 
     ucc_spinlock_init(&mp->lock, 0);
     mp->tm                 = tm;
+    mp->mag_enabled        = 0;
+    ucc_list_head_init(&mp->mags);
     mp->ucc_ops            = ops ? ops : &ucc_default_mpool_ops;
     ucs_ops->chunk_alloc   = ucc_mpool_chunk_alloc_wrapper;
     ucs_ops->chunk_release = ucc_mpool_chunk_release_wrapper;
@@ -79,18 +183,36 @@ ucc_status_t ucc_mpool_init(ucc_mpool_t *mp, size_t priv_size, size_t elem_size,
     params.ops             = ucs_ops;
     params.name            = name;
 
-    return ucs_status_to_ucc_status(ucs_mpool_init(&params, &mp->super));
+    status = ucs_mpool_init(&params, &mp->super);
 #else
-    return ucs_status_to_ucc_status(
-        ucs_mpool_init(&mp->super, priv_size, elem_size, align_offset,
-                       alignment, elems_per_chunk, max_elems, ucs_ops, name));
+    status = ucs_mpool_init(&mp->super, priv_size, elem_size, align_offset,
+                            alignment, elems_per_chunk, max_elems, ucs_ops,
+                            name);
 #endif
+    if (status != UCS_OK) {
+        return ucs_status_to_ucc_status(status);
+    }
+    if (tm != UCC_THREAD_SINGLE && max_elems >= UCC_MPOOL_MAG_MIN_ELEMS) {
+        ucc_mpool_mag_init(mp);
+    }
+    return UCC_OK;
 }
 
 void ucc_mpool_cleanup(ucc_mpool_t *mp, int leak_check)
 {
-    void *ops = (void*)mp->super.data->ops;
+    void            *ops = (void*)mp->super.data->ops;
+    ucc_mpool_mag_t *mag, *tmp;
 
+    if (mp->mag_enabled) {
+        /* objects cached by all the threads go back before leak check */
+        pthread_key_delete(mp->mag_key);
+        ucc_list_for_each_safe(mag, tmp, &mp->mags, list_elem) {
+            ucc_mpool_mag_flush(mag, mag->count);
+            ucc_free(mag);
+        }
+        mp->mag_enabled = 0;
+        ucc_atomic_sub32(&ucc_mpool_mag_n_keys, 1);
+    }
     ucs_mpool_cleanup(&mp->super, leak_check);
     ucc_free(ops);
     ucc_spinlock_destroy(&mp->lock);
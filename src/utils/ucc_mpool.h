@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * See file LICENSE for terms.
  */
 
@@ -11,6 +11,14 @@
 #include <ucs/datastruct/mpool.h>
 #include "ucc_compiler_def.h"
 #include "ucc_spinlock.h"
+#include "ucc_list.h"
+#include <pthread.h>
+
+/* objects cached by every thread in multithreaded mode */
+#define UCC_MPOOL_MAG_SIZE      32
+/* bounded pools smaller than that are not cached so that threads do not
+   starve each other */
+#define UCC_MPOOL_MAG_MIN_ELEMS (16 * UCC_MPOOL_MAG_SIZE)
 
 typedef struct ucc_mpool ucc_mpool_t;
 
@@ -22,11 +30,23 @@ typedef struct ucc_mpool_ops {
     void (*obj_cleanup)(ucc_mpool_t *mp, void *obj);
 } ucc_mpool_ops_t;
 
+/* per thread free list (magazine) of a multithreaded mpool, refilled from
+   and flushed to the shared pool in batches of half the magazine */
+typedef struct ucc_mpool_mag {
+    ucc_list_link_t list_elem;
+    ucc_mpool_t    *mp;
+    unsigned        count;
+    void           *objs[UCC_MPOOL_MAG_SIZE];
+} ucc_mpool_mag_t;
+
 struct ucc_mpool {
     ucs_mpool_t       super;
     ucc_mpool_ops_t * ucc_ops;
     ucc_thread_mode_t tm;
     ucc_spinlock_t    lock;
+    int               mag_enabled;
+    pthread_key_t     mag_key;
+    ucc_list_link_t   mags; /* magazines of all threads, protected by lock */
 };
 
 ucc_status_t ucc_mpool_init(ucc_mpool_t *mp, size_t priv_size, size_t elem_size,
@@ -42,13 +62,26 @@ ucc_status_t ucc_mpool_hugetlb_malloc(ucc_mpool_t *mp, size_t *size_p,
 
 void ucc_mpool_hugetlb_free(ucc_mpool_t *mp, void *chunk);
 
+/* slow paths of get/put with an empty/full or missing magazine */
+void *ucc_mpool_mag_get(ucc_mpool_t *mp, ucc_mpool_mag_t *mag);
+
+void ucc_mpool_mag_put(ucc_mpool_t *mp, ucc_mpool_mag_t *mag, void *obj);
+
 static inline void *ucc_mpool_get(ucc_mpool_t *mp)
 {
-    void *ret;
+    ucc_mpool_mag_t *mag;
+    void            *ret;
 
     if (UCC_THREAD_SINGLE == mp->tm) {
         return ucs_mpool_get(&mp->super);
     }
+    if (mp->mag_enabled) {
+        mag = (ucc_mpool_mag_t *)pthread_getspecific(mp->mag_key);
+        if (ucc_likely(mag && mag->count > 0)) {
+            return mag->objs[--mag->count];
+        }
+        return ucc_mpool_mag_get(mp, mag);
+    }
     ucc_spin_lock(&mp->lock);
     ret = ucs_mpool_get(&mp->super);
     ucc_spin_unlock(&mp->lock);
@@ -59,11 +92,21 @@ static inline void ucc_mpool_put(void *obj)
 {
     ucs_mpool_elem_t *elem = (ucs_mpool_elem_t *)obj - 1;
     ucc_mpool_t *     mp   = ucc_derived_of(elem->mpool, ucc_mpool_t);
+    ucc_mpool_mag_t * mag;
 
     if (UCC_THREAD_SINGLE == mp->tm) {
         ucs_mpool_put(obj);
         return;
     }
+    if (mp->mag_enabled) {
+        mag = (ucc_mpool_mag_t *)pthread_getspecific(mp->mag_key);
+        if (ucc_likely(mag && mag->count < UCC_MPOOL_MAG_SIZE)) {
+            mag->objs[mag->count++] = obj;
+            return;
+        }
+        ucc_mpool_mag_put(mp, mag, obj);
+        return;
+    }
     ucc_spin_lock(&mp->lock);
     ucs_mpool_put(obj);
     ucc_spin_unlock(&mp->lock);
@@ -702,7 +702,8 @@ int ucc_pipeline_params_is_auto(const ucc_pipeline_params_t *p)
         (p->n_frags == ucc_pipeline_params_auto.n_frags) &&
         (p->frag_size == ucc_pipeline_params_auto.frag_size) &&
         (p->pdepth == ucc_pipeline_params_auto.pdepth) &&
-        (p->order == ucc_pipeline_params_auto.order)) {
+        (p->order == ucc_pipeline_params_auto.order) &&
+        (p->bdp == ucc_pipeline_params_auto.bdp)) {
         return 1;
     }
 
@@ -774,6 +775,11 @@ int ucc_config_sscanf_pipeline_params(const char *buf, void *dest,
                 goto out;
             }
             p->pdepth = atoi(t2[1]);
+        } else if (0 == strcmp(t2[0], "bdp")) {
+            status = ucc_str_to_memunits(t2[1], &p->bdp);
+            if (UCC_OK != status) {
+                goto out;
+            }
         }
         ucc_str_split_free(t2);
     }
@@ -791,7 +797,7 @@ int ucc_config_sprintf_pipeline_params(char *buf, size_t max, const void *src,
                                        const void *arg) //NOLINT
 {
     const ucc_pipeline_params_t *p = src;
-    char                         thresh[32], frag_size[32];
+    char                         thresh[32], frag_size[32], bdp[32];
 
     if (ucc_pipeline_params_is_auto(p)) {
         return snprintf(buf, max, "auto");
@@ -799,6 +805,15 @@ int ucc_config_sprintf_pipeline_params(char *buf, size_t max, const void *src,
     if (!memcmp(p, &ucc_pipeline_params_no, sizeof(*p))) {
         return snprintf(buf, max, "n");
     }
+    if (p->bdp) {
+        return snprintf(
+            buf, max, "thresh=%s:nfrags=%d:fragsize=%s:bdp=%s:order=%s",
+            ucs_memunits_to_str(p->threshold, thresh, sizeof(thresh)),
+            p->n_frags,
+            ucs_memunits_to_str(p->frag_size, frag_size, sizeof(frag_size)),
+            ucs_memunits_to_str(p->bdp, bdp, sizeof(bdp)),
+            ucc_pipeline_order_names[p->order]);
+    }
     return snprintf(
         buf, max, "thresh=%s:nfrags=%d:fragsize=%s:pdepth=%d:order=%s",
         ucs_memunits_to_str(p->threshold, thresh, sizeof(thresh)), p->n_frags,
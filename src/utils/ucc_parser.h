@@ -287,7 +287,8 @@ void ucc_config_release_uint_ranged(void *ptr, const void *arg);
             ucc_config_release_pipeline_params, ucs_config_help_generic,       \
             ucs_config_doc_nop,                                                \
             "thresh=<memunit>:fragsize=<memunit>:nfrags="                      \
-            "<uint>:pdepth=<uint>:<ordered/parallel/sequential>"               \
+            "<uint>:pdepth=<uint>:bdp=<memunit>:"                              \
+            "<ordered/parallel/sequential>"                                    \
     }
 #else
 #define UCC_CONFIG_TYPE_UINT_RANGED                                            \
@@ -305,7 +306,8 @@ void ucc_config_release_uint_ranged(void *ptr, const void *arg);
             ucc_config_clone_pipeline_params,                                  \
             ucc_config_release_pipeline_params, ucs_config_help_generic,       \
             "thresh=<memunit>:fragsize=<memunit>:nfrags="                      \
-            "<uint>:pdepth=<uint>:<ordered/parallel/sequential>"               \
+            "<uint>:pdepth=<uint>:bdp=<memunit>:"                              \
+            "<ordered/parallel/sequential>"                                    \
     }
 #endif
 
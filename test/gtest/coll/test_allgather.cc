@@ -254,6 +254,99 @@ INSTANTIATE_TEST_CASE_P(
         ::testing::Values(1,3,8192), // count
         ::testing::Values(TEST_INPLACE, TEST_NO_INPLACE)));
 
+#ifdef HAVE_UCX
+UCC_TEST_F(test_allgather, onesided)
+{
+    UccCollCtxVec ctxs;
+
+    SET_MEM_TYPE(UCC_MEMORY_TYPE_HOST);
+    onesided_for_each_team("allgather", [&](int n_procs, UccTeam_h team) {
+        for (auto count : {1, 8192}) {
+            for (auto inplace : {TEST_NO_INPLACE, TEST_INPLACE}) {
+                set_inplace(inplace);
+                data_init(n_procs, UCC_DT_INT32, count, ctxs, true);
+                /* blocks are put by the left neighbour straight into dst */
+                onesided_map_buffers(team, ctxs, true, 1);
+                onesided_repeat(*this, team, ctxs);
+                data_fini(ctxs);
+            }
+        }
+    });
+}
+
+UCC_TEST_F(test_allgather, onesided_staggered)
+{
+    ucc_job_env_t env     = onesided_env("allgather");
+    int           n_procs = 7;
+    int           late    = 3;
+    UccJob        job(n_procs, UccJob::UCC_JOB_CTX_GLOBAL_ONESIDED, env);
+    UccTeam_h     team = job.create_team(n_procs, true, false, true);
+    UccCollCtxVec ctxs;
+
+    set_inplace(TEST_NO_INPLACE);
+    SET_MEM_TYPE(UCC_MEMORY_TYPE_HOST);
+    data_init(n_procs, UCC_DT_INT32, 8192, ctxs, true);
+    onesided_map_buffers(team, ctxs, true, 1);
+    reset(ctxs);
+    UccReq req(team, ctxs);
+
+    for (auto i = 0; i < UCC_TEST_ONESIDED_REPEAT; i++) {
+        uint8_t *dst = (uint8_t *)ctxs[late]->args->dst.info.buffer;
+
+        /* the late rank still uses dst of the previous call while the other
+           ranks post the next one, nothing may be written into it */
+        clear_buffer(dst, ctxs[late]->rbuf_size, UCC_MEMORY_TYPE_HOST, 0xff);
+        for (auto r = 0; r < n_procs; r++) {
+            if (r != late) {
+                ASSERT_EQ(UCC_OK, ucc_collective_post(req.reqs[r]));
+            }
+        }
+        for (auto p = 0; p < 100; p++) {
+            team->progress();
+        }
+        for (size_t j = 0; j < ctxs[late]->rbuf_size; j++) {
+            ASSERT_EQ(0xff, dst[j]);
+        }
+        ASSERT_EQ(UCC_OK, ucc_collective_post(req.reqs[late]));
+        req.wait();
+        EXPECT_EQ(true, data_validate(ctxs));
+        reset(ctxs);
+    }
+    data_fini(ctxs);
+}
+
+UCC_TEST_F(test_allgather, onesided_concurrent)
+{
+    ucc_job_env_t env     = onesided_env("allgather");
+    int           n_procs = 7;
+    UccJob        job(n_procs, UccJob::UCC_JOB_CTX_GLOBAL_ONESIDED, env);
+    UccTeam_h     team = job.create_team(n_procs, true, false, true);
+    std::vector<UccReq>        reqs;
+    std::vector<UccCollCtxVec> ctxs;
+
+    set_inplace(TEST_NO_INPLACE);
+    SET_MEM_TYPE(UCC_MEMORY_TYPE_HOST);
+    /* the second collective is posted while the first one owns the team
+       symmetric region and has to wait for it */
+    for (auto i = 0; i < 2; i++) {
+        UccCollCtxVec ctx;
+
+        data_init(n_procs, UCC_DT_INT32, 8192, ctx, false);
+        onesided_map_buffers(team, ctx, true, 1 - i);
+        reset(ctx);
+        reqs.push_back(UccReq(team, ctx));
+        ctxs.push_back(ctx);
+    }
+    UccReq::startall(reqs);
+    UccReq::waitall(reqs);
+
+    for (auto ctx : ctxs) {
+        EXPECT_EQ(true, data_validate(ctx));
+        data_fini(ctx);
+    }
+}
+#endif
+
 class test_allgather_alg : public test_allgather,
         public ::testing::WithParamInterface<Param_2> {};
 
@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * See file LICENSE for terms.
  */
 
@@ -331,6 +331,66 @@ TYPED_TEST(test_allreduce_alg, sra_knomial_pipelined) {
     }
 }
 
+/* pipeline deeper than the inline frags array, either set explicitly or
+   derived from the bandwidth-delay product (256K msg, 16 frags, depth 5) */
+TYPED_TEST(test_allreduce_alg, sra_knomial_pipelined_deep) {
+    int           n_procs = 8;
+    int           repeat  = 3;
+    int           count   = 65536;
+
+    for (auto pipeline : {"thresh=1024:nfrags=11:pdepth=8:ordered",
+                          "thresh=1024:fragsize=16K:bdp=64K:sequential"}) {
+        ucc_job_env_t env = {{"UCC_CL_BASIC_TUNE", "inf"},
+                             {"UCC_TL_UCP_TUNE", "allreduce:@sra_knomial:inf"},
+                             {"UCC_TL_UCP_ALLREDUCE_SRA_KN_PIPELINE", pipeline}};
+        UccJob        job(n_procs, UccJob::UCC_JOB_CTX_GLOBAL, env);
+        UccTeam_h     team = job.create_team(n_procs);
+        UccCollCtxVec ctxs;
+
+        for (auto inplace : {TEST_NO_INPLACE, TEST_INPLACE}) {
+            SET_MEM_TYPE(UCC_MEMORY_TYPE_HOST);
+            this->set_inplace(inplace);
+            this->data_init(n_procs, TypeParam::dt, count, ctxs, true);
+            UccReq req(team, ctxs);
+
+            for (auto i = 0; i < repeat; i++) {
+                req.start();
+                req.wait();
+                EXPECT_EQ(true, this->data_validate(ctxs));
+                this->reset(ctxs);
+            }
+            this->data_fini(ctxs);
+        }
+    }
+}
+
+TYPED_TEST(test_allreduce_alg, adaptive_npolls) {
+    int           n_procs = 8;
+    int           n_colls = 4;
+    ucc_job_env_t env     = {{"UCC_CL_BASIC_TUNE", "inf"},
+                             {"UCC_TL_UCP_TUNE", "allreduce:@knomial:inf"},
+                             {"UCC_TL_UCP_NPOLLS_ADAPTIVE", "y"},
+                             {"UCC_TL_UCP_NPOLLS_MAX", "50"}};
+    UccJob        job(n_procs, UccJob::UCC_JOB_CTX_GLOBAL, env);
+    UccTeam_h     team = job.create_team(n_procs);
+    std::vector<UccCollCtxVec> ctxs(n_colls);
+    std::vector<UccReq>        reqs;
+
+    /* one big and several small collectives in flight at once */
+    for (int i = 0; i < n_colls; i++) {
+        this->set_inplace(TEST_NO_INPLACE);
+        this->data_init(n_procs, TypeParam::dt, i == 0 ? 65536 : 8, ctxs[i],
+                        false);
+        reqs.push_back(UccReq(team, ctxs[i]));
+    }
+    UccReq::startall(reqs);
+    UccReq::waitall(reqs);
+    for (int i = 0; i < n_colls; i++) {
+        EXPECT_EQ(true, this->data_validate(ctxs[i]));
+        this->data_fini(ctxs[i]);
+    }
+}
+
 TYPED_TEST(test_allreduce_alg, dbt) {
     int           n_procs = 15;
     ucc_job_env_t env     = {{"UCC_CL_BASIC_TUNE", "inf"},
@@ -486,6 +546,101 @@ TYPED_TEST(test_allreduce_alg, sliding_window)
         }
     }
 }
+
+TYPED_TEST(test_allreduce_alg, cyx)
+{
+    int           repeat = 3;
+    UccCollCtxVec ctxs;
+
+    for (auto ring_ag : {"y", "n"}) {
+        ucc_job_env_t env = {{"UCC_CL_BASIC_TUNE", "inf"},
+                             {"UCC_TL_UCP_TUNE", "allreduce:@cyx:inf"},
+                             {"UCC_TL_UCP_ONESIDED_SCRATCH_SIZE", "32m"},
+                             {"UCC_TL_UCP_ALLREDUCE_CYX_CHUNK_SIZE", "4099"},
+                             {"UCC_TL_UCP_ALLREDUCE_CYX_RING_ALLGATHER",
+                              ring_ag}};
+
+        for (auto n_procs : {1, 2, 7}) {
+            UccJob    job(n_procs, UccJob::UCC_JOB_CTX_GLOBAL_ONESIDED, env);
+            UccTeam_h team = job.create_team(n_procs, true, false, true);
+
+            /* uneven counts exercise remainder blocks, count < n_procs leaves
+               some of the blocks empty and runs a single ring instead of two
+               inverted ones; chunk size which is not a multiple of dt size
+               leaves a short last chunk in every block */
+            for (auto count : {5, 65536, 123567}) {
+                for (auto inplace : {TEST_NO_INPLACE, TEST_INPLACE}) {
+                    SET_MEM_TYPE(UCC_MEMORY_TYPE_HOST);
+                    this->set_inplace(inplace);
+                    this->data_init(n_procs, TypeParam::dt, count, ctxs, true);
+                    for (auto r = 0; r < n_procs; r++) {
+                        ucc_coll_args_t *coll = ctxs[r]->args;
+
+                        /* final results are written by remote ranks, dst has
+                           to live in the memory mapped on the context */
+                        coll->dst.info.buffer =
+                            team->procs[r].p->onesided_buf[1];
+                        coll->mask  |= UCC_COLL_ARGS_FIELD_FLAGS;
+                        coll->flags |= UCC_COLL_ARGS_FLAG_MEM_MAPPED_BUFFERS;
+                    }
+                    this->reset(ctxs);
+                    UccReq req(team, ctxs);
+
+                    for (auto i = 0; i < repeat; i++) {
+                        req.start();
+                        req.wait();
+                        EXPECT_EQ(true, this->data_validate(ctxs));
+                        this->reset(ctxs);
+                    }
+                    this->data_fini(ctxs);
+                }
+            }
+        }
+    }
+}
+
+TYPED_TEST(test_allreduce_alg, cyx_hierarchical)
+{
+    int           repeat = 2;
+    UccCollCtxVec ctxs;
+    ucc_job_env_t env    = {{"UCC_CL_BASIC_TUNE", "inf"},
+                            {"UCC_TL_UCP_TUNE", "allreduce:@cyx:inf"},
+                            {"UCC_TL_UCP_ONESIDED_SCRATCH_SIZE", "32m"},
+                            {"UCC_TL_UCP_ALLREDUCE_CYX_CHUNK_SIZE", "4099"},
+                            {"UCC_TL_UCP_ALLREDUCE_CYX_HIERARCHICAL", "y"}};
+
+    /* gtest jobs are split into 2 simulated nodes, even team sizes give
+       the same number of ranks per node so that NET subgroup is enabled */
+    for (auto n_procs : {4, 6}) {
+        UccJob    job(n_procs, UccJob::UCC_JOB_CTX_GLOBAL_ONESIDED, env);
+        UccTeam_h team = job.create_team(n_procs, true, false, true);
+
+        for (auto count : {5, 65536, 123567}) {
+            for (auto inplace : {TEST_NO_INPLACE, TEST_INPLACE}) {
+                SET_MEM_TYPE(UCC_MEMORY_TYPE_HOST);
+                this->set_inplace(inplace);
+                this->data_init(n_procs, TypeParam::dt, count, ctxs, true);
+                for (auto r = 0; r < n_procs; r++) {
+                    ucc_coll_args_t *coll = ctxs[r]->args;
+
+                    coll->dst.info.buffer = team->procs[r].p->onesided_buf[1];
+                    coll->mask  |= UCC_COLL_ARGS_FIELD_FLAGS;
+                    coll->flags |= UCC_COLL_ARGS_FLAG_MEM_MAPPED_BUFFERS;
+                }
+                this->reset(ctxs);
+                UccReq req(team, ctxs);
+
+                for (auto i = 0; i < repeat; i++) {
+                    req.start();
+                    req.wait();
+                    EXPECT_EQ(true, this->data_validate(ctxs));
+                    this->reset(ctxs);
+                }
+                this->data_fini(ctxs);
+            }
+        }
+    }
+}
 #endif
 
 template <typename T>
@@ -246,6 +246,105 @@ UCC_TEST_P(test_alltoall_0, single_onesided)
     data_fini_onesided(ctxs);
 }
 
+UCC_TEST_F(test_alltoall, onesided_window)
+{
+    UccCollCtxVec ctxs;
+
+    /* window smaller than the team size makes the puts to the rest of the
+       peers go out from progress */
+    for (auto order : {"shift", "xor", "linear"}) {
+        ucc_job_env_t env = {{"UCC_TL_UCP_TUNE", "alltoall:0-inf:@1"},
+                             {"UCC_TL_UCP_ALLTOALL_ONESIDED_NUM_POSTS", "2"},
+                             {"UCC_TL_UCP_ONESIDED_PEER_ORDER", order}};
+
+        for (auto size : {7, 8}) {
+            UccJob    job(size, UccJob::UCC_JOB_CTX_GLOBAL_ONESIDED, env);
+            UccTeam_h team = job.create_team(size, true, false, true);
+
+            this->set_inplace(TEST_NO_INPLACE);
+            SET_MEM_TYPE(UCC_MEMORY_TYPE_HOST);
+            data_init(size, UCC_DT_INT32, 3, ctxs, team, false);
+            UccReq req(team, ctxs);
+            req.start();
+            req.wait();
+            EXPECT_EQ(true, data_validate(ctxs));
+            data_fini_onesided(ctxs);
+        }
+    }
+}
+
+UCC_TEST_F(test_alltoall, onesided_team_heap)
+{
+    const int     size   = 5;
+    const int     count  = 16;
+    const int     repeat = 3;
+    ucc_job_env_t env    = {{"UCC_TL_UCP_TUNE", "alltoall:0-inf:@1"},
+                            {"UCC_TL_UCP_ONESIDED_HEAP_SIZE", "64k"}};
+    UccJob        job(size, UccJob::UCC_JOB_CTX_GLOBAL_ONESIDED, env);
+    UccTeam_h     team  = job.create_team(size, true, false, true);
+    size_t        dsize = count * size * sizeof(int32_t);
+    UccCollCtxVec ctxs;
+
+    this->set_inplace(TEST_NO_INPLACE);
+    SET_MEM_TYPE(UCC_MEMORY_TYPE_HOST);
+    data_init(size, UCC_DT_INT32, count, ctxs, team, true);
+    /* dst comes from the team symmetric heap, no global work buffer: the
+       signals go to the team symmetric region */
+    for (auto i = 0; i < size; i++) {
+        ucc_coll_args_t *coll = ctxs[i]->args;
+
+        ASSERT_EQ(UCC_OK, ucc_team_mem_alloc(team->procs[i].team, dsize,
+                                             &coll->dst.info.buffer));
+        coll->mask &= ~(uint64_t)UCC_COLL_ARGS_FIELD_GLOBAL_WORK_BUFFER;
+    }
+    {
+        UccReq req(team, ctxs);
+
+        /* consecutive calls alternate between two signal words */
+        for (auto i = 0; i < repeat; i++) {
+            req.start();
+            req.wait();
+            EXPECT_EQ(true, data_validate(ctxs));
+            reset(ctxs);
+        }
+    }
+    for (auto i = 0; i < size; i++) {
+        EXPECT_EQ(UCC_OK, ucc_team_mem_free(team->procs[i].team,
+                                            ctxs[i]->args->dst.info.buffer));
+    }
+    data_fini_onesided(ctxs);
+}
+
+UCC_TEST_F(test_alltoall, onesided_rcache)
+{
+    const int         size = 4;
+    ucc_job_env_t     env  = {{"UCC_TL_UCP_TUNE", "alltoall:0-inf:@1"},
+                              {"UCC_TL_UCP_RCACHE", "y"}};
+    UccJob            job(size, UccJob::UCC_JOB_CTX_GLOBAL, env);
+    UccTeam_h         team = job.create_team(size);
+    const int         gwb_size = UCC_TEST_ONESIDED_GWB_SIZE;
+    std::vector<long> work_bufs(size * gwb_size, 0);
+    UccCollCtxVec     ctxs;
+
+    /* buffers are not mapped, they are registered on first use */
+    this->set_inplace(TEST_NO_INPLACE);
+    SET_MEM_TYPE(UCC_MEMORY_TYPE_HOST);
+    data_init(size, UCC_DT_INT32, 8, ctxs, false);
+    for (auto i = 0; i < size; i++) {
+        ctxs[i]->args->mask |= UCC_COLL_ARGS_FIELD_GLOBAL_WORK_BUFFER;
+        ctxs[i]->args->global_work_buffer = &work_bufs[i * gwb_size];
+    }
+    /* second call finds the registrations in the cache */
+    for (auto iter = 0; iter < 2; iter++) {
+        UccReq req(team, ctxs);
+        req.start();
+        req.wait();
+        EXPECT_EQ(true, data_validate(ctxs));
+        reset(ctxs);
+    }
+    data_fini(ctxs);
+}
+
 UCC_TEST_P(test_alltoall_0, single_persistent)
 {
     const int            team_id  = std::get<0>(GetParam());
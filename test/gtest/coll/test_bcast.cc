@@ -272,6 +272,75 @@ UCC_TEST_P(test_bcast_alg,) {
     }
 }
 
+#ifdef HAVE_UCX
+UCC_TEST_F(test_bcast, onesided)
+{
+    UccCollCtxVec ctxs;
+
+    SET_MEM_TYPE(UCC_MEMORY_TYPE_HOST);
+    onesided_for_each_team("bcast", [&](int n_procs, UccTeam_h team) {
+        /* changing the root between calls reshapes the tree on the same
+           team */
+        for (int root = 0; root < n_procs; root++) {
+            for (auto count : {1, 65536}) {
+                set_root(root);
+                data_init(n_procs, UCC_DT_INT8, count, ctxs, true);
+                /* children read the buffer of the parent */
+                onesided_map_buffers(team, ctxs, false, 1);
+                onesided_repeat(*this, team, ctxs);
+                data_fini(ctxs);
+            }
+        }
+    });
+}
+
+UCC_TEST_F(test_bcast, onesided_roots)
+{
+    ucc_job_env_t env     = onesided_env("bcast");
+    int           n_procs = 7;
+    size_t        count   = 65536;
+    UccJob        job(n_procs, UccJob::UCC_JOB_CTX_GLOBAL_ONESIDED, env);
+    UccTeam_h     team    = job.create_team(n_procs, true, false, true);
+    std::vector<UccReq>        reqs;
+    std::vector<UccCollCtxVec> ctxs;
+
+    SET_MEM_TYPE(UCC_MEMORY_TYPE_HOST);
+    /* bcasts of all the roots are posted at once: ranks run through them at
+       different paces and the parent of a call may have the data while its
+       child still waits in the previous call */
+    for (int root = 0; root < n_procs; root++) {
+        UccCollCtxVec ctx;
+
+        set_root(root);
+        data_init(n_procs, UCC_DT_INT8, count, ctx, false);
+        for (auto r = 0; r < n_procs; r++) {
+            ucc_coll_args_t *coll = ctx[r]->args;
+
+            coll->src.info.buffer =
+                (uint8_t *)team->procs[r].p->onesided_buf[1] + root * count;
+            coll->mask  |= UCC_COLL_ARGS_FIELD_FLAGS;
+            coll->flags |= UCC_COLL_ARGS_FLAG_MEM_MAPPED_BUFFERS;
+        }
+        reset(ctx);
+        reqs.push_back(UccReq(team, ctx));
+        ctxs.push_back(ctx);
+    }
+    UccReq::startall(reqs);
+    UccReq::waitall(reqs);
+
+    for (auto ctx : ctxs) {
+        for (auto r = 0; r < n_procs; r++) {
+            uint8_t *buf = (uint8_t *)ctx[r]->args->src.info.buffer;
+
+            for (size_t i = 0; i < count; i++) {
+                ASSERT_EQ((uint8_t)i, buf[i]);
+            }
+        }
+        data_fini(ctx);
+    }
+}
+#endif
+
 ucc_job_env_t two_step_env = {{"UCC_CL_HIER_TUNE", "bcast:@2step:0-inf:inf"},
                               {"UCC_CLS", "all"}};
 ucc_job_env_t dbt_env      = {{"UCC_TL_UCP_TUNE", "bcast:@dbt:0-inf:inf"},
@@ -360,6 +360,30 @@ UCC_TEST_P(test_reduce_scatter_alg,)
     }
 }
 
+#ifdef HAVE_UCX
+class test_reduce_scatter_onesided : public ucc::test {
+};
+
+UCC_TEST_F(test_reduce_scatter_onesided, ring)
+{
+    test_reduce_scatter<TypeOpPair<UCC_DT_INT32, sum>> rs_test;
+    UccCollCtxVec                                      ctxs;
+
+    rs_test.set_mem_type(UCC_MEMORY_TYPE_HOST);
+    rs_test.set_inplace(TEST_NO_INPLACE);
+    onesided_for_each_team("reduce_scatter", [&](int       n_procs,
+                                                 UccTeam_h team) {
+        /* partial results land in the symmetric scratch of the right
+           neighbour, src and dst are local only */
+        for (auto count : {7, 65536, 123567}) {
+            rs_test.data_init(n_procs, UCC_DT_INT32, count, ctxs, true);
+            onesided_repeat(rs_test, team, ctxs);
+            rs_test.data_fini(ctxs);
+        }
+    });
+}
+#endif
+
 ucc_job_env_t ring_unidir_env = {{"name", "ring_unidirectional"},
                                  {"UCC_CL_BASIC_TUNE", "inf"},
                                  {"UCC_TL_UCP_TUNE", "reduce_scatter:@ring:inf"},
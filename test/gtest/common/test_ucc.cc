@@ -370,16 +370,36 @@ ucc_status_t thread_allgather_req_free(void *request)
     return UCC_OK;
 }
 
+/* Simulate multi-node topology for larger gtest coverage */
+static void proc_info_simulate(int id, int job_size, ucc_proc_info_t *proc_info)
+{
+    const int nnodes   = 2;
+    const int nsockets = 2;
+    const int nnumas   = 3;
+    int       node, local_ppn, local_rank, block;
+
+    block      = ucc_buffer_block_count(job_size, nnodes, 0);
+    node       = id / block;
+    local_ppn  = ucc_buffer_block_count(job_size, nnodes, node);
+    local_rank = id - ucc_buffer_block_offset(job_size, nnodes, node);
+
+    *proc_info           = ucc_local_proc;
+    proc_info->host_hash = node + 1;
+    block                = ucc_buffer_block_count(local_ppn, nsockets, 0);
+    proc_info->socket_id = local_rank / block;
+
+    block              = ucc_buffer_block_count(local_ppn, nnumas, 0);
+    proc_info->numa_id = local_rank / block;
+
+    proc_info->pid = id + 1;
+}
+
 void proc_context_create(UccProcess_h proc, int id, ThreadAllgather *ta, bool is_global)
 {
-    const int            nnodes   = 2;
-    const int            nsockets = 2;
-    const int            nnumas   = 3;
     ucc_status_t         status;
     ucc_context_config_h ctx_config;
     std::stringstream    err_msg;
     ucc_proc_info_t      proc_info;
-    int node, local_ppn, local_rank, job_size, block;
 
     status = ucc_context_config_read(proc->lib_h, NULL, &ctx_config);
     if (status != UCC_OK) {
@@ -394,23 +414,7 @@ void proc_context_create(UccProcess_h proc, int id, ThreadAllgather *ta, bool is
         proc->ctx_params.oob.coll_info = (void*) &ta->reqs[id];
         proc->ctx_params.oob.n_oob_eps = ta->n_procs;
         proc->ctx_params.oob.oob_ep    = id;
-
-
-        /* Simulate multi-node topology for larger gtest coverage */
-        job_size = ta->n_procs;
-        block = ucc_buffer_block_count(job_size, nnodes, 0);
-        node    = id / block;
-        local_ppn = ucc_buffer_block_count(job_size, nnodes, node);
-        local_rank = id - ucc_buffer_block_offset(job_size, nnodes, node);
-
-        proc_info.host_hash = node + 1;
-        block = ucc_buffer_block_count(local_ppn, nsockets, 0);
-        proc_info.socket_id = local_rank / block;
-
-        block = ucc_buffer_block_count(local_ppn, nnumas, 0);
-        proc_info.numa_id = local_rank / block;
-
-        proc_info.pid = id + 1;
+        proc_info_simulate(id, ta->n_procs, &proc_info);
     } else {
         proc_info = ucc_local_proc;
     }
@@ -434,6 +438,7 @@ void proc_context_create_mem_params(UccProcess_h proc, int id,
     ucc_context_config_h ctx_config;
     std::stringstream    err_msg;
     ucc_mem_map_t        map[UCC_TEST_N_MEM_SEGMENTS];
+    ucc_proc_info_t      proc_info;
 
     status = ucc_context_config_read(proc->lib_h, NULL, &ctx_config);
     if (status != UCC_OK) {
@@ -457,8 +462,9 @@ void proc_context_create_mem_params(UccProcess_h proc, int id,
     proc->ctx_params.oob.oob_ep            = id;
     proc->ctx_params.mem_params.segments   = map;
     proc->ctx_params.mem_params.n_segments = UCC_TEST_N_MEM_SEGMENTS;
-    status = ucc_context_create(proc->lib_h, &proc->ctx_params, ctx_config,
-                                &proc->ctx_h);
+    proc_info_simulate(id, ta->n_procs, &proc_info);
+    status = ucc_context_create_proc_info(proc->lib_h, &proc->ctx_params,
+                                          ctx_config, &proc->ctx_h, &proc_info);
     ucc_context_config_release(ctx_config);
     if (status != UCC_OK) {
         err_msg << "ucc_context_create for one-sided context failed";
@@ -735,3 +741,38 @@ bool tl_self_available()
     ucc_tl_context_put(tl_ctx);
     return true;
 }
+
+ucc_job_env_t onesided_env(const std::string &coll)
+{
+    return {{"UCC_CL_BASIC_TUNE", "inf"},
+            {"UCC_TL_UCP_TUNE", coll + ":@onesided:inf"},
+            {"UCC_TL_UCP_ONESIDED_SCRATCH_SIZE", "32m"}};
+}
+
+void onesided_for_each_team(const std::string                   &coll,
+                            std::function<void(int, UccTeam_h)> fn)
+{
+    for (auto n_procs : {1, 2, 7}) {
+        UccJob    job(n_procs, UccJob::UCC_JOB_CTX_GLOBAL_ONESIDED,
+                      onesided_env(coll));
+        UccTeam_h team = job.create_team(n_procs, true, false, true);
+
+        fn(n_procs, team);
+    }
+}
+
+void onesided_map_buffers(UccTeam_h team, UccCollCtxVec &ctxs, bool dst,
+                          int seg)
+{
+    for (auto r = 0; r < ctxs.size(); r++) {
+        ucc_coll_args_t *coll = ctxs[r]->args;
+
+        if (dst) {
+            coll->dst.info.buffer = team->procs[r].p->onesided_buf[seg];
+        } else {
+            coll->src.info.buffer = team->procs[r].p->onesided_buf[seg];
+        }
+        coll->mask  |= UCC_COLL_ARGS_FIELD_FLAGS;
+        coll->flags |= UCC_COLL_ARGS_FLAG_MEM_MAPPED_BUFFERS;
+    }
+}
@@ -20,6 +20,7 @@ extern "C" {
 #include <thread>
 #include <atomic>
 #include <string>
+#include <functional>
 
 typedef struct {
     ucc_mc_buffer_header_t *dst_mc_header;
@@ -268,4 +269,41 @@ void clear_buffer(void *_buf, size_t size, ucc_memory_type_t mt, uint8_t value);
 #define UCC_TEST_MEM_SEGMENT_SIZE (1 << 20)
 
 bool tl_self_available();
+
+/* global work buffer of TL/UCP one-sided collectives in longs, mirrors
+   ONESIDED_SYNC_SIZE + ONESIDED_REDUCE_SIZE of tl_ucp.h */
+#define UCC_TEST_ONESIDED_SYNC_SIZE   3
+#define UCC_TEST_ONESIDED_REDUCE_SIZE 2
+#define UCC_TEST_ONESIDED_GWB_SIZE                                             \
+    (UCC_TEST_ONESIDED_SYNC_SIZE + UCC_TEST_ONESIDED_REDUCE_SIZE)
+
+/* One-sided collectives run on teams of 1, 2 and 7 ranks whose contexts map
+   the onesided_buf segments, every call is repeated on the same buffers */
+#define UCC_TEST_ONESIDED_REPEAT 3
+
+/* env forcing the one-sided algorithm of coll, e.g. "allgather" */
+ucc_job_env_t onesided_env(const std::string &coll);
+
+void onesided_for_each_team(const std::string                   &coll,
+                            std::function<void(int, UccTeam_h)> fn);
+
+/* points dst (or src) of every rank to its mapped onesided_buf[seg] */
+void onesided_map_buffers(UccTeam_h team, UccCollCtxVec &ctxs, bool dst,
+                          int seg);
+
+/* runs the initialized collective UCC_TEST_ONESIDED_REPEAT times and
+   validates every call */
+template <typename T>
+void onesided_repeat(T &test, UccTeam_h team, UccCollCtxVec &ctxs)
+{
+    test.reset(ctxs);
+    UccReq req(team, ctxs);
+
+    for (auto i = 0; i < UCC_TEST_ONESIDED_REPEAT; i++) {
+        req.start();
+        req.wait();
+        EXPECT_EQ(true, test.data_validate(ctxs));
+        test.reset(ctxs);
+    }
+}
 #endif
@@ -47,6 +47,77 @@ UCC_TEST_F(test_context, init_multiple)
     }
 }
 
+UCC_TEST_F(test_context, progress_thread)
+{
+    ucc_lib_config_h     mt_lib_config;
+    ucc_lib_params_t     mt_lib_params;
+    ucc_lib_h            mt_lib_h;
+    ucc_context_config_h mt_ctx_config;
+    ucc_context_params_t ctx_params;
+    ucc_context_h        ctx_h;
+
+    ctx_params.mask = UCC_CONTEXT_PARAM_FIELD_TYPE;
+    ctx_params.type = UCC_CONTEXT_SHARED;
+    /* single threaded lib: context is created without progress thread */
+    EXPECT_EQ(UCC_OK, ucc_context_config_modify(ctx_config, NULL,
+                                                "PROGRESS_THREAD", "y"));
+    EXPECT_EQ(UCC_OK, ucc_context_create(lib_h, &ctx_params, ctx_config, &ctx_h));
+    EXPECT_EQ(UCC_OK, ucc_context_progress(ctx_h));
+    EXPECT_EQ(UCC_OK, ucc_context_destroy(ctx_h));
+
+    EXPECT_EQ(UCC_OK, ucc_lib_config_read(NULL, NULL, &mt_lib_config));
+    mt_lib_params.mask        = UCC_LIB_PARAM_FIELD_THREAD_MODE;
+    mt_lib_params.thread_mode = UCC_THREAD_MULTIPLE;
+    EXPECT_EQ(UCC_OK, ucc_init(&mt_lib_params, mt_lib_config, &mt_lib_h));
+    ucc_lib_config_release(mt_lib_config);
+    EXPECT_EQ(UCC_OK, ucc_context_config_read(mt_lib_h, NULL, &mt_ctx_config));
+    EXPECT_EQ(UCC_OK, ucc_context_config_modify(mt_ctx_config, NULL,
+                                                "PROGRESS_THREAD", "y"));
+    EXPECT_EQ(UCC_OK, ucc_context_create(mt_lib_h, &ctx_params, mt_ctx_config,
+                                         &ctx_h));
+    /* application and progress thread drive the context concurrently */
+    for (int i = 0; i < 1000; i++) {
+        EXPECT_EQ(UCC_OK, ucc_context_progress(ctx_h));
+    }
+    EXPECT_EQ(UCC_OK, ucc_context_destroy(ctx_h));
+    ucc_context_config_release(mt_ctx_config);
+    EXPECT_EQ(UCC_OK, ucc_finalize(mt_lib_h));
+}
+
+#ifdef HAVE_UCX
+UCC_TEST_F(test_context, wait_not_supported)
+{
+    ucc_context_params_t ctx_params;
+    ucc_context_h        ctx_h;
+
+    ctx_params.mask = UCC_CONTEXT_PARAM_FIELD_TYPE;
+    ctx_params.type = UCC_CONTEXT_EXCLUSIVE;
+    EXPECT_EQ(UCC_OK, ucc_context_config_modify(ctx_config, "tl/ucp",
+                                                "WAKEUP", "n"));
+    EXPECT_EQ(UCC_OK, ucc_context_create(lib_h, &ctx_params, ctx_config, &ctx_h));
+    EXPECT_EQ(UCC_ERR_NOT_SUPPORTED, ucc_context_wait(ctx_h, 0));
+    EXPECT_EQ(UCC_OK, ucc_context_destroy(ctx_h));
+}
+
+UCC_TEST_F(test_context, wait)
+{
+    ucc_context_params_t ctx_params;
+    ucc_context_h        ctx_h;
+
+    ctx_params.mask = UCC_CONTEXT_PARAM_FIELD_TYPE;
+    ctx_params.type = UCC_CONTEXT_EXCLUSIVE;
+    EXPECT_EQ(UCC_OK, ucc_context_config_modify(ctx_config, "tl/ucp",
+                                                "WAKEUP", "y"));
+    EXPECT_EQ(UCC_OK, ucc_context_create(lib_h, &ctx_params, ctx_config, &ctx_h));
+    /* nothing is in flight: the call returns on timeout */
+    for (int i = 0; i < 4; i++) {
+        EXPECT_EQ(UCC_OK, ucc_context_progress(ctx_h));
+        EXPECT_EQ(UCC_OK, ucc_context_wait(ctx_h, 10));
+    }
+    EXPECT_EQ(UCC_OK, ucc_context_destroy(ctx_h));
+}
+#endif
+
 test_context_get_attr::test_context_get_attr()
 {
     ucc_context_params_t ctx_params;
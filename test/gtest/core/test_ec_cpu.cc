@@ -0,0 +1,179 @@
+/**
+ * Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * See file LICENSE for terms.
+ */
+
+extern "C" {
+#include <components/ec/ucc_ec.h>
+#include <components/mc/ucc_mc.h>
+#include <core/ucc_global_opts.h>
+#include <utils/ucc_parser.h>
+}
+#include <common/test.h>
+#include <vector>
+
+/* Runs the cpu executor with worker threads enabled and the multithreading
+   threshold lowered, so that tasks go through the asynchronous pool. EC
+   config is parsed once per process, the values are modified in place and
+   set back to defaults afterwards */
+class test_ec_cpu : public ucc::test {
+  protected:
+    ucc_ec_base_t     *ec;
+    ucc_ee_executor_t *executor;
+
+    ucc_status_t set_config(const char *name, const char *value)
+    {
+        return ucc_config_parser_set_value(ec->config, ec->config_table.table,
+                                           name, value);
+    }
+
+    virtual void SetUp() override
+    {
+        ucc_mc_params_t          mc_params = {.thread_mode = UCC_THREAD_SINGLE};
+        ucc_ec_params_t          ec_params = {.thread_mode = UCC_THREAD_SINGLE};
+        ucc_ee_executor_params_t params;
+        int                      i;
+
+        ucc::test::SetUp();
+        ucc_constructor();
+        ucc_mc_init(&mc_params);
+        ucc_ec_init(&ec_params);
+        ec       = nullptr;
+        executor = nullptr;
+        for (i = 0; i < ucc_global_config.ec_framework.n_components; i++) {
+            ucc_ec_base_t *c = ucc_derived_of(
+                ucc_global_config.ec_framework.components[i], ucc_ec_base_t);
+            if (c->type == UCC_EE_CPU_THREAD && c->ref_cnt > 0) {
+                ec = c;
+            }
+        }
+        if (!ec) {
+            GTEST_SKIP();
+        }
+        ASSERT_EQ(UCC_OK, set_config("EXEC_NUM_THREADS", "4"));
+        ASSERT_EQ(UCC_OK, set_config("EXEC_MT_THRESH", "1"));
+        ASSERT_EQ(UCC_OK, set_config("EXEC_PIN_THREADS", "n"));
+
+        params.mask    = UCC_EE_EXECUTOR_PARAM_FIELD_TYPE;
+        params.ee_type = UCC_EE_CPU_THREAD;
+        ASSERT_EQ(UCC_OK, ucc_ee_executor_init(&params, &executor));
+        ASSERT_EQ(UCC_OK, ucc_ee_executor_start(executor, NULL));
+    }
+
+    virtual void TearDown() override
+    {
+        if (executor) {
+            EXPECT_EQ(UCC_OK, ucc_ee_executor_stop(executor));
+            EXPECT_EQ(UCC_OK, ucc_ee_executor_finalize(executor));
+        }
+        if (ec) {
+            EXPECT_EQ(UCC_OK, set_config("EXEC_NUM_THREADS", "0"));
+            EXPECT_EQ(UCC_OK, set_config("EXEC_MT_THRESH", "1M"));
+            EXPECT_EQ(UCC_OK, set_config("EXEC_PIN_THREADS", "y"));
+        }
+        ucc_ec_finalize();
+        ucc_mc_finalize();
+        ucc::test::TearDown();
+    }
+
+    ucc_status_t wait(std::vector<ucc_ee_executor_task_t *> &tasks)
+    {
+        ucc_status_t status, ret = UCC_OK;
+
+        for (auto t : tasks) {
+            while (UCC_INPROGRESS == (status = ucc_ee_executor_task_test(t))) {
+                ;
+            }
+            if (UCC_OK != status) {
+                ret = status;
+            }
+            ucc_ee_executor_task_finalize(t);
+        }
+        return ret;
+    }
+};
+
+UCC_TEST_F(test_ec_cpu, reduce_async)
+{
+    /* count is not a multiple of the chunk size, several tasks are
+       outstanding in the pool at the same time */
+    const size_t                          count   = (1 << 20) + 13;
+    const int                             n_srcs  = 3;
+    const int                             n_tasks = 4;
+    std::vector<std::vector<int32_t>>     srcs(n_srcs);
+    std::vector<std::vector<int32_t>>     dst(n_tasks);
+    std::vector<ucc_ee_executor_task_t *> tasks(n_tasks);
+    ucc_ee_executor_task_args_t           eargs;
+
+    for (int s = 0; s < n_srcs; s++) {
+        srcs[s].resize(count);
+        for (size_t i = 0; i < count; i++) {
+            srcs[s][i] = (int32_t)(i % 1021) + s;
+        }
+    }
+    for (int t = 0; t < n_tasks; t++) {
+        dst[t].assign(count, -1);
+        eargs.task_type     = UCC_EE_EXECUTOR_TASK_REDUCE;
+        eargs.flags         = 0;
+        eargs.reduce.dst    = dst[t].data();
+        eargs.reduce.count  = count;
+        eargs.reduce.dt     = UCC_DT_INT32;
+        eargs.reduce.op     = UCC_OP_SUM;
+        eargs.reduce.n_srcs = n_srcs;
+        for (int s = 0; s < n_srcs; s++) {
+            eargs.reduce.srcs[s] = srcs[s].data();
+        }
+        ASSERT_EQ(UCC_OK, ucc_ee_executor_task_post(executor, &eargs,
+                                                    &tasks[t]));
+    }
+    ASSERT_EQ(UCC_OK, wait(tasks));
+    for (int t = 0; t < n_tasks; t++) {
+        for (size_t i = 0; i < count; i++) {
+            ASSERT_EQ(3 * (int32_t)(i % 1021) + 3, dst[t][i]);
+        }
+    }
+}
+
+UCC_TEST_F(test_ec_cpu, copy_async)
+{
+    const size_t                          len = (8 << 20) + 5;
+    std::vector<uint8_t>                  src(len), dst(len, 0);
+    std::vector<ucc_ee_executor_task_t *> tasks(1);
+    ucc_ee_executor_task_args_t           eargs;
+
+    for (size_t i = 0; i < len; i++) {
+        src[i] = (uint8_t)(i * 7);
+    }
+    eargs.task_type = UCC_EE_EXECUTOR_TASK_COPY;
+    eargs.flags     = 0;
+    eargs.copy.src  = src.data();
+    eargs.copy.dst  = dst.data();
+    eargs.copy.len  = len;
+    ASSERT_EQ(UCC_OK, ucc_ee_executor_task_post(executor, &eargs, &tasks[0]));
+    ASSERT_EQ(UCC_OK, wait(tasks));
+    EXPECT_EQ(src, dst);
+}
+
+UCC_TEST_F(test_ec_cpu, copy_async_nt)
+{
+    /* above MC_CPU_MEMCPY_NT_THRESH (16MB by default) every chunk uses
+       non-temporal stores, buffers and chunk boundaries are unaligned */
+    const size_t                          len = (17 << 20) + 13;
+    std::vector<uint8_t>                  src(len + 8), dst(len + 8, 0);
+    std::vector<ucc_ee_executor_task_t *> tasks(1);
+    ucc_ee_executor_task_args_t           eargs;
+
+    for (size_t i = 0; i < src.size(); i++) {
+        src[i] = (uint8_t)(i * 7 + 1);
+    }
+    eargs.task_type = UCC_EE_EXECUTOR_TASK_COPY;
+    eargs.flags     = 0;
+    eargs.copy.src  = src.data() + 3;
+    eargs.copy.dst  = dst.data() + 5;
+    eargs.copy.len  = len;
+    ASSERT_EQ(UCC_OK, ucc_ee_executor_task_post(executor, &eargs, &tasks[0]));
+    ASSERT_EQ(UCC_OK, wait(tasks));
+    EXPECT_EQ(0, memcmp(dst.data() + 5, src.data() + 3, len));
+    EXPECT_EQ(0, dst[4]);
+    EXPECT_EQ(0, dst[len + 5]);
+}
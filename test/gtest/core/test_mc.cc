@@ -1,10 +1,12 @@
 /**
- * Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * See file LICENSE for terms.
  */
 
 extern "C" {
 #include <components/mc/ucc_mc.h>
+#include <core/ucc_global_opts.h>
+#include <utils/ucc_parser.h>
 #include <pthread.h>
 }
 #include <common/test.h>
@@ -82,6 +84,68 @@ UCC_TEST_F(test_mc, can_alloc_and_free_host_mem)
     ucc_mc_finalize();
 }
 
+UCC_TEST_F(test_mc, can_alloc_and_free_large_host_mem)
+{
+    // sizes above UCC_MC_CPU_ELEM_SIZE are served by the size class pools
+    // up to UCC_MC_CPU_MPOOL_LARGE_MAX_SIZE, disabled by default
+    std::vector<size_t>     sizes = {(1 << 20) + 1, 3 << 20, 8 << 20};
+    ucc_mc_base_t          *mc    = NULL;
+    ucc_mc_buffer_header_t *h;
+
+    ASSERT_EQ(UCC_OK, ucc_constructor());
+    ucc_mc_params_t mc_params = {
+        .thread_mode = UCC_THREAD_SINGLE,
+    };
+    ASSERT_EQ(UCC_OK, ucc_mc_init(&mc_params));
+    for (int i = 0; i < ucc_global_config.mc_framework.n_components; i++) {
+        ucc_mc_base_t *c = ucc_derived_of(
+            ucc_global_config.mc_framework.components[i], ucc_mc_base_t);
+        if (c->type == UCC_MEMORY_TYPE_HOST) {
+            mc = c;
+        }
+    }
+    ASSERT_NE(nullptr, mc);
+    ASSERT_EQ(UCC_OK, ucc_config_parser_set_value(
+                          mc->config, mc->config_table.table,
+                          "MPOOL_LARGE_MAX_SIZE", "8M"));
+    for (int i = 0; i < 2; i++) {
+        for (auto size : sizes) {
+            EXPECT_EQ(UCC_OK, ucc_mc_alloc(&h, size, UCC_MEMORY_TYPE_HOST));
+            EXPECT_EQ(1, h->from_pool);
+            memset(h->addr, 0xff, size);
+            EXPECT_EQ(UCC_OK, ucc_mc_free(h));
+        }
+    }
+    EXPECT_EQ(UCC_OK, ucc_config_parser_set_value(
+                          mc->config, mc->config_table.table,
+                          "MPOOL_LARGE_MAX_SIZE", "0"));
+    ucc_mc_finalize();
+}
+
+UCC_TEST_F(test_mc, can_memcpy_large_host_mem)
+{
+    // above UCC_MC_CPU_MEMCPY_NT_THRESH (16MB by default) copy uses
+    // non-temporal stores, check unaligned head and tail
+    size_t            size = (17 << 20) + 13;
+    std::vector<char> src(size + 8), dst(size + 8, 0);
+
+    ASSERT_EQ(UCC_OK, ucc_constructor());
+    ucc_mc_params_t mc_params = {
+        .thread_mode = UCC_THREAD_SINGLE,
+    };
+    ASSERT_EQ(UCC_OK, ucc_mc_init(&mc_params));
+    for (size_t i = 0; i < src.size(); i++) {
+        src[i] = (char)(i * 7 + 1);
+    }
+    EXPECT_EQ(UCC_OK, ucc_mc_memcpy(dst.data() + 5, src.data() + 3, size,
+                                    UCC_MEMORY_TYPE_HOST,
+                                    UCC_MEMORY_TYPE_HOST));
+    EXPECT_EQ(0, memcmp(dst.data() + 5, src.data() + 3, size));
+    EXPECT_EQ(0, dst[4]);
+    EXPECT_EQ(0, dst[size + 5]);
+    ucc_mc_finalize();
+}
+
 // Disabled because can't reinit mc with different thread mode
 UCC_TEST_F(test_mc, DISABLED_can_alloc_and_free_host_mem_mt)
 {
@@ -258,7 +258,8 @@ class test_mc_reduce : public testing::Test {
         }
     };
 
-    void test_reduce_multi(ucc_memory_type_t mt) {
+    /* count below COUNT leaves a tail not multiple of the vector width */
+    void test_reduce_multi(ucc_memory_type_t mt, int count) {
         const int    num_vec = 3;
         ucc_status_t status;
 
@@ -266,7 +267,7 @@ class test_mc_reduce : public testing::Test {
             GTEST_SKIP();
         }
         ASSERT_EQ(this->setup(mt, num_vec), UCC_OK);
-        status = do_reduce(this->buf1, this->buf2, this->res, this->COUNT,
+        status = do_reduce(this->buf1, this->buf2, this->res, count,
                            num_vec, this->COUNT * sizeof(*this->buf2), T::dt,
                            T::redop, false, 0);
         if (UCC_ERR_NOT_SUPPORTED == status) {
@@ -281,13 +282,15 @@ class test_mc_reduce : public testing::Test {
             ucc_mc_memcpy(this->res_h, this->res_d, this->COUNT * sizeof(*this->res_d),
                           UCC_MEMORY_TYPE_HOST, mt);
         }
-        for (int i = 0; i < this->COUNT; i++) {
-            typename T::type res = T::do_op(this->buf1_h[i],
-                                                            this->buf2_h[i]);
+        for (int i = 0; i < count; i++) {
+            typename RefAcc<T>::type acc = RefAcc<T>::do_op(
+                RefAcc<T>::load(this->buf1_h[i]),
+                RefAcc<T>::load(this->buf2_h[i]));
             for (int j = 1; j < num_vec; j++) {
-                res = T::do_op(this->buf2_h[i + j * this->COUNT], res);
+                acc = RefAcc<T>::do_op(
+                    RefAcc<T>::load(this->buf2_h[i + j * this->COUNT]), acc);
             }
-            T::assert_equal(res, this->res_h[i]);
+            T::assert_equal(RefAcc<T>::store(acc), this->res_h[i]);
         }
     };
 
@@ -318,13 +321,24 @@ class test_mc_reduce : public testing::Test {
                           UCC_MEMORY_TYPE_HOST, mt);
         }
         for (int i = 0; i < this->COUNT; i++) {
-            typename T::type res = T::do_op(this->buf1_h[i], this->buf2_h[i]);
+            typename RefAcc<T>::type acc = RefAcc<T>::do_op(
+                RefAcc<T>::load(this->buf1_h[i]),
+                RefAcc<T>::load(this->buf2_h[i]));
+            typename T::type         res;
+
             for (int j = 1; j < num_vec; j++) {
-                res = T::do_op(this->buf2_h[i + j * this->COUNT], res);
+                acc = RefAcc<T>::do_op(
+                    RefAcc<T>::load(this->buf2_h[i + j * this->COUNT]), acc);
             }
-            if (T::dt == UCC_DT_BFLOAT16) {
+            if (T::dt == UCC_DT_FLOAT16) {
+                /* alpha is applied in fp32 before the only rounding */
+                acc *= (typename RefAcc<T>::type)alpha;
+                res  = RefAcc<T>::store(acc);
+            } else if (T::dt == UCC_DT_BFLOAT16) {
+                res = RefAcc<T>::store(acc);
                 float32tobfloat16(bfloat16tofloat32(&res)*(float)alpha, &res);
             } else {
+                res  = RefAcc<T>::store(acc);
                 res *= (typename T::type)alpha;
             }
             T::assert_equal(res, this->res_h[i]);
@@ -362,6 +376,7 @@ using TypeOpPairsFloat = ::testing::Types<ARITHMETIC_OP_PAIRS(FLOAT32),
                                           ARITHMETIC_OP_PAIRS(FLOAT64),
                                           ARITHMETIC_OP_PAIRS(FLOAT128),
                                           ARITHMETIC_OP_PAIRS(BFLOAT16),
+                                          ARITHMETIC_OP_PAIRS(FLOAT16),
                                           TypeOpPair<UCC_DT_FLOAT32_COMPLEX, sum>,
                                           TypeOpPair<UCC_DT_FLOAT32_COMPLEX, prod>,
                                           TypeOpPair<UCC_DT_FLOAT64_COMPLEX, sum>,
@@ -370,7 +385,8 @@ using TypeOpPairsFloat = ::testing::Types<ARITHMETIC_OP_PAIRS(FLOAT32),
                                           TypeOpPair<UCC_DT_FLOAT128_COMPLEX, prod>,
                                           TypeOpPair<UCC_DT_FLOAT32, avg>,
                                           TypeOpPair<UCC_DT_FLOAT64, avg>,
-                                          TypeOpPair<UCC_DT_BFLOAT16, avg>>;
+                                          TypeOpPair<UCC_DT_BFLOAT16, avg>,
+                                          TypeOpPair<UCC_DT_FLOAT16, avg>>;
 
 using TypeOpPairsFloatCuda = ::testing::Types<
     ARITHMETIC_OP_PAIRS(FLOAT32), ARITHMETIC_OP_PAIRS(FLOAT64),
@@ -399,7 +415,12 @@ TYPED_TEST_CASE(test_mc_reduce_float, TypeOpPairsFloat);
 
 #define DECLARE_REDUCE_MULTI_TEST(_type, _mt)               \
     TYPED_TEST(test_mc_reduce_ ## _type, multi_ ## _mt) {   \
-        this->test_reduce_multi(UCC_MEMORY_TYPE_ ## _mt);   \
+        this->test_reduce_multi(UCC_MEMORY_TYPE_ ## _mt,    \
+                                this->COUNT);               \
+    }                                                       \
+    TYPED_TEST(test_mc_reduce_ ## _type, multi_tail_ ## _mt) {   \
+        this->test_reduce_multi(UCC_MEMORY_TYPE_ ## _mt,    \
+                                this->COUNT - 3);           \
     }                                                       \
 
 #define DECLARE_REDUCE_MULTI_ALPHA_TEST(_type, _mt)               \
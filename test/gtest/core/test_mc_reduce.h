@@ -74,6 +74,74 @@ struct TypeOpPair<UCC_DT_BFLOAT16, op> {
     }
 };
 
+template <template <typename P> class op>
+struct TypeOpPair<UCC_DT_FLOAT16, op> {
+    using type                            = uint16_t;
+    const static ucc_datatype_t     dt    = UCC_DT_FLOAT16;
+    const static ucc_reduction_op_t redop = op<float>::redop;
+    static void                     assert_equal(type arg1, type arg2)
+    {
+        // reference is reduced in fp32 and rounded once as well (see
+        // RefAcc), allow one float16 ulp for the different order of fp32 ops
+        uint16_t next = (arg1 & 0x7fff) + 1;
+        float    ulp  = float16tofloat32(&next) -
+                        fabsf(float16tofloat32(&arg1));
+
+        ASSERT_NEAR(float16tofloat32(&arg1), float16tofloat32(&arg2), ulp);
+    }
+    static type do_op(type arg1, type arg2)
+    {
+        op<float>  _op;
+        uint16_t   res;
+        float32tofloat16(
+            _op(float16tofloat32(&arg1), float16tofloat32(&arg2)), &res);
+        return res;
+    }
+};
+
+/* Accumulator of the reference reduction over several vectors. Host
+   reduces float16 in fp32 across all the vectors and rounds the result
+   once, rounding after every pair accumulates an error of several float16
+   ulps, so the reference is accumulated in fp32 too */
+template <typename T>
+struct RefAcc {
+    using type = typename T::type;
+    static type load(typename T::type v)
+    {
+        return v;
+    }
+    static typename T::type store(type v)
+    {
+        return v;
+    }
+    static type do_op(type arg1, type arg2)
+    {
+        return T::do_op(arg1, arg2);
+    }
+};
+
+template <template <typename P> class op>
+struct RefAcc<TypeOpPair<UCC_DT_FLOAT16, op>> {
+    using type = float;
+    static float load(uint16_t v)
+    {
+        return float16tofloat32(&v);
+    }
+    static uint16_t store(float v)
+    {
+        uint16_t res;
+
+        float32tofloat16(v, &res);
+        return res;
+    }
+    static float do_op(float arg1, float arg2)
+    {
+        op<float> _op;
+
+        return _op(arg1, arg2);
+    }
+};
+
 #define DECLARE_OP_(_op, _UCC_OP, _OP)                          \
     template<typename T>                                        \
     class _op {                                                 \
@@ -161,6 +229,7 @@ static inline bool ucc_reduction_is_supported(ucc_datatype_t dt,
         case UCC_DT_FLOAT32_COMPLEX:
         case UCC_DT_FLOAT64_COMPLEX:
         case UCC_DT_BFLOAT16:
+        case UCC_DT_FLOAT16:
         case UCC_DT_FLOAT128:
         case UCC_DT_FLOAT128_COMPLEX:
             break;
@@ -0,0 +1,99 @@
+/**
+ * Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * See file LICENSE for terms.
+ */
+
+#include <common/test.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+extern "C" {
+#include "core/ucc_progress_queue.h"
+}
+
+/* task completes after a given number of progress calls */
+class test_pq_task : public ucc_coll_task_t {
+public:
+    int               n_calls;
+    std::atomic<int> *n_completed;
+    test_pq_task(int calls, std::atomic<int> *completed) :
+        n_calls(calls), n_completed(completed)
+    {
+        ucc_coll_task_construct(this);
+        EXPECT_EQ(UCC_OK, ucc_coll_task_init(this, NULL, NULL));
+        progress     = test_pq_task::progress_fn;
+        status       = UCC_INPROGRESS;
+        super.status = UCC_INPROGRESS;
+    }
+    ~test_pq_task()
+    {
+        ucc_coll_task_destruct(this);
+    }
+    static void progress_fn(ucc_coll_task_t *task)
+    {
+        test_pq_task *t = (test_pq_task *)task;
+
+        if (--t->n_calls == 0) {
+            t->status = UCC_OK;
+            (*t->n_completed)++;
+        }
+    }
+};
+
+/* lock free, ws queues, ws batch */
+typedef std::tuple<int, int, int> pq_params_t;
+
+class test_progress_queue : public ucc::test,
+                            public ::testing::WithParamInterface<pq_params_t> {
+};
+
+UCC_TEST_P(test_progress_queue, mt)
+{
+    const int             n_threads = 4;
+    const int             n_tasks   = 64;
+    const int             n_calls   = 10;
+    std::atomic<int>      n_completed(0);
+    std::vector<std::thread>    threads;
+    std::vector<test_pq_task *> tasks;
+    ucc_progress_queue_t *pq;
+
+    ASSERT_EQ(UCC_OK,
+              ucc_progress_queue_init(&pq, UCC_THREAD_MULTIPLE,
+                                      std::get<0>(GetParam()),
+                                      std::get<1>(GetParam()),
+                                      std::get<2>(GetParam())));
+    for (int i = 0; i < n_threads * n_tasks; i++) {
+        tasks.push_back(new test_pq_task(n_calls, &n_completed));
+    }
+    /* every thread posts its own tasks, only some of the threads progress
+       so the rest of the tasks have to be picked up from other queues */
+    for (int t = 0; t < n_threads; t++) {
+        threads.push_back(std::thread([&, t]() {
+            for (int i = 0; i < n_tasks; i++) {
+                ucc_progress_enqueue(pq, tasks[t * n_tasks + i]);
+            }
+            if (t % 2) {
+                return;
+            }
+            while (n_completed < n_threads * n_tasks) {
+                EXPECT_LE(0, ucc_progress_queue(pq));
+            }
+        }));
+    }
+    for (auto &th : threads) {
+        th.join();
+    }
+    EXPECT_EQ(n_threads * n_tasks, n_completed);
+    for (auto t : tasks) {
+        EXPECT_EQ(UCC_OK, t->status);
+        delete t;
+    }
+    ucc_progress_queue_finalize(pq);
+}
+
+INSTANTIATE_TEST_CASE_P(, test_progress_queue,
+                        ::testing::Values(pq_params_t(0, 0, 0),
+                                          pq_params_t(1, 0, 0),
+                                          pq_params_t(0, 1, 8),
+                                          pq_params_t(0, 4, 1),
+                                          pq_params_t(0, 4, 8)));
@@ -121,3 +121,48 @@ UCC_TEST_F(test_team, team_get_attr)
     /* shuffle vector so that teams are destroyed in different order */
     std::shuffle(teams.begin(), teams.end(), std::default_random_engine());
 }
+
+#ifdef HAVE_UCX
+UCC_TEST_F(test_team, team_mem_alloc)
+{
+    int       n_procs = 4;
+    UccJob    job(n_procs, UccJob::UCC_JOB_CTX_GLOBAL_ONESIDED,
+                  {ucc_env_var_t("UCC_TL_UCP_ONESIDED_HEAP_SIZE", "64k")});
+    UccTeam_h team = job.create_team(n_procs, true, false, true);
+    std::vector<ptrdiff_t> offsets;
+
+    for (int r = 0; r < n_procs; r++) {
+        ucc_team_h h = team->procs[r].team;
+        void      *a, *b, *c, *big;
+
+        ASSERT_EQ(UCC_OK, ucc_team_mem_alloc(h, 1000, &a));
+        ASSERT_EQ(UCC_OK, ucc_team_mem_alloc(h, 100, &b));
+        memset(a, r, 1000);
+        EXPECT_EQ(UCC_OK, ucc_team_mem_free(h, a));
+        EXPECT_EQ(UCC_ERR_INVALID_PARAM, ucc_team_mem_free(h, a));
+        /* freed block is reused first */
+        ASSERT_EQ(UCC_OK, ucc_team_mem_alloc(h, 500, &c));
+        EXPECT_EQ(a, c);
+        EXPECT_NE(UCC_OK, ucc_team_mem_alloc(h, 128 * 1024, &big));
+        offsets.push_back((char *)b - (char *)c);
+        EXPECT_EQ(UCC_OK, ucc_team_mem_free(h, b));
+        EXPECT_EQ(UCC_OK, ucc_team_mem_free(h, c));
+        /* everything is coalesced back into a single block */
+        ASSERT_EQ(UCC_OK, ucc_team_mem_alloc(h, 64 * 1024, &big));
+        EXPECT_EQ(UCC_OK, ucc_team_mem_free(h, big));
+    }
+    /* same sequence of calls gives the same layout on every rank */
+    for (int r = 1; r < n_procs; r++) {
+        EXPECT_EQ(offsets[0], offsets[r]);
+    }
+}
+
+UCC_TEST_F(test_team, team_mem_alloc_not_supported)
+{
+    UccTeam_h team = UccJob::getStaticJob()->create_team(2);
+    void     *buf;
+
+    EXPECT_EQ(UCC_ERR_NOT_SUPPORTED,
+              ucc_team_mem_alloc(team->procs[0].team, 64, &buf));
+}
+#endif
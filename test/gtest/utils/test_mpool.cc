@@ -0,0 +1,89 @@
+/**
+ * Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * See file LICENSE for terms.
+ */
+
+extern "C" {
+#include "utils/ucc_mpool.h"
+#include "utils/arch/cpu.h"
+}
+#include <common/test.h>
+#include <chrono>
+#include <climits>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#define NUM_ITERS   200000
+#define MAX_BATCH   32
+#define NUM_THREADS 8
+
+/* magazines are enabled for pools of at least UCC_MPOOL_MAG_MIN_ELEMS
+   elements, a smaller bounded pool always takes the lock */
+class test_mpool : public ucc::test,
+                   public ::testing::WithParamInterface<bool> {
+  public:
+    ucc_mpool_t mp;
+    int         errors;
+    void        mt_get_put(int id);
+};
+
+/* gets and puts small batches of objects like init/finalize of small
+   collectives do with tasks */
+void test_mpool::mt_get_put(int id)
+{
+    long *objs[MAX_BATCH];
+    int   n, i, j;
+
+    for (i = 0; i < NUM_ITERS; i++) {
+        n = 1 + i % MAX_BATCH;
+        for (j = 0; j < n; j++) {
+            objs[j] = (long *)ucc_mpool_get(&mp);
+            if (!objs[j]) {
+                __sync_fetch_and_add(&errors, 1);
+                return;
+            }
+            *objs[j] = id;
+        }
+        for (j = 0; j < n; j++) {
+            if (*objs[j] != id) {
+                __sync_fetch_and_add(&errors, 1);
+            }
+            ucc_mpool_put(objs[j]);
+        }
+    }
+}
+
+UCC_TEST_P(test_mpool, mt_get_put)
+{
+    unsigned                 max_elems = GetParam() ? UINT_MAX :
+                                         UCC_MPOOL_MAG_MIN_ELEMS - 1;
+    std::vector<std::thread> threads;
+
+    errors = 0;
+    ASSERT_EQ(UCC_OK, ucc_mpool_init(&mp, 0, 64, 0, UCC_CACHE_LINE_SIZE, 16,
+                                     max_elems, NULL, UCC_THREAD_MULTIPLE,
+                                     "test mpool"));
+    EXPECT_EQ(GetParam(), !!mp.mag_enabled);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < NUM_THREADS; i++) {
+        threads.push_back(std::thread(&test_mpool::mt_get_put, this, i));
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    EXPECT_EQ(0, errors);
+    std::cout << "[     INFO ] " << NUM_THREADS << " threads, magazines "
+              << (GetParam() ? "on" : "off") << ": "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(
+                     end - start).count()
+              << " ms" << std::endl;
+    /* objects left in the magazines of exited threads are back in the
+       pool, leak check must pass */
+    ucc_mpool_cleanup(&mp, 1);
+}
+
+INSTANTIATE_TEST_CASE_P(, test_mpool, ::testing::Values(true, false));
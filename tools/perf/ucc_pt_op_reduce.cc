@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  *
  * See file LICENSE for terms.
  */
@@ -62,6 +62,12 @@ ucc_status_t ucc_pt_op_reduce::init_args(size_t count,
     for (i = 0; i < num_bufs; i++) {
         args.reduce.srcs[i] = PTR_OFFSET(src_header->addr, i * size);
     }
+    if (reduce_op == UCC_OP_AVG) {
+        /* same as averaging done by collectives, e.g. -d bfloat16 -o avg
+           measures mixed precision gradient averaging */
+        args.flags        = UCC_EEE_TASK_FLAG_REDUCE_WITH_ALPHA;
+        args.reduce.alpha = 1.0 / num_bufs;
+    }
 
     return UCC_OK;
 free_dst: